@@ -0,0 +1,151 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2023, Thomas DiModica
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+   Times Backwards code that spends its time looking things up in Dictionaries.
+
+   For each number system but libmpdec, it fills a Dictionary with String keys, and one with Float keys that
+   aren't integers, and then looks every key up ten times, and prints how long each took and
+   the sum of what it found. The optional argument is how many keys to use, the default being
+   ten thousand.
+*/
+#include "Backwards/Input/Lexer.h"
+#include "Backwards/Input/StringInput.h"
+#include "Backwards/Parser/SymbolTable.h"
+#include "Backwards/Parser/Parser.h"
+#include "Backwards/Parser/ContextBuilder.h"
+#include "Backwards/Engine/Statement.h"
+#include "Backwards/Engine/CallingContext.h"
+#include "Backwards/Engine/Logger.h"
+#include "Backwards/Engine/DebuggerHook.h"
+
+#include "NumberSystem.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+class BenchLogger final : public Backwards::Engine::Logger
+ {
+public:
+   std::string last;
+
+   void log (const std::string& message) override { last = message; }
+   std::string get () override { return ""; }
+ };
+
+class BenchDebugger final : public Backwards::Engine::DebuggerHook
+ {
+public:
+   void EnterDebugger(const std::string&, Backwards::Engine::CallingContext&) override { }
+ };
+
+   // Runs the script, and returns how long it took. The script's last message is left in the logger.
+static double milliseconds(const std::string& script, BenchLogger& logger)
+ {
+   Backwards::Input::StringInput string (script);
+   Backwards::Input::Lexer lexer (string, "DictionaryBench");
+   Backwards::Engine::Scope global;
+   Backwards::Parser::ContextBuilder::createGlobalScope(global);
+   Backwards::Parser::GetterSetter gs;
+   Backwards::Parser::SymbolTable table (gs, global);
+   Backwards::Engine::CallingContext context;
+   BenchDebugger debugger;
+
+   context.logger = &logger;
+   context.debugger = &debugger;
+   context.globalScope = &global;
+
+   std::shared_ptr<Backwards::Engine::Statement> parse = Backwards::Parser::Parser::Parse(lexer, table, logger);
+   if (nullptr == parse.get())
+    {
+      return 0.0;
+    }
+
+   std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+   parse->execute(context);
+   std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+   return std::chrono::duration<double, std::milli>(end - start).count();
+ }
+
+   // The key for i is made by key, which can use i.
+static std::string lookups(const std::string& key, size_t count)
+ {
+   return
+      "set k to NewArray() \n"
+      "set d to NewDictionary() \n"
+      "for i from 1 to " + std::to_string(count) + " do \n"
+      "   set x to " + key + " \n"
+      "   set k to PushBack(k; x) \n"
+      "   set d to Insert(d; x; i) \n"
+      "end \n"
+      "set s to 0 \n"
+      "for r from 1 to 10 do \n"
+      "   for x in k do \n"
+      "      set s to s + GetValue(d; x) \n"
+      "   end \n"
+      "end \n"
+      "call Info(ToString(s)) \n";
+ }
+
+int main (int argc, char ** argv)
+ {
+   size_t count = 10000U;
+   if (argc > 1)
+    {
+      count = static_cast<size_t>(std::strtoul(argv[1], nullptr, 10));
+    }
+
+      // Not libmpdec: the loops would never end, as there 1.0e+2 + 1 is 1.0e+2.
+   static const char* const NAMES [] = { "BCNum", "libdecmath", "SlowFloat", "double", "MPFR" };
+   static const NumberSystem_System SYSTEMS [] = { BCNUM_NUMBER_SYSTEM, LIBDECMATH_NUMBER_SYSTEM, SLOWFLOAT_NUMBER_SYSTEM,
+      DOUBLE_NUMBER_SYSTEM, MPFR_NUMBER_SYSTEM };
+
+   const std::string strings = lookups("'key ' + ToString(i)", count);
+   const std::string floats = lookups("i / 7", count);
+
+   std::printf("%-12s %12s %12s\n", "", "String keys", "Float keys");
+   for (size_t i = 0U; i < sizeof(SYSTEMS) / sizeof(SYSTEMS[0]); ++i)
+    {
+      NumberSystem::setCurrentNumberSystem(SYSTEMS[i]);
+
+      BenchLogger stringResult;
+      double stringTime = milliseconds(strings, stringResult);
+      BenchLogger floatResult;
+      double floatTime = milliseconds(floats, floatResult);
+
+      std::printf("%-12s %10.1fms %10.1fms    %s    %s\n", NAMES[i], stringTime, floatTime, stringResult.last.c_str(), floatResult.last.c_str());
+    }
+
+   return 0;
+ }
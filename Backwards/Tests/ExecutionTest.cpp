@@ -44,9 +44,13 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "Backwards/Engine/CallingContext.h"
 #include "Backwards/Engine/Logger.h"
 #include "Backwards/Engine/DebuggerHook.h"
+#include "Backwards/Engine/FatalException.h"
+#include "Backwards/Engine/Compiled.h"
+#include "Backwards/Engine/FunctionContext.h"
 
 #include "Backwards/Types/CellRangeValue.h"
 #include "Backwards/Types/FloatValue.h"
+#include "Backwards/Types/FunctionValue.h"
 
 #include "NumberSystem.h"
 
@@ -877,3 +881,353 @@ TEST(AllTests, testRangeFor)
 
    ASSERT_EQ(5U, logger.logs.size());
  }
+
+TEST(AllTests, testUnsharedUpdates)
+ {
+      // Updates to a value that only one variable has are done in place: make sure that no one else sees them.
+   Backwards::Input::StringInput string
+      (
+      "set a to PushBack(PushBack(NewArray(); 1); 2) \n"
+      "set b to a \n"
+      "set a to PushBack(a; 3) \n"
+      "set a[0] to 10 \n"
+      "set b[1] to 20 \n"
+      "set a to PushBack(a; a) \n"
+      "set c to a \n"
+      "set a to PopBack(a) \n"
+      "set d to { 'x' : 1 } \n"
+      "set e to d \n"
+      "set d to Insert(d; 'y'; 2) \n"
+      "set d to RemoveKey(d; 'x') \n"
+      "set e.x to 5 \n"
+      "call Info(ToString(a[0]) + ' ' + ToString(Size(a)) + ' ' + ToString(b[0]) + ' ' + ToString(b[1]) + ' ' + ToString(Size(b))) \n"
+      "call Info(ToString(Size(c)) + ' ' + ToString(Size(c[3])) + ' ' + ToString(c[3][0])) \n"
+      "call Info(ToString(Size(d)) + ' ' + ToString(GetValue(d; 'y')) + ' ' + ToString(Size(e)) + ' ' + ToString(e.x)) \n"
+      "set a to PushBack(a; 4) \n"
+      "call Info(ToString(Size(c))) \n"
+      );
+   Backwards::Input::Lexer lexer (string, "InputString");
+
+   Backwards::Engine::Scope global;
+   Backwards::Parser::ContextBuilder::createGlobalScope(global); // Create the global scope before the table.
+   Backwards::Parser::GetterSetter gs;
+   Backwards::Parser::SymbolTable table (gs, global);
+   Backwards::Engine::CallingContext context;
+   StringLogger logger;
+   DummyDebugger debugger;
+
+   context.logger = &logger;
+   context.debugger = &debugger;
+   context.globalScope = &global;
+
+   std::shared_ptr<Backwards::Engine::Statement> parse = Backwards::Parser::Parser::Parse(lexer, table, logger);
+
+   debugger.entered = false;
+   EXPECT_EQ(0U, logger.logs.size());
+
+   if (nullptr != parse.get())
+    {
+      parse->execute(context);
+    }
+   else
+    {
+      FAIL() << "Parse returned NULL.";
+    }
+
+   ASSERT_EQ(4U, logger.logs.size());
+   EXPECT_EQ("INFO: 10 3 1 20 2", logger.logs[0]);
+   EXPECT_EQ("INFO: 4 3 10", logger.logs[1]);
+   EXPECT_EQ("INFO: 1 2 1 5", logger.logs[2]);
+   EXPECT_EQ("INFO: 4", logger.logs[3]);
+   ASSERT_FALSE(debugger.entered);
+ }
+
+TEST(AllTests, testDictionaryOrder)
+ {
+      // Dictionaries are hashed, but loops over them and GetKeys go in the order of the keys. Equal numbers are the same key.
+   Backwards::Input::StringInput string
+      (
+      "set d to NewDictionary() \n"
+      "set d to Insert(d; 'pear'; 1) \n"
+      "set d to Insert(d; 'apple'; 2) \n"
+      "set d to Insert(d; 10; 3) \n"
+      "set d to Insert(d; 2; 4) \n"
+      "set d to Insert(d; 'fig'; 5) \n"
+      "set d to Insert(d; 2.0; 6) \n"
+      "set d to Insert(d; -0; 7) \n"
+      "set d to Insert(d; 0; 8) \n"
+      "set s to '' \n"
+      "for x in d do \n"
+      "   set s to s + ToString(x[1]) + ' ' \n"
+      "end \n"
+      "call Info(s) \n"
+      "set k to GetKeys(d) \n"
+      "call Info(k[3] + ' ' + k[4] + ' ' + k[5] + ' ' + ToString(k[1])) \n"
+      "call Info(ToString(d = Insert(RemoveKey(d; 'fig'); 'fig'; 5))) \n"
+      );
+   Backwards::Input::Lexer lexer (string, "InputString");
+
+   Backwards::Engine::Scope global;
+   Backwards::Parser::ContextBuilder::createGlobalScope(global); // Create the global scope before the table.
+   Backwards::Parser::GetterSetter gs;
+   Backwards::Parser::SymbolTable table (gs, global);
+   Backwards::Engine::CallingContext context;
+   StringLogger logger;
+   DummyDebugger debugger;
+
+   context.logger = &logger;
+   context.debugger = &debugger;
+   context.globalScope = &global;
+
+   std::shared_ptr<Backwards::Engine::Statement> parse = Backwards::Parser::Parser::Parse(lexer, table, logger);
+
+   debugger.entered = false;
+   EXPECT_EQ(0U, logger.logs.size());
+
+   if (nullptr != parse.get())
+    {
+      parse->execute(context);
+    }
+   else
+    {
+      FAIL() << "Parse returned NULL.";
+    }
+
+   ASSERT_EQ(3U, logger.logs.size());
+   EXPECT_EQ("INFO: 8 6 3 2 5 1 ", logger.logs[0]);
+   EXPECT_EQ("INFO: apple fig pear 2", logger.logs[1]);
+   EXPECT_EQ("INFO: 1", logger.logs[2]);
+   ASSERT_FALSE(debugger.entered);
+ }
+
+static void runCompiled(bool compile, const char* program, std::vector<std::string>& logs, bool& entered, std::shared_ptr<Backwards::Engine::Statement>& body)
+ {
+   Backwards::Input::StringInput string (program);
+   Backwards::Input::Lexer lexer (string, "InputString");
+
+   Backwards::Engine::Scope global;
+   Backwards::Parser::ContextBuilder::createGlobalScope(global); // Create the global scope before the table.
+   Backwards::Parser::GetterSetter gs;
+   Backwards::Parser::SymbolTable table (gs, global);
+   Backwards::Engine::CallingContext context;
+   StringLogger logger;
+   DummyDebugger debugger;
+
+   context.logger = &logger;
+   context.debugger = &debugger;
+   context.globalScope = &global;
+   table.compile = compile;
+
+   std::shared_ptr<Backwards::Engine::Statement> parse = Backwards::Parser::Parser::Parse(lexer, table, logger);
+
+   debugger.entered = false;
+   ASSERT_EQ(0U, logger.logs.size());
+   ASSERT_NE(nullptr, parse.get());
+
+   try
+    {
+      parse->execute(context);
+    }
+   catch (const std::exception& e)
+    {
+      logger.log(e.what());
+    }
+
+   logs = logger.logs;
+   entered = debugger.entered;
+   for (size_t i = 0U; i < global.names.size(); ++i)
+    {
+      if ("Flow" == global.names[i])
+       {
+         body = std::dynamic_pointer_cast<Backwards::Engine::FunctionContext>(std::static_pointer_cast<Backwards::Types::FunctionValue>(global.vars[i])->value)->function;
+       }
+    }
+ }
+
+TEST(AllTests, testCompiledFunctions)
+ {
+      // A compiled function has to do exactly what its tree does: log the same things, and fail the same way.
+   const char* program =
+      "set Flow to function (n) is \n"
+      "   set total to 0 \n"
+      "   set i to 0 \n"
+      "   while 1 do \n"
+      "      set i to i + 1 \n"
+      "      if i > n then \n"
+      "         break \n"
+      "      end \n"
+      "      if 0 = i - Floor(i / 3) * 3 then \n"
+      "         continue \n"
+      "      end \n"
+      "      for j from 1 to 4 do \n"
+      "         if j = 3 then \n"
+      "            break \n"
+      "         end \n"
+      "         set total to total + j * i \n"
+      "      end \n"
+      "      select i from \n"
+      "         case 1 is \n"
+      "            set total to total + 100 \n"
+      "         also case from 2 to 4 is \n"
+      "            set total to total + 1000 \n"
+      "         case below 6 is \n"
+      "            set total to total - 1 \n"
+      "            break \n"
+      "         case above 7 is \n"
+      "            set total to total * 2 \n"
+      "         also case 11 is \n"
+      "            set total to total + 3 \n"
+      "         case else is \n"
+      "            set total to total + 10000 \n"
+      "      end \n"
+      "   end \n"
+      "   for k from 10 downto 1 step -3 do \n"
+      "      set total to total + k \n"
+      "      set k to 100 \n"
+      "   end \n"
+      "   for x in { 'a' : 5 ; 'b' : 7 } do \n"
+      "      set total to total + x[1] \n"
+      "   end \n"
+      "   set a to {1; 2; 3} \n"
+      "   set a[1] to 10 \n"
+      "   call Info(ToString(a[0]) + ToString(a[1]) + ToString(n > 3 & n < 100 | 0)) \n"
+      "   call Info(!(n < 2) ? 'yes' : 'no') \n"
+      "   return total \n"
+      "end \n"
+      "set Fib to function (n) is \n"
+      "   if n < 2 then \n"
+      "      return n \n"
+      "   end \n"
+      "   return Fib(n - 1) + Fib(n - 2) \n"
+      "end \n"
+      "set Capt to function [Fib] (q) [F] is \n"
+      "   return F(q) + q \n"
+      "end \n"
+      "set Bad to function (q) is \n"
+      "   return q + 'x' \n"
+      "end \n"
+      "call Info(ToString(Flow(12))) \n"
+      "call Info(ToString(Capt(10))) \n"
+      "call Info(ToString(Bad(1))) \n"
+      ;
+
+   std::vector<std::string> tree, compiled;
+   bool treeEntered, compiledEntered;
+   std::shared_ptr<Backwards::Engine::Statement> treeBody, compiledBody;
+
+   runCompiled(false, program, tree, treeEntered, treeBody);
+   runCompiled(true, program, compiled, compiledEntered, compiledBody);
+
+   ASSERT_EQ(5U, tree.size());
+   EXPECT_EQ("INFO: 1101", tree[0]);
+   EXPECT_EQ("INFO: 1142", tree[2]);
+   EXPECT_EQ("INFO: 65", tree[3]);
+   EXPECT_EQ(tree, compiled);
+   EXPECT_TRUE(treeEntered);
+   EXPECT_EQ(treeEntered, compiledEntered);
+
+   ASSERT_NE(nullptr, treeBody.get());
+   ASSERT_NE(nullptr, compiledBody.get());
+   EXPECT_EQ(nullptr, dynamic_cast<Backwards::Engine::Compiled*>(treeBody.get()));
+   EXPECT_NE(nullptr, dynamic_cast<Backwards::Engine::Compiled*>(compiledBody.get()));
+ }
+
+TEST(AllTests, testNumericForSteps)
+ {
+      // Loops over numbers step their value in place when they can: values that were kept must not change.
+   const char* program =
+      "set Keep to function (n) is \n"
+      "   set a to {} \n"
+      "   for i from 1 to n do \n"
+      "      set a to PushBack(a; i) \n"
+      "   end \n"
+      "   set s to '' \n"
+      "   for x in a do \n"
+      "      set s to s + ToString(x) + ' ' \n"
+      "   end \n"
+      "   for j from 5 downto 1 step -2 do \n"
+      "      set s to s + ToString(j) + ' ' \n"
+      "      set j to j * 10 \n"
+      "   end \n"
+      "   for k from 0.5 to 2 step 0.5 do \n"
+      "   end \n"
+      "   return s + ToString(i) + ' ' + ToString(k) \n"
+      "end \n"
+      "set i to 0 \n"
+      "set k to 0 \n"
+      "set h to 0 \n"
+      "for h from 1 to 3 do \n"
+      "   set last to h \n"
+      "end \n"
+      "call Info(Keep(4)) \n"
+      "call Info(ToString(h) + ' ' + ToString(last)) \n"
+      ;
+
+   std::vector<std::string> tree, compiled;
+   bool treeEntered, compiledEntered;
+   std::shared_ptr<Backwards::Engine::Statement> treeBody, compiledBody;
+
+   runCompiled(false, program, tree, treeEntered, treeBody);
+   runCompiled(true, program, compiled, compiledEntered, compiledBody);
+
+   ASSERT_EQ(2U, tree.size());
+   EXPECT_EQ("INFO: 1 2 3 4 5 3 1 5 2.5", tree[0]);
+   EXPECT_EQ("INFO: 4 3", tree[1]);
+   EXPECT_EQ(tree, compiled);
+   EXPECT_FALSE(treeEntered);
+   EXPECT_FALSE(compiledEntered);
+ }
+
+TEST(AllTests, testCallDepthLimit)
+ {
+      // Frames are reused from call to call: after a call fails, the next one must start from a clean frame.
+   Backwards::Input::StringInput string
+      (
+      "set Down to function (n) is \n"
+      "   if n > 0 then \n"
+      "      return Down(n - 1) + 1 \n"
+      "   end \n"
+      "   set x to 0 \n"
+      "   return x \n"
+      "end \n"
+      "call Info(ToString(Down(10))) \n"
+      "call Info(ToString(Down(100))) \n"
+      );
+   Backwards::Input::Lexer lexer (string, "InputString");
+
+   Backwards::Engine::Scope global;
+   Backwards::Parser::ContextBuilder::createGlobalScope(global); // Create the global scope before the table.
+   Backwards::Parser::GetterSetter gs;
+   Backwards::Parser::SymbolTable table (gs, global);
+   Backwards::Engine::CallingContext context;
+   StringLogger logger;
+   DummyDebugger debugger;
+
+   context.logger = &logger;
+   context.debugger = &debugger;
+   context.globalScope = &global;
+   context.maxDepth = 50U;
+
+   std::shared_ptr<Backwards::Engine::Statement> parse = Backwards::Parser::Parser::Parse(lexer, table, logger);
+
+   debugger.entered = false;
+   EXPECT_EQ(0U, logger.logs.size());
+
+   if (nullptr != parse.get())
+    {
+      EXPECT_THROW(parse->execute(context), Backwards::Engine::FatalException);
+      EXPECT_EQ(nullptr, context.currentFrame);
+      context.maxDepth = 0U;
+      EXPECT_NO_THROW(parse->execute(context));
+    }
+   else
+    {
+      FAIL() << "Parse returned NULL.";
+    }
+
+   ASSERT_EQ(3U, logger.logs.size());
+   EXPECT_EQ("INFO: 10", logger.logs[0]);
+   EXPECT_EQ("INFO: 10", logger.logs[1]);
+   EXPECT_EQ("INFO: 100", logger.logs[2]);
+   EXPECT_TRUE(debugger.entered);
+ }
@@ -80,12 +80,12 @@ TEST(EngineTests, testBasic)
 
    Backwards::Engine::NOP nop {Backwards::Input::Token()};
 
-   std::shared_ptr<Backwards::Engine::FlowControl> res = nop.execute(context);
-   EXPECT_EQ(nullptr, res.get());
+   Backwards::Engine::FlowControl res = nop.execute(context);
+   EXPECT_EQ(Backwards::Engine::FlowControl::NONE, res.type);
 
    Backwards::Engine::StandardConstantFunction pi (Backwards::Engine::GetRoundMode);
    res = pi.execute(context);
-   EXPECT_NE(nullptr, res.get());
+   EXPECT_EQ(Backwards::Engine::FlowControl::RETURN, res.type);
 
 
    std::shared_ptr<Backwards::Engine::FunctionContext> fun = std::make_shared<Backwards::Engine::FunctionContext>();
@@ -106,7 +106,7 @@ TEST(EngineTests, testBasic)
    std::vector<std::shared_ptr<Backwards::Engine::Statement> > states;
    states.push_back(expr);
    Backwards::Engine::StatementSeq seq1 (Backwards::Input::Token(), states);
-   EXPECT_EQ(nullptr, seq1.execute(context).get());
+   EXPECT_EQ(Backwards::Engine::FlowControl::NONE, seq1.execute(context).type);
    ASSERT_EQ(1U, logger.logs.size());
    EXPECT_EQ("INFO: hello", logger.logs[0]);
    logger.logs.clear();
@@ -114,16 +114,16 @@ TEST(EngineTests, testBasic)
    states.clear();
    states.push_back(std::make_shared<Backwards::Engine::FlowControlStatement>(Backwards::Input::Token(), Backwards::Engine::FlowControl::RETURN, 0U, std::shared_ptr<Backwards::Engine::Expression>()));
    Backwards::Engine::StatementSeq seq2 (Backwards::Input::Token(), states);
-   EXPECT_NE(nullptr, seq2.execute(context).get());
+   EXPECT_EQ(Backwards::Engine::FlowControl::RETURN, seq2.execute(context).type);
 
    states.clear();
    states.push_back(std::make_shared<Backwards::Engine::FlowControlStatement>(Backwards::Input::Token(), Backwards::Engine::FlowControl::RETURN, 0U, messages));
    Backwards::Engine::StatementSeq seq3 (Backwards::Input::Token(), states);
-   std::shared_ptr<Backwards::Engine::FlowControl> ret = seq3.execute(context);
-   ASSERT_NE(nullptr, ret.get());
-   ASSERT_NE(nullptr, (ret->value).get());
-   ASSERT_TRUE(typeid(Backwards::Types::StringValue) == typeid(*(ret->value).get()));
-   EXPECT_EQ("hello", std::dynamic_pointer_cast<Backwards::Types::StringValue>(ret->value)->value);
+   Backwards::Engine::FlowControl ret = seq3.execute(context);
+   ASSERT_EQ(Backwards::Engine::FlowControl::RETURN, ret.type);
+   ASSERT_NE(nullptr, (ret.value).get());
+   ASSERT_TRUE(typeid(Backwards::Types::StringValue) == typeid(*(ret.value).get()));
+   EXPECT_EQ("hello", std::dynamic_pointer_cast<Backwards::Types::StringValue>(ret.value)->value);
 
    states.clear();
    states.push_back(std::make_shared<Backwards::Engine::FlowControlStatement>(Backwards::Input::Token(), Backwards::Engine::FlowControl::RETURN, 0U, std::make_shared<Backwards::Engine::Plus>(Backwards::Input::Token(), infos, messages)));
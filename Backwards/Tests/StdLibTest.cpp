@@ -54,6 +54,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "NumberSystem.h"
 
 #include <cmath>
+#include <thread>
 
 class StringLogger final : public Backwards::Engine::Logger
  {
@@ -246,6 +247,16 @@ TEST(EngineTests, testJustCalls) // Don't bother validating that the output is c
    (void) Backwards::Engine::SetRoundMode(makeFloatValue("4"));
    (void) Backwards::Engine::SetRoundMode(makeFloatValue("7"));
    EXPECT_EQ(ROUND_AWAY, NumberSystem::getCurrentNumberSystem().getRoundMode());
+      // The rounding mode and precision belong to the thread.
+   size_t precision = NumberSystem::getCurrentNumberSystem().getDefaultPrecision();
+   std::thread([]()
+    {
+      EXPECT_EQ(ROUND_TIES_EVEN, NumberSystem::getCurrentNumberSystem().getRoundMode());
+      (void) Backwards::Engine::SetRoundMode(makeFloatValue("4"));
+      (void) Backwards::Engine::SetDefaultPrecision(makeFloatValue("4"));
+    }).join();
+   EXPECT_EQ(ROUND_AWAY, NumberSystem::getCurrentNumberSystem().getRoundMode());
+   EXPECT_EQ(precision, NumberSystem::getCurrentNumberSystem().getDefaultPrecision());
    EXPECT_THROW(Backwards::Engine::SetRoundMode(makeFloatValue("30")), Backwards::Types::TypedOperationException);
    EXPECT_THROW(Backwards::Engine::SetRoundMode(makeFloatValue("-1")), Backwards::Types::TypedOperationException);
    EXPECT_THROW(Backwards::Engine::SetRoundMode(std::make_shared<Backwards::Types::StringValue>("hello")), Backwards::Types::TypedOperationException);
@@ -614,6 +625,7 @@ public:
    mutable bool entered;
 
    virtual std::shared_ptr<Backwards::Types::ValueType> expand (Backwards::Engine::CallingContext&) const { entered = true; return makeFloatValue("1"); }
+   virtual void forEachValue (Backwards::Engine::CallingContext&, bool, const Visitor&) const { entered = true; }
    virtual std::shared_ptr<Backwards::Types::ValueType> getIndex (size_t /*index*/) const { return makeFloatValue("3"); }
    virtual size_t getSize() const { return 99U; }
 
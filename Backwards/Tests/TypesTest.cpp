@@ -41,6 +41,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "Backwards/Types/NilValue.h"
 #include "Backwards/Types/CellRefValue.h"
 #include "Backwards/Types/CellRangeValue.h"
+#include "Backwards/Types/PersistentVector.h"
+#include "Backwards/Types/PersistentHashMap.h"
 
 #include "NumberSystem.h"
 
@@ -160,6 +162,9 @@ TEST(TypesTests, testFloats)
    EXPECT_FALSE(med.sort(v7));
 
    EXPECT_NE(0U, low.hash());
+      // Equal numbers hash the same, however they were written.
+   EXPECT_EQ(low.hash(), Backwards::Types::FloatValue(NumberSystem::getCurrentNumberSystem().fromString("1")).hash());
+   EXPECT_EQ(Backwards::Types::FloatValue(NumberSystem::getCurrentNumberSystem().fromString("-0")).hash(), defaulted.hash());
  }
 
 TEST(TypesTests, testStrings)
@@ -1372,3 +1377,140 @@ TEST(TypesTests, testCellRange)
 
    EXPECT_EQ(0U, low.hash());
  }
+
+TEST(TypesTests, testInPlaceArithmetic)
+ {
+   static const NumberSystem_System SYSTEMS [] = { BCNUM_NUMBER_SYSTEM, LIBDECMATH_NUMBER_SYSTEM, SLOWFLOAT_NUMBER_SYSTEM,
+      DOUBLE_NUMBER_SYSTEM, LIBMPDEC_NUMBER_SYSTEM, MPFR_NUMBER_SYSTEM };
+   NumberSystem_System original = NumberSystem::getCurrentNumberSystem().getSystem();
+
+   for (NumberSystem_System system : SYSTEMS)
+    {
+      NumberSystem::setCurrentNumberSystem(system);
+      std::shared_ptr<NumberHolder> lhs = NumberSystem::getCurrentNumberSystem().fromString("7.5");
+      std::shared_ptr<NumberHolder> rhs = NumberSystem::getCurrentNumberSystem().fromString("2.5");
+
+         // The same answer as the operators, without touching the original.
+      std::shared_ptr<NumberHolder> temp = lhs->duplicate();
+      temp->addAssign(*rhs);
+      EXPECT_EQ((*lhs + *rhs)->toString(), temp->toString());
+      temp = lhs->duplicate();
+      temp->subtractAssign(*rhs);
+      EXPECT_EQ((*lhs - *rhs)->toString(), temp->toString());
+      temp = lhs->duplicate();
+      temp->multiplyAssign(*rhs);
+      EXPECT_EQ((*lhs * *rhs)->toString(), temp->toString());
+      temp = lhs->duplicate();
+      temp->divideAssign(*rhs);
+      EXPECT_EQ((*lhs / *rhs)->toString(), temp->toString());
+      temp = lhs->duplicate();
+      temp->fusedMultiplyAdd(*lhs, *rhs);
+      EXPECT_EQ((*lhs + *(*lhs * *rhs))->toString(), temp->toString());
+      EXPECT_EQ("7.5", lhs->toString().substr(0U, 3U));
+
+         // Another system's number is still an error.
+      NumberSystem::setCurrentNumberSystem(DOUBLE_NUMBER_SYSTEM == system ? BCNUM_NUMBER_SYSTEM : DOUBLE_NUMBER_SYSTEM);
+      std::shared_ptr<NumberHolder> other = NumberSystem::getCurrentNumberSystem().fromString("1");
+      EXPECT_THROW(temp->addAssign(*other), std::bad_cast);
+      EXPECT_THROW(temp->fusedMultiplyAdd(*lhs, *other), std::bad_cast);
+    }
+
+   NumberSystem::setCurrentNumberSystem(original);
+ }
+
+   // Every key with the same remainder has the same hash: keys that the hash can't tell apart still have to work.
+class Clumped final
+ {
+public:
+   size_t operator() (int key) const { return static_cast<size_t>(key % 50); }
+ };
+
+template <class Hash>
+static void testPersistentHashMap()
+ {
+   Backwards::Types::PersistentHashMap<int, int, Hash, std::equal_to<int> > dict;
+   std::map<int, int> reference;
+   for (int i = 0; i < 1000; ++i)
+    {
+      int key = (i * 389) % 1000;
+      dict.insert(std::make_pair(key, i));
+      reference.insert(std::make_pair(key, i));
+    }
+   Backwards::Types::PersistentHashMap<int, int, Hash, std::equal_to<int> > other = dict;
+   EXPECT_FALSE(other.insert(std::make_pair(5, 0)));
+   other.set(5, -5);
+   for (int i = 0; i < 1000; i += 3)
+    {
+      other.erase(i);
+    }
+   EXPECT_EQ(0U, other.erase(3));
+
+   ASSERT_EQ(reference.size(), dict.size());
+   std::map<int, int> contents (dict.begin(), dict.end());
+   EXPECT_TRUE(reference == contents);
+   EXPECT_EQ(reference[5], dict.find(5)->second);
+   EXPECT_EQ(-5, other.find(5)->second);
+   EXPECT_TRUE(nullptr == other.find(3));
+   EXPECT_TRUE(nullptr == other.find(1000));
+   EXPECT_EQ(666U, other.size());
+   size_t seen = 0U;
+   for (const auto& item : other)
+    {
+      EXPECT_NE(0, item.first % 3);
+      EXPECT_EQ((5 == item.first) ? -5 : reference[item.first], item.second);
+      ++seen;
+    }
+   EXPECT_EQ(666U, seen);
+
+   while (false == other.empty())
+    {
+      other.erase(other.begin()->first);
+    }
+   EXPECT_TRUE(other.begin() == other.end());
+   EXPECT_EQ(reference.size(), dict.size());
+ }
+
+TEST(TypesTests, testPersistentContainers)
+ {
+      // Enough to need three levels of tree, and to shrink back down.
+   static const int SIZE = 40000;
+   Backwards::Types::PersistentVector<int> array;
+   std::vector<int> expected;
+   for (int i = 0; i < SIZE; ++i)
+    {
+      array.push_back(i);
+      expected.push_back(i);
+    }
+   Backwards::Types::PersistentVector<int> copy = array;
+   for (int i = 0; i < SIZE; i += 7)
+    {
+      copy.set(static_cast<size_t>(i), -i);
+    }
+   for (int i = 0; i < SIZE / 2; ++i)
+    {
+      copy.pop_back();
+    }
+   copy.push_back(17);
+
+      // Changing the copy didn't change the original.
+   ASSERT_EQ(static_cast<size_t>(SIZE), array.size());
+   EXPECT_TRUE(std::equal(expected.begin(), expected.end(), array.begin()));
+   ASSERT_EQ(static_cast<size_t>(SIZE / 2 + 1), copy.size());
+   for (int i = 0; i < SIZE / 2; ++i)
+    {
+      EXPECT_EQ((0 == i % 7) ? -i : i, copy[static_cast<size_t>(i)]);
+    }
+   EXPECT_EQ(17, copy.back());
+   EXPECT_EQ(3, *(array.begin() + 3U));
+
+   while (false == copy.empty())
+    {
+      copy.pop_back();
+    }
+   EXPECT_TRUE(copy.begin() == copy.end());
+   EXPECT_EQ(static_cast<size_t>(SIZE), array.size());
+   EXPECT_EQ(SIZE - 1, array.back());
+
+   testPersistentHashMap<std::hash<int> >();
+   testPersistentHashMap<Clumped>();
+ }
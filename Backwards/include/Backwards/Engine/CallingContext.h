@@ -36,6 +36,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "Backwards/Engine/GetterSetter.h"
 #include "Backwards/Engine/Scope.h"
 
+#include <memory>
 #include <vector>
 
 namespace Backwards
@@ -49,7 +50,9 @@ namespace Input
 namespace Engine
  {
 
+   class Compiled;
    class DebuggerHook;
+   class FunctionContext;
    class Logger;
    class StackFrame;
    class Statement;
@@ -63,20 +66,33 @@ namespace Engine
       void pushContext(StackFrame* newFrame);
       void popContext();
 
+         // Frames are kept and reused, so that a call doesn't allocate its frame. A frame is taken before its
+         // arguments are evaluated, which may take more: they are given back in the opposite order (see PooledFrame).
+      StackFrame& newFrame(const std::shared_ptr<FunctionContext>& function, const Input::Token& callingToken);
+      void freeFrame();
+
       Logger* logger;
       DebuggerHook* debugger;
 
       StackFrame* currentFrame;
       Scope* globalScope;
 
+         // The deepest that calls may nest, in frames, or zero for no limit.
+      size_t maxDepth;
+
       Scope* topScope();
       void pushScope(Scope* scope);
       void popScope();
 
+         // Called before writing to the global scope or the top scope, which others may share.
+      virtual void writeShared();
+
       virtual std::shared_ptr<CallingContext> duplicate(); // This function exists for the debugger.
 
    private:
       std::vector<Scope*> scopes;
+      std::vector<std::unique_ptr<StackFrame> > frames;
+      size_t usedFrames;
 
    protected:
       void duplicate(std::shared_ptr<CallingContext>);
@@ -86,6 +102,7 @@ namespace Engine
     {
    private:
       size_t location;
+      friend class Compiled;
    public:
       explicit GlobalGetter(size_t location);
       std::shared_ptr<Types::ValueType> get(CallingContext&) const override;
@@ -95,6 +112,7 @@ namespace Engine
     {
    private:
       size_t location;
+      friend class Compiled;
    public:
       explicit GlobalSetter(size_t location);
       void set(CallingContext&, const std::shared_ptr<Types::ValueType>&) const override;
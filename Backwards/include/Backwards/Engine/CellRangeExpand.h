@@ -35,6 +35,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "Backwards/Engine/CallingContext.h"
 #include "Backwards/Types/CellRangeValue.h"
 
+#include <functional>
+
 namespace Backwards
  {
 
@@ -45,6 +47,10 @@ namespace Engine
     {
    public:
       virtual std::shared_ptr<Types::ValueType> expand (CallingContext&) const = 0;
+
+      typedef std::function<void (const std::shared_ptr<Types::ValueType>&)> Visitor;
+         // Visit the value of every cell in the range, column by column or row by row, without building anything to hold them.
+      virtual void forEachValue (CallingContext&, bool byColumn, const Visitor&) const = 0;
     };
 
  } // namespace Engine
@@ -0,0 +1,154 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2023, Thomas DiModica
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef BACKWARDS_ENGINE_COMPILED_H
+#define BACKWARDS_ENGINE_COMPILED_H
+
+#include "Backwards/Engine/Statement.h"
+
+#include <vector>
+#include <cstdint>
+
+namespace Backwards
+ {
+
+namespace Engine
+ {
+
+   /*
+      A function body compiled to code for a little register machine.
+
+      The tree goes through a virtual call for every node, and every statement returns a FlowControl
+      to say how it finished. Here, the body is a loop over an array: if, while, for, select,
+      break and continue are jumps, and an instruction reads its operands straight from the frame, so
+      "set x to x * y" is one instruction. Temporaries live in registers that are allocated once for each
+      call, with the number needed worked out when the function is compiled. Variables stay in the
+      StackFrame, so the debugger sees what it always has. Errors have the same messages, and enter the
+      debugger at the same places, as they do in the tree. Anything else is evaluated as a tree, and the
+      tree is the reference.
+   */
+   class Compiled final : public Statement
+    {
+   public:
+      std::shared_ptr<Statement> tree; // What was compiled: it owns the nodes that the code points into.
+
+      explicit Compiled(const std::shared_ptr<Statement>&);
+
+         // Returns the tree itself if it has something the machine can't do.
+      static std::shared_ptr<Statement> compile(const std::shared_ptr<Statement>&);
+
+      FlowControl execute (CallingContext&) const override;
+
+         // Runs the body in the current frame. Returns false if it ran off the end without returning.
+      bool run (CallingContext&, std::shared_ptr<Types::ValueType>& result) const;
+
+   private:
+      enum OpCode : uint8_t
+       {
+         MOVE,
+         ADD,
+         SUB,
+         MUL,
+         DIV,
+         EQ,
+         NE,
+         GT,
+         LT,
+         GE,
+         LE,
+         NEG,
+         NOT,
+         TRUTH, // The truth of an operand, as a number: the rhs of & and |.
+         BOOL,  // A new 1 or 0.
+         STEP,  // A new 1 or -1: the default step of a for loop.
+         INC,   // Step a for loop, in place if only its variable has the value.
+         INDEX,
+         EVAL,  // Evaluate a tree.
+         EXEC,  // Execute a tree that can't change the flow of control.
+         CHECK, // Check that a call is to a function, before its arguments are evaluated.
+         CALL,
+         JUMP,
+         JT,    // Jump if true.
+         JF,    // Jump if false.
+         JT_EQ,
+         JT_NE,
+         JT_GT,
+         JT_LT,
+         JT_GE,
+         JT_LE,
+         JF_EQ,
+         JF_NE,
+         JF_GT,
+         JF_LT,
+         JF_GE,
+         JF_LE,
+         ITER,  // Start iterating over a collection.
+         NEXT,  // Set a variable to the next item of a collection, or jump if there isn't one.
+         DROP,  // Empty registers that won't be read again.
+         RET,
+         END
+       };
+
+      class Instruction final
+       {
+      public:
+         OpCode op;
+         uint32_t dest;  // Where the result goes, or where to jump.
+         uint32_t a;
+         uint32_t b;
+         uint32_t token; // The token of the operator, for the message if it fails.
+         uint32_t guard; // The token of the statement that this is the condition of, which adds to the message.
+       };
+
+      class Call final
+       {
+      public:
+         const FunctionCall* node;
+         size_t args; // Where its arguments start in arguments.
+       };
+
+      class Builder;
+
+      std::vector<Instruction> code;
+      std::vector<std::shared_ptr<Types::ValueType> > constants;
+      std::vector<const Input::Token*> tokens;
+      std::vector<const Expression*> expressions;
+      std::vector<const Statement*> statements;
+      std::vector<Call> calls;
+      std::vector<uint32_t> arguments;
+      size_t registers;
+    };
+
+ } // namespace Engine
+
+ } // namespace Backwards
+
+#endif /* BACKWARDS_ENGINE_COMPILED_H */
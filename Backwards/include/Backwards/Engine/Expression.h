@@ -42,6 +42,7 @@ namespace Engine
  {
 
    class FunctionContext;
+   class StackFrame;
 
    class Expression
     {
@@ -129,6 +130,15 @@ namespace Engine
       FunctionCall(const Input::Token&, const std::shared_ptr<Expression>&, const std::vector<std::shared_ptr<Expression> >&);
 
       std::shared_ptr<Types::ValueType> evaluate (CallingContext&) const override;
+
+         // The steps of evaluate, for things that want to look at the arguments before the call: see Assignment.
+         // getFunction evaluates the location and checks that it is a function that takes these arguments.
+         // The frame for evaluateArgs and call is made with the function that getFunction returns.
+      std::shared_ptr<FunctionContext> getFunction (CallingContext&, std::shared_ptr<Types::FunctionValue>&) const;
+         // The same, given the value of the location: see Compiled.
+      std::shared_ptr<FunctionContext> getFunction (CallingContext&, const std::shared_ptr<Types::ValueType>&, std::shared_ptr<Types::FunctionValue>&) const;
+      void evaluateArgs (CallingContext&, StackFrame&, const Types::FunctionValue&) const;
+      std::shared_ptr<Types::ValueType> call (CallingContext&, StackFrame&) const;
     };
 
 
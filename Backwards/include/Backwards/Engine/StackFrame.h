@@ -44,6 +44,7 @@ namespace Engine
  {
 
    class CallingContext;
+   class Compiled;
    class FunctionContext;
 
    class StackFrame final
@@ -58,16 +59,35 @@ namespace Engine
       StackFrame* prev;
       StackFrame* next;
 
-      const Input::Token& callingToken;
+      const Input::Token* callingToken;
       size_t depth;
 
       StackFrame(std::shared_ptr<FunctionContext> function, const Input::Token& callingToken, StackFrame* prev);
+
+         // Frames are pooled by the CallingContext: these set one up for a call, and empty it after, keeping its storage.
+      void enter(const std::shared_ptr<FunctionContext>& function, const Input::Token& callingToken, StackFrame* prev);
+      void leave();
+    };
+
+      // A frame from the context's pool for the length of a call: it is given back even if the call throws.
+   class PooledFrame final
+    {
+   public:
+      CallingContext& context;
+      StackFrame& frame;
+
+      PooledFrame(CallingContext&, const std::shared_ptr<FunctionContext>&, const Input::Token&);
+      ~PooledFrame();
+
+      PooledFrame(const PooledFrame&) = delete;
+      PooledFrame& operator= (const PooledFrame&) = delete;
     };
 
    class LocalGetter final : public Getter
     {
    private:
       size_t location;
+      friend class Compiled;
    public:
       explicit LocalGetter(size_t location);
       std::shared_ptr<Types::ValueType> get(CallingContext&) const override;
@@ -77,6 +97,7 @@ namespace Engine
     {
    private:
       size_t location;
+      friend class Compiled;
    public:
       explicit LocalSetter(size_t location);
       void set(CallingContext&, const std::shared_ptr<Types::ValueType>&) const override;
@@ -86,6 +107,7 @@ namespace Engine
     {
    private:
       size_t location;
+      friend class Compiled;
    public:
       explicit ArgGetter(size_t location);
       std::shared_ptr<Types::ValueType> get(CallingContext&) const override;
@@ -95,6 +117,7 @@ namespace Engine
     {
    private:
       size_t location;
+      friend class Compiled;
    public:
       explicit ArgSetter(size_t location);
       void set(CallingContext&, const std::shared_ptr<Types::ValueType>&) const override;
@@ -104,6 +127,7 @@ namespace Engine
     {
    private:
       size_t location;
+      friend class Compiled;
    public:
       explicit CaptureGetter(size_t location);
       std::shared_ptr<Types::ValueType> get(CallingContext&) const override;
@@ -113,6 +137,7 @@ namespace Engine
     {
    private:
       size_t location;
+      friend class Compiled;
    public:
       explicit CaptureSetter(size_t location);
       void set(CallingContext&, const std::shared_ptr<Types::ValueType>&) const override;
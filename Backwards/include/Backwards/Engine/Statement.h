@@ -48,13 +48,17 @@ namespace Engine
  {
 
    class Expression;
+   class FunctionCall;
 
+      // What a statement did to the flow of control. This is returned by value: most statements just fall through,
+      // and that shouldn't cost an allocation.
    class FlowControl final
     {
    public:
 
       enum Type
        {
+         NONE, // Fall through to the next statement.
          RETURN,
          BREAK,
          CONTINUE
@@ -62,13 +66,13 @@ namespace Engine
 
       static const size_t NO_TARGET;
 
-      const Input::Token& source;
+      const Input::Token* source;
       Type type;
       size_t target;
       std::shared_ptr<Types::ValueType> value;
 
+      FlowControl() : source(nullptr), type(NONE), target(0U) { }
       FlowControl(const Input::Token&, Type, size_t, const std::shared_ptr<Types::ValueType>&);
-      ~FlowControl() = default;
     };
 
    class Statement
@@ -81,7 +85,7 @@ namespace Engine
 
        /* CallingContext can't be const, because if we propagate it
           to a function call, the function call is allowed to modify it. */
-      virtual std::shared_ptr<FlowControl> execute (CallingContext&) const = 0;
+      virtual FlowControl execute (CallingContext&) const = 0;
     };
 
    class NOP final : public Statement
@@ -89,7 +93,7 @@ namespace Engine
    public:
       explicit NOP(const Input::Token&);
 
-      std::shared_ptr<FlowControl> execute (CallingContext&) const override;
+      FlowControl execute (CallingContext&) const override;
     };
 
    class Expr final : public Statement
@@ -99,7 +103,7 @@ namespace Engine
 
       Expr(const Input::Token&, const std::shared_ptr<Expression>&);
 
-      std::shared_ptr<FlowControl> execute (CallingContext&) const override;
+      FlowControl execute (CallingContext&) const override;
     };
 
    class StatementSeq final : public Statement
@@ -109,7 +113,7 @@ namespace Engine
 
       StatementSeq(const Input::Token&, const std::vector<std::shared_ptr<Statement> >&);
 
-      std::shared_ptr<FlowControl> execute (CallingContext&) const override;
+      FlowControl execute (CallingContext&) const override;
     };
 
    class RecAssignState final
@@ -122,7 +126,9 @@ namespace Engine
 
       RecAssignState(const Input::Token&, const std::shared_ptr<Expression>&);
 
-      std::shared_ptr<Types::ValueType> evaluate (CallingContext&, const std::shared_ptr<Types::ValueType>& lhs, const std::shared_ptr<Expression>& rhs) const;
+         // If lhs is the value of a variable, and no one else can see it, then it is changed in place.
+      std::shared_ptr<Types::ValueType> evaluate (CallingContext&, const std::shared_ptr<Types::ValueType>& lhs, const std::shared_ptr<Expression>& rhs,
+         const Getter* variable) const;
 
       std::shared_ptr<Types::ValueType> getIndex (std::shared_ptr<Types::ValueType> container, std::shared_ptr<Types::ValueType> index, CallingContext&) const;
       std::shared_ptr<Types::ValueType> setIndex (std::shared_ptr<Types::ValueType> container, std::shared_ptr<Types::ValueType> index,
@@ -140,7 +146,12 @@ namespace Engine
       Assignment(const Input::Token&, const std::shared_ptr<Getter>&, const std::shared_ptr<Setter>&,
          const std::shared_ptr<RecAssignState>&, const std::shared_ptr<Expression>&);
 
-      std::shared_ptr<FlowControl> execute (CallingContext&) const override;
+      FlowControl execute (CallingContext&) const override;
+
+   private:
+      friend class Compiled;
+         // The rhs, if it is "Function(variable; ...)": PushBack and friends can change the collection in place.
+      const FunctionCall* update;
     };
 
    class IfStatement final : public Statement
@@ -152,7 +163,7 @@ namespace Engine
 
       IfStatement(const Input::Token&, const std::shared_ptr<Expression>&, const std::shared_ptr<Statement>&, const std::shared_ptr<Statement>&);
 
-      std::shared_ptr<FlowControl> execute (CallingContext&) const override;
+      FlowControl execute (CallingContext&) const override;
     };
 
    class WhileStatement final : public Statement
@@ -164,7 +175,7 @@ namespace Engine
 
       WhileStatement(const Input::Token&, const std::shared_ptr<Expression>&, const std::shared_ptr<Statement>&, size_t);
 
-      std::shared_ptr<FlowControl> execute (CallingContext&) const override;
+      FlowControl execute (CallingContext&) const override;
     };
 
    class CaseContainer final
@@ -199,14 +210,14 @@ namespace Engine
 
       SelectStatement(const Input::Token&, const std::shared_ptr<Expression>&, const std::vector<std::shared_ptr<CaseContainer> >&);
 
-      std::shared_ptr<FlowControl> execute (CallingContext&) const override;
+      FlowControl execute (CallingContext&) const override;
     };
 
    class ForStatement final : public Statement
     {
    private:
-      std::shared_ptr<FlowControl> loopIter (CallingContext&, std::shared_ptr<Types::ValueType>) const;
-      std::shared_ptr<FlowControl> collIter (CallingContext&, std::shared_ptr<Types::ValueType>) const;
+      FlowControl loopIter (CallingContext&, std::shared_ptr<Types::ValueType>) const;
+      FlowControl collIter (CallingContext&, std::shared_ptr<Types::ValueType>) const;
 
    public:
       std::shared_ptr<Getter> getter;
@@ -222,7 +233,10 @@ namespace Engine
          const std::shared_ptr<Expression>&, bool, const std::shared_ptr<Expression>&,
          const std::shared_ptr<Expression>&, const std::shared_ptr<Statement>&, size_t);
 
-      std::shared_ptr<FlowControl> execute (CallingContext&) const override;
+      FlowControl execute (CallingContext&) const override;
+
+         // Steps the value of a loop over numbers, in place if nothing but the loop and its variable has it.
+      static void advance (std::shared_ptr<Types::ValueType>& current, const Types::FloatValue& step, bool unshared);
     };
 
    class FlowControlStatement final : public Statement
@@ -234,7 +248,7 @@ namespace Engine
 
       FlowControlStatement(const Input::Token&, FlowControl::Type, size_t, const std::shared_ptr<Expression>&);
 
-      std::shared_ptr<FlowControl> execute (CallingContext&) const override;
+      FlowControl execute (CallingContext&) const override;
     };
 
    class StandardConstantFunction final : public Statement
@@ -242,7 +256,7 @@ namespace Engine
    public:
       ConstantFunctionPointer function;
       explicit StandardConstantFunction(ConstantFunctionPointer);
-      std::shared_ptr<FlowControl> execute (CallingContext&) const override;
+      FlowControl execute (CallingContext&) const override;
     };
 
    class StandardConstantFunctionWithContext final : public Statement
@@ -250,7 +264,7 @@ namespace Engine
    public:
       ConstantFunctionPointerWithContext function;
       explicit StandardConstantFunctionWithContext(ConstantFunctionPointerWithContext);
-      std::shared_ptr<FlowControl> execute (CallingContext&) const override;
+      FlowControl execute (CallingContext&) const override;
     };
 
    class StandardUnaryFunction final : public Statement
@@ -258,7 +272,7 @@ namespace Engine
    public:
       UnaryFunctionPointer function;
       explicit StandardUnaryFunction(UnaryFunctionPointer);
-      std::shared_ptr<FlowControl> execute (CallingContext&) const override;
+      FlowControl execute (CallingContext&) const override;
     };
 
    class StandardUnaryFunctionWithContext final : public Statement
@@ -266,7 +280,7 @@ namespace Engine
    public:
       UnaryFunctionPointerWithContext function;
       explicit StandardUnaryFunctionWithContext(UnaryFunctionPointerWithContext);
-      std::shared_ptr<FlowControl> execute (CallingContext&) const override;
+      FlowControl execute (CallingContext&) const override;
     };
 
    class StandardBinaryFunction final : public Statement
@@ -274,7 +288,7 @@ namespace Engine
    public:
       BinaryFunctionPointer function;
       explicit StandardBinaryFunction(BinaryFunctionPointer);
-      std::shared_ptr<FlowControl> execute (CallingContext&) const override;
+      FlowControl execute (CallingContext&) const override;
     };
 
    class StandardTernaryFunction final : public Statement
@@ -282,7 +296,7 @@ namespace Engine
    public:
       TernaryFunctionPointer function;
       explicit StandardTernaryFunction(TernaryFunctionPointer);
-      std::shared_ptr<FlowControl> execute (CallingContext&) const override;
+      FlowControl execute (CallingContext&) const override;
     };
 
  } // namespace Engine
@@ -122,6 +122,17 @@ namespace Engine
    STDLIB_TERNARY_DECL(SetIndex);
    STDLIB_TERNARY_DECL(Insert);
 
+   /*
+      PushBack, PopBack, SetIndex, Insert and RemoveKey, done to the collection they're given instead of to a copy.
+      They are for a collection that no one else can see, so that changing it can't be noticed.
+      Where the function they stand in for would throw, they return false and change nothing.
+   */
+   bool PushBackInPlace(Types::ValueType& first, const std::shared_ptr<Types::ValueType>& second);
+   bool PopBackInPlace(Types::ValueType& arg);
+   bool RemoveKeyInPlace(Types::ValueType& first, const std::shared_ptr<Types::ValueType>& second);
+   bool SetIndexInPlace(Types::ValueType& first, const std::shared_ptr<Types::ValueType>& second, const std::shared_ptr<Types::ValueType>& third);
+   bool InsertInPlace(Types::ValueType& first, const std::shared_ptr<Types::ValueType>& second, const std::shared_ptr<Types::ValueType>& third);
+
  } // namespace Engine
 
  } // namespace Backwards
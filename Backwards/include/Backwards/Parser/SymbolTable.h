@@ -112,6 +112,9 @@ namespace Parser
        };
 
       std::map<std::string, std::weak_ptr<Engine::FunctionContext> > activeFunctions;
+
+         // Compile functions as they are parsed: see Engine/Compiled.h.
+      bool compile;
       IdentifierType lookup (const std::string&) const;
 
       size_t newLoop();
@@ -33,8 +33,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define BACKWARDS_TYPES_ARRAYVALUE_H
 
 #include "Backwards/Types/ValueType.h"
-
-#include <vector>
+#include "Backwards/Types/PersistentVector.h"
 
 namespace Backwards
  {
@@ -46,7 +45,7 @@ namespace Types
     {
 
    public:
-      std::vector<std::shared_ptr<ValueType> > value;
+      PersistentVector<std::shared_ptr<ValueType> > value;
 
       const std::string& getTypeName() const override;
 
@@ -33,8 +33,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define BACKWARDS_TYPES_DICTIONARYVALUE_H
 
 #include "Backwards/Types/ValueType.h"
+#include "Backwards/Types/PersistentHashMap.h"
 
-#include <map>
+#include <vector>
 
 namespace Backwards
  {
@@ -48,12 +49,28 @@ namespace Types
          bool operator() (const std::shared_ptr<ValueType>& lhs, const std::shared_ptr<ValueType>& rhs) const;
     };
 
+   class HashValue final
+    {
+      public:
+         size_t operator() (const std::shared_ptr<ValueType>& key) const;
+    };
+
+   class CompareValue final
+    {
+      public:
+         bool operator() (const std::shared_ptr<ValueType>& lhs, const std::shared_ptr<ValueType>& rhs) const;
+    };
+
    class DictionaryValue final : public ValueType
     {
 
    public:
-      // Should probably use an unsorted_map. We'll see how this goes.
-      std::map<std::shared_ptr<ValueType>, std::shared_ptr<ValueType>, ChristHowHorrifying> value;
+      typedef PersistentHashMap<std::shared_ptr<ValueType>, std::shared_ptr<ValueType>, HashValue, CompareValue> Map;
+      Map value;
+
+         // The items in the order of their keys, which is the order that a for loop and GetKeys give.
+         // The table has no order of its own, so this sorts: the pointers are good until the next change.
+      std::vector<const Map::value_type*> sorted() const;
 
       const std::string& getTypeName() const override;
 
@@ -0,0 +1,395 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2023, Thomas DiModica
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef BACKWARDS_TYPES_PERSISTENTHASHMAP_H
+#define BACKWARDS_TYPES_PERSISTENTHASHMAP_H
+
+#include <memory>
+#include <vector>
+#include <bitset>
+#include <utility>
+#include <iterator>
+#include <cstddef>
+#include <cstdint>
+
+namespace Backwards
+ {
+
+namespace Types
+ {
+
+   /*
+      A hash map that is cheap to copy and then change: see PersistentVector.
+
+      This is a hash array mapped trie. Each level takes five bits of the key's hash, and a node
+      keeps the items and the children it has packed in two arrays, with a bitmap saying which
+      of the 32 slots they are in. A copy shares all of the nodes, and a change copies the nodes
+      on the path to the key, unless nobody else has them. Keys whose hashes are all the same
+      end up together in a node at the bottom, which is searched in order.
+
+      The order of iteration is that of the hashes: it isn't anything that a user can make sense
+      of, so anything that shows the order to a user needs to sort.
+   */
+   template <class K, class V, class Hash, class Equal>
+   class PersistentHashMap final
+    {
+   private:
+      static const size_t BITS = 5U;
+      static const size_t MASK = (1U << BITS) - 1U;
+      static const size_t HASH_BITS = sizeof(size_t) * 8U;
+         // The levels that use the hash, and the one at the bottom for keys whose hashes are the same.
+      static const size_t MAX_DEPTH = (HASH_BITS + BITS - 1U) / BITS + 1U;
+
+      class Entry final
+       {
+      public:
+         size_t hash;
+         std::pair<K, V> item;
+       };
+
+      class Node final
+       {
+      public:
+         uint32_t items;    // The slots that hold an item,
+         uint32_t children; // and those that hold a child.
+         std::vector<Entry> item;
+         std::vector<std::shared_ptr<Node> > child;
+
+         Node() : items(0U), children(0U) { }
+       };
+
+      std::shared_ptr<Node> root;
+      size_t count;
+
+   public:
+      class const_iterator final
+       {
+      public:
+         typedef std::forward_iterator_tag iterator_category;
+         typedef std::pair<K, V> value_type;
+         typedef std::ptrdiff_t difference_type;
+         typedef const value_type* pointer;
+         typedef const value_type& reference;
+
+         const_iterator() : depth(0U) { }
+
+         const std::pair<K, V>& operator * () const { return stack[depth - 1U].node->item[stack[depth - 1U].item].item; }
+         const std::pair<K, V>* operator -> () const { return &**this; }
+
+         const_iterator& operator ++ ()
+          {
+            ++stack[depth - 1U].item;
+            settle();
+            return *this;
+          }
+         const_iterator operator ++ (int) { const_iterator result = *this; ++*this; return result; }
+
+         bool operator == (const const_iterator& rhs) const
+          {
+            return (depth == rhs.depth) && ((0U == depth) ||
+               ((stack[depth - 1U].node == rhs.stack[depth - 1U].node) && (stack[depth - 1U].item == rhs.stack[depth - 1U].item)));
+          }
+         bool operator != (const const_iterator& rhs) const { return false == (*this == rhs); }
+
+      private:
+         friend class PersistentHashMap;
+
+            // A node's items are visited, then its children.
+         class Frame final
+          {
+         public:
+            const Node* node;
+            size_t item;
+            size_t child;
+          };
+
+         Frame stack [MAX_DEPTH];
+         size_t depth;
+
+         void push(const Node* node)
+          {
+            stack[depth] = Frame { node, 0U, 0U };
+            ++depth;
+          }
+
+            // Moves to the next item, if the current frame is out of them.
+         void settle()
+          {
+            while (0U != depth)
+             {
+               Frame& top = stack[depth - 1U];
+               if (top.item < top.node->item.size())
+                {
+                  return;
+                }
+               if (top.child < top.node->child.size())
+                {
+                  ++top.child;
+                  push(top.node->child[top.child - 1U].get());
+                }
+               else
+                {
+                  --depth;
+                }
+             }
+          }
+       };
+      typedef const_iterator iterator;
+      typedef std::pair<K, V> value_type;
+      typedef size_t size_type;
+
+      PersistentHashMap() : count(0U) { }
+
+      size_t size() const { return count; }
+      bool empty() const { return 0U == count; }
+
+      const_iterator begin() const
+       {
+         const_iterator result;
+         if (nullptr != root.get())
+          {
+            result.push(root.get());
+            result.settle();
+          }
+         return result;
+       }
+      const_iterator end() const { return const_iterator(); }
+
+         // Returns nullptr if the key isn't here.
+      const std::pair<K, V>* find(const K& key) const
+       {
+         Equal equal;
+         size_t hash = Hash()(key);
+         const Node* node = root.get();
+         size_t shift = 0U;
+         while ((nullptr != node) && (shift < HASH_BITS))
+          {
+            uint32_t bit = 1U << ((hash >> shift) & MASK);
+            if (0U != (node->items & bit))
+             {
+               const Entry& entry = node->item[position(node->items, bit)];
+               return ((hash == entry.hash) && (true == equal(key, entry.item.first))) ? &entry.item : nullptr;
+             }
+            if (0U == (node->children & bit))
+             {
+               return nullptr;
+             }
+            node = node->child[position(node->children, bit)].get();
+            shift += BITS;
+          }
+         if (nullptr != node)
+          {
+            for (const Entry& entry : node->item)
+             {
+               if (true == equal(key, entry.item.first))
+                {
+                  return &entry.item;
+                }
+             }
+          }
+         return nullptr;
+       }
+
+      void clear()
+       {
+         root.reset();
+         count = 0U;
+       }
+
+         // Like std::map: an existing key is left alone. Returns whether the item was added.
+      bool insert(const std::pair<K, V>& item)
+       {
+         bool added = false;
+         put(root, 0U, Entry { Hash()(item.first), item }, false, added);
+         if (true == added)
+          {
+            ++count;
+          }
+         return added;
+       }
+      bool emplace(const std::pair<K, V>& item) { return insert(item); }
+
+         // Adds or replaces.
+      void set(const K& key, const V& value)
+       {
+         bool added = false;
+         put(root, 0U, Entry { Hash()(key), std::make_pair(key, value) }, true, added);
+         if (true == added)
+          {
+            ++count;
+          }
+       }
+
+      size_t erase(const K& key)
+       {
+            // Look first, so that taking out a key that isn't here doesn't copy anything.
+         if (nullptr == find(key))
+          {
+            return 0U;
+          }
+         remove(root, 0U, Hash()(key), key);
+         --count;
+         return 1U;
+       }
+
+   private:
+      static size_t position(uint32_t bitmap, uint32_t bit)
+       {
+         return std::bitset<32>(bitmap & (bit - 1U)).count();
+       }
+
+      static void own(std::shared_ptr<Node>& node)
+       {
+         if (1 != node.use_count())
+          {
+            node = std::make_shared<Node>(*node);
+          }
+       }
+
+      static void put(std::shared_ptr<Node>& node, size_t shift, const Entry& entry, bool replace, bool& added)
+       {
+         if (nullptr == node.get())
+          {
+            node = std::make_shared<Node>();
+          }
+
+         Equal equal;
+         if (shift >= HASH_BITS)
+          {
+            for (size_t i = 0U; i < node->item.size(); ++i)
+             {
+               if (true == equal(entry.item.first, node->item[i].item.first))
+                {
+                  if (true == replace)
+                   {
+                     own(node);
+                     node->item[i].item.second = entry.item.second;
+                   }
+                  return;
+                }
+             }
+            own(node);
+            node->item.push_back(entry);
+            added = true;
+            return;
+          }
+
+         uint32_t bit = 1U << ((entry.hash >> shift) & MASK);
+         if (0U != (node->children & bit))
+          {
+            own(node);
+            put(node->child[position(node->children, bit)], shift + BITS, entry, replace, added);
+            return;
+          }
+
+         size_t index = position(node->items, bit);
+         if (0U != (node->items & bit))
+          {
+            const Entry& existing = node->item[index];
+            if ((entry.hash == existing.hash) && (true == equal(entry.item.first, existing.item.first)))
+             {
+               if (true == replace)
+                {
+                  own(node);
+                  node->item[index].item.second = entry.item.second;
+                }
+               return;
+             }
+
+               // Two keys want this slot: move them both down a level.
+            own(node);
+            std::shared_ptr<Node> child;
+            bool ignored = false;
+            put(child, shift + BITS, node->item[index], false, ignored);
+            put(child, shift + BITS, entry, false, added);
+            node->item.erase(node->item.begin() + index);
+            node->items &= ~bit;
+            node->child.insert(node->child.begin() + position(node->children, bit), std::move(child));
+            node->children |= bit;
+            return;
+          }
+
+         own(node);
+         node->item.insert(node->item.begin() + index, entry);
+         node->items |= bit;
+         added = true;
+       }
+
+         // The key is here: erase checked.
+      static void remove(std::shared_ptr<Node>& node, size_t shift, size_t hash, const K& key)
+       {
+         own(node);
+         if (shift >= HASH_BITS)
+          {
+            Equal equal;
+            for (size_t i = 0U; i < node->item.size(); ++i)
+             {
+               if (true == equal(key, node->item[i].item.first))
+                {
+                  node->item.erase(node->item.begin() + i);
+                  break;
+                }
+             }
+            return;
+          }
+
+         uint32_t bit = 1U << ((hash >> shift) & MASK);
+         if (0U != (node->items & bit))
+          {
+            node->item.erase(node->item.begin() + position(node->items, bit));
+            node->items &= ~bit;
+            return;
+          }
+
+         size_t index = position(node->children, bit);
+         std::shared_ptr<Node>& child = node->child[index];
+         remove(child, shift + BITS, hash, key);
+
+            // Don't leave a child behind with one item or none: bring the item back up.
+         if ((0U == child->children) && (child->item.size() < 2U))
+          {
+            if (1U == child->item.size())
+             {
+               Entry last = child->item[0U];
+               node->item.insert(node->item.begin() + position(node->items, bit), std::move(last));
+               node->items |= bit;
+             }
+            node->child.erase(node->child.begin() + index);
+            node->children &= ~bit;
+          }
+       }
+    };
+
+ } // namespace Types
+
+ } // namespace Backwards
+
+#endif /* BACKWARDS_TYPES_PERSISTENTHASHMAP_H */
@@ -0,0 +1,405 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2023, Thomas DiModica
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef BACKWARDS_TYPES_PERSISTENTVECTOR_H
+#define BACKWARDS_TYPES_PERSISTENTVECTOR_H
+
+#include <memory>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <initializer_list>
+
+namespace Backwards
+ {
+
+namespace Types
+ {
+
+   /*
+      A vector that is cheap to copy and then change.
+
+      Backwards values are immutable: a function that changes an array makes a new one.
+      With a std::vector, that is a copy of the whole thing, so building an array one element
+      at a time is quadratic. This is a tree of 32-wide nodes, with the last (up to) 32 elements
+      in a separate tail node. A copy shares all of the nodes. A change copies the nodes on the
+      path to what changed, unless nobody else has them, in which case it changes them in place.
+      So, push_back, pop_back and set are O(log n), and usually O(1), and copies never see
+      each other's changes.
+   */
+   template <class T>
+   class PersistentVector final
+    {
+   private:
+      static const size_t BITS = 5U;
+      static const size_t WIDTH = 1U << BITS;
+      static const size_t MASK = WIDTH - 1U;
+
+      class Node
+       {
+       };
+
+      class Branch final : public Node
+       {
+      public:
+         std::shared_ptr<Node> children [WIDTH];
+       };
+
+      class Leaf final : public Node
+       {
+      public:
+         T items [WIDTH];
+       };
+
+      std::shared_ptr<Branch> root; // Null until the tail first fills.
+      std::shared_ptr<Leaf> tail;
+      size_t count;
+      size_t shift; // How far to shift an index to get the child of the root.
+
+   public:
+      class const_iterator final
+       {
+      public:
+         typedef std::random_access_iterator_tag iterator_category;
+         typedef T value_type;
+         typedef std::ptrdiff_t difference_type;
+         typedef const T* pointer;
+         typedef const T& reference;
+
+         const_iterator() : owner(nullptr), index(0U), items(nullptr) { }
+         const_iterator(const PersistentVector* owner, size_t index) : owner(owner), index(index), items(nullptr) { find(); }
+
+         const T& operator * () const { return items[index & MASK]; }
+         const T* operator -> () const { return &items[index & MASK]; }
+         const T& operator [] (difference_type n) const { return (*owner)[index + n]; }
+
+         const_iterator& operator ++ ()
+          {
+            ++index;
+            if (0U == (index & MASK))
+             {
+               find();
+             }
+            return *this;
+          }
+         const_iterator operator ++ (int) { const_iterator result = *this; ++*this; return result; }
+         const_iterator& operator -- ()
+          {
+            if (0U == (index & MASK))
+             {
+               --index;
+               find();
+             }
+            else
+             {
+               --index;
+             }
+            return *this;
+          }
+         const_iterator operator -- (int) { const_iterator result = *this; --*this; return result; }
+         const_iterator& operator += (difference_type n) { index += n; find(); return *this; }
+         const_iterator& operator -= (difference_type n) { index -= n; find(); return *this; }
+         const_iterator operator + (difference_type n) const { return const_iterator(owner, index + n); }
+         const_iterator operator - (difference_type n) const { return const_iterator(owner, index - n); }
+         difference_type operator - (const const_iterator& rhs) const { return static_cast<difference_type>(index) - static_cast<difference_type>(rhs.index); }
+
+         bool operator == (const const_iterator& rhs) const { return index == rhs.index; }
+         bool operator != (const const_iterator& rhs) const { return index != rhs.index; }
+         bool operator < (const const_iterator& rhs) const { return index < rhs.index; }
+         bool operator > (const const_iterator& rhs) const { return index > rhs.index; }
+         bool operator <= (const const_iterator& rhs) const { return index <= rhs.index; }
+         bool operator >= (const const_iterator& rhs) const { return index >= rhs.index; }
+
+      private:
+         const PersistentVector* owner;
+         size_t index;
+         const T* items; // The node that index is in: we only look for it again when we leave it.
+
+         void find()
+          {
+            items = (index < owner->count) ? owner->leafFor(index)->items : nullptr;
+          }
+       };
+      typedef const_iterator iterator;
+      typedef T value_type;
+      typedef size_t size_type;
+
+      PersistentVector() : count(0U), shift(BITS) { }
+      PersistentVector(size_t n, const T& item) : count(0U), shift(BITS)
+       {
+         for (size_t i = 0U; i < n; ++i)
+          {
+            push_back(item);
+          }
+       }
+      template <class InputIterator>
+      PersistentVector(InputIterator first, InputIterator last) : count(0U), shift(BITS)
+       {
+         for (; first != last; ++first)
+          {
+            push_back(*first);
+          }
+       }
+      PersistentVector(std::initializer_list<T> items) : PersistentVector(items.begin(), items.end()) { }
+
+      size_t size() const { return count; }
+      bool empty() const { return 0U == count; }
+
+      const_iterator begin() const { return const_iterator(this, 0U); }
+      const_iterator end() const { return const_iterator(this, count); }
+
+      const T& operator [] (size_t index) const
+       {
+         return leafFor(index)->items[index & MASK];
+       }
+      const T& front() const { return (*this)[0U]; }
+      const T& back() const { return (*this)[count - 1U]; }
+
+      void clear()
+       {
+         root.reset();
+         tail.reset();
+         count = 0U;
+         shift = BITS;
+       }
+
+      void push_back(const T& item)
+       {
+         size_t offset = tailOffset();
+         if (count - offset < WIDTH)
+          {
+            own(tail);
+            tail->items[count - offset] = item;
+            ++count;
+            return;
+          }
+
+            // The tail is full: put it in the tree and start a new one.
+         if (nullptr == root.get())
+          {
+            root = std::make_shared<Branch>();
+            root->children[0U] = tail;
+          }
+         else if ((count >> BITS) > (static_cast<size_t>(1U) << shift))
+          {
+               // The tree is full: grow it a level.
+            std::shared_ptr<Branch> newRoot = std::make_shared<Branch>();
+            newRoot->children[0U] = root;
+            newRoot->children[1U] = pathTo(shift, tail);
+            root = newRoot;
+            shift += BITS;
+          }
+         else
+          {
+            own(root);
+            pushTail(root.get(), shift, count - 1U, tail);
+          }
+         tail = std::make_shared<Leaf>();
+         tail->items[0U] = item;
+         ++count;
+       }
+
+      template <class... Args>
+      void emplace_back(Args&&... args)
+       {
+         push_back(T(std::forward<Args>(args)...));
+       }
+
+      void pop_back()
+       {
+         if (1U == count)
+          {
+            clear();
+            return;
+          }
+         size_t offset = tailOffset();
+         if (count - offset > 1U)
+          {
+            own(tail);
+            tail->items[count - offset - 1U] = T();
+            --count;
+            return;
+          }
+
+            // The tail is empty now: the last node in the tree becomes the tail.
+         tail = leafAt(count - 2U);
+         if (WIDTH == count - 1U)
+          {
+            root.reset();
+          }
+         else
+          {
+            own(root);
+            popTail(root.get(), shift, count - 2U);
+            if ((shift > BITS) && (nullptr == root->children[1U].get()))
+             {
+               root = std::static_pointer_cast<Branch>(root->children[0U]);
+               shift -= BITS;
+             }
+          }
+         --count;
+       }
+
+      void set(size_t index, const T& item)
+       {
+         if (index >= tailOffset())
+          {
+            own(tail);
+            tail->items[index & MASK] = item;
+            return;
+          }
+         own(root);
+         Branch* node = root.get();
+         for (size_t level = shift; level > BITS; level -= BITS)
+          {
+            std::shared_ptr<Node>& child = node->children[(index >> level) & MASK];
+            ownAs<Branch>(child);
+            node = static_cast<Branch*>(child.get());
+          }
+         std::shared_ptr<Node>& leaf = node->children[(index >> BITS) & MASK];
+         ownAs<Leaf>(leaf);
+         static_cast<Leaf*>(leaf.get())->items[index & MASK] = item;
+       }
+
+   private:
+      size_t tailOffset() const
+       {
+         return (count < WIDTH) ? 0U : (((count - 1U) >> BITS) << BITS);
+       }
+
+      const Leaf* leafFor(size_t index) const
+       {
+         if (index >= tailOffset())
+          {
+            return tail.get();
+          }
+         const Node* node = root.get();
+         for (size_t level = shift; level > 0U; level -= BITS)
+          {
+            node = static_cast<const Branch*>(node)->children[(index >> level) & MASK].get();
+          }
+         return static_cast<const Leaf*>(node);
+       }
+
+      std::shared_ptr<Leaf> leafAt(size_t index) const
+       {
+         const Node* node = root.get();
+         for (size_t level = shift; level > BITS; level -= BITS)
+          {
+            node = static_cast<const Branch*>(node)->children[(index >> level) & MASK].get();
+          }
+         return std::static_pointer_cast<Leaf>(static_cast<const Branch*>(node)->children[(index >> BITS) & MASK]);
+       }
+
+         // Copies the node if anyone else can see it.
+      static void own(std::shared_ptr<Leaf>& node)
+       {
+         if (nullptr == node.get())
+          {
+            node = std::make_shared<Leaf>();
+          }
+         else if (1 != node.use_count())
+          {
+            node = std::make_shared<Leaf>(*node);
+          }
+       }
+
+      static void own(std::shared_ptr<Branch>& node)
+       {
+         if (1 != node.use_count())
+          {
+            node = std::make_shared<Branch>(*node);
+          }
+       }
+
+      template <class X>
+      static void ownAs(std::shared_ptr<Node>& node)
+       {
+         if (1 != node.use_count())
+          {
+            node = std::make_shared<X>(*static_cast<const X*>(node.get()));
+          }
+       }
+
+      static std::shared_ptr<Node> pathTo(size_t level, const std::shared_ptr<Leaf>& leaf)
+       {
+         if (0U == level)
+          {
+            return leaf;
+          }
+         std::shared_ptr<Branch> result = std::make_shared<Branch>();
+         result->children[0U] = pathTo(level - BITS, leaf);
+         return result;
+       }
+
+         // Puts the leaf with the element at last in, under a node we own.
+      static void pushTail(Branch* node, size_t level, size_t last, const std::shared_ptr<Leaf>& leaf)
+       {
+         std::shared_ptr<Node>& child = node->children[(last >> level) & MASK];
+         if (BITS == level)
+          {
+            child = leaf;
+          }
+         else if (nullptr == child.get())
+          {
+            child = pathTo(level - BITS, leaf);
+          }
+         else
+          {
+            ownAs<Branch>(child);
+            pushTail(static_cast<Branch*>(child.get()), level - BITS, last, leaf);
+          }
+       }
+
+         // Takes out the leaf with the element at last, which is now the tail, and any branch that leaves empty.
+         // Returns true if this node is now empty.
+      static bool popTail(Branch* node, size_t level, size_t last)
+       {
+         size_t index = (last >> level) & MASK;
+         std::shared_ptr<Node>& child = node->children[index];
+         if (BITS != level)
+          {
+            ownAs<Branch>(child);
+            if (false == popTail(static_cast<Branch*>(child.get()), level - BITS, last))
+             {
+               return false;
+             }
+          }
+         child.reset();
+         return 0U == index;
+       }
+    };
+
+ } // namespace Types
+
+ } // namespace Backwards
+
+#endif /* BACKWARDS_TYPES_PERSISTENTVECTOR_H */
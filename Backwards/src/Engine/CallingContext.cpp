@@ -33,6 +33,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "Backwards/Engine/FatalException.h"
 #include "Backwards/Engine/StackFrame.h"
+#include "Backwards/Engine/DebuggerHook.h"
+#include "Backwards/Input/Token.h"
+
+#include <sstream>
 
 namespace Backwards
  {
@@ -40,7 +44,7 @@ namespace Backwards
 namespace Engine
  {
 
-   CallingContext::CallingContext() : logger(nullptr), debugger(nullptr), currentFrame(nullptr), globalScope(nullptr)
+   CallingContext::CallingContext() : logger(nullptr), debugger(nullptr), currentFrame(nullptr), globalScope(nullptr), maxDepth(0U), usedFrames(0U)
     {
     }
 
@@ -67,6 +71,38 @@ namespace Engine
        }
     }
 
+   StackFrame& CallingContext::newFrame(const std::shared_ptr<FunctionContext>& function, const Input::Token& callingToken)
+    {
+      size_t depth = (nullptr == currentFrame) ? 1U : currentFrame->depth + 1U;
+      if ((0U != maxDepth) && (depth > maxDepth))
+       {
+         std::stringstream str;
+         str << "Calls nested more than " << maxDepth << " deep at " << callingToken.lineLocation << " on line " << callingToken.lineNumber << " in file " << callingToken.sourceFile;
+         if (nullptr != debugger)
+          {
+            debugger->EnterDebugger(str.str(), *this);
+          }
+         throw FatalException(str.str());
+       }
+
+      if (frames.size() == usedFrames)
+       {
+         frames.emplace_back(std::make_unique<StackFrame>(function, callingToken, currentFrame));
+       }
+      else
+       {
+         frames[usedFrames]->enter(function, callingToken, currentFrame);
+       }
+      ++usedFrames;
+      return *frames[usedFrames - 1U];
+    }
+
+   void CallingContext::freeFrame()
+    {
+      --usedFrames;
+      frames[usedFrames]->leave();
+    }
+
    Scope* CallingContext::topScope()
     {
       if (false == scopes.empty())
@@ -86,6 +122,10 @@ namespace Engine
       scopes.pop_back();
     }
 
+   void CallingContext::writeShared()
+    {
+    }
+
    std::shared_ptr<CallingContext> CallingContext::duplicate()
     {
       std::shared_ptr<CallingContext> result = std::make_shared<CallingContext>();
@@ -98,6 +138,7 @@ namespace Engine
       result->logger = logger;
       result->debugger = nullptr; // Prevent Debugger-ception
       result->globalScope = globalScope;
+      result->maxDepth = maxDepth;
       result->pushScope(topScope());
     }
 
@@ -199,6 +240,7 @@ namespace Engine
 
    void GlobalSetter::set(CallingContext& context, const std::shared_ptr<Types::ValueType>& value) const
     {
+      context.writeShared();
       context.globalScope->vars[location] = value;
     }
 
@@ -216,6 +258,7 @@ namespace Engine
        {
          throw FatalException("Write of local variable with bad location.");
        }
+      context.writeShared();
       context.topScope()->vars[location] = value;
     }
 
@@ -0,0 +1,1188 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2023, Thomas DiModica
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "Backwards/Engine/Compiled.h"
+#include "Backwards/Engine/Expression.h"
+#include "Backwards/Engine/StdLib.h"
+#include "Backwards/Engine/StackFrame.h"
+#include "Backwards/Engine/FunctionContext.h"
+#include "Backwards/Engine/FatalException.h"
+#include "Backwards/Engine/DebuggerHook.h"
+
+#include "Backwards/Types/ArrayValue.h"
+#include "Backwards/Types/FloatValue.h"
+#include "Backwards/Types/DictionaryValue.h"
+#include "Backwards/Types/CellRangeValue.h"
+#include "Backwards/Types/FunctionValue.h"
+
+#include "NumberSystem.h"
+
+#include <set>
+#include <typeinfo>
+
+namespace Backwards
+ {
+
+namespace Engine
+ {
+
+namespace
+ {
+
+      // An operand is a kind of place, in the top bits, and an index into it.
+   enum OperandKind : uint32_t
+    {
+      CONSTANT,
+      TEMPORARY, // A register that is emptied when it is read.
+      REGISTER,  // A register that is read more than once: the state of a loop, or the control of a select.
+      ARGUMENT,
+      LOCAL,
+      CAPTURE,
+      GLOBAL
+    };
+
+   const uint32_t KIND_SHIFT = 28U;
+   const uint32_t INDEX_MASK = (1U << KIND_SHIFT) - 1U;
+   const uint32_t NO_OPERAND = 0xFFFFFFFFU;
+   const uint32_t NO_TOKEN = 0U; // tokens[0] is never used.
+
+   inline uint32_t makeOperand (OperandKind kind, size_t index)
+    {
+      return (static_cast<uint32_t>(kind) << KIND_SHIFT) | static_cast<uint32_t>(index);
+    }
+
+   inline OperandKind kindOf (uint32_t operand)
+    {
+      return static_cast<OperandKind>(operand >> KIND_SHIFT);
+    }
+
+   inline size_t indexOf (uint32_t operand)
+    {
+      return operand & INDEX_MASK;
+    }
+
+ }
+
+
+   class Compiled::Builder final
+    {
+   public:
+      Compiled& out;
+      bool possible; // Set false by anything the machine can't do.
+      size_t height; // The registers in use.
+      std::vector<size_t> labels;
+
+      class Loop final
+       {
+      public:
+         size_t id;
+         size_t base;  // Its registers.
+         size_t count;
+         uint32_t next; // Where continue goes.
+         uint32_t done; // Where break goes: after its registers are dropped.
+       };
+      std::vector<Loop> loops;
+
+         // Locals that have been set on every path to here: reading them can't fail.
+      std::set<size_t> known;
+
+      explicit Builder(Compiled& out) : out(out), possible(true), height(0U) { }
+
+      uint32_t label();
+      void place(uint32_t);
+      uint32_t token(const Input::Token&);
+      void append(OpCode, uint32_t dest, uint32_t a, uint32_t b, uint32_t token, uint32_t guard);
+      void drop(size_t from, size_t to);
+
+      uint32_t temporary();
+      void release(uint32_t);
+      uint32_t variable(const Getter&) const;
+      uint32_t variable(const Setter&) const;
+      bool quiet(const Expression&) const;
+      uint32_t pin(uint32_t, bool later);
+
+      uint32_t value(const Expression*, uint32_t guard);
+      void into(const Expression*, uint32_t dest, uint32_t guard);
+      void call(const FunctionCall*, uint32_t dest, uint32_t guard);
+      void branch(const Expression*, bool sense, uint32_t target, uint32_t test, uint32_t guard);
+
+      void statement(const Statement*);
+      void select(const SelectStatement*);
+      void loop(const ForStatement*);
+      void jump(const FlowControlStatement*);
+
+      void finish();
+    };
+
+   uint32_t Compiled::Builder::label()
+    {
+      labels.push_back(0U);
+      return static_cast<uint32_t>(labels.size() - 1U);
+    }
+
+   void Compiled::Builder::place(uint32_t label)
+    {
+      labels[label] = out.code.size();
+    }
+
+   uint32_t Compiled::Builder::token(const Input::Token& source)
+    {
+      out.tokens.push_back(&source);
+      return static_cast<uint32_t>(out.tokens.size() - 1U);
+    }
+
+   void Compiled::Builder::append(OpCode op, uint32_t dest, uint32_t a, uint32_t b, uint32_t token, uint32_t guard)
+    {
+      out.code.push_back(Instruction { op, dest, a, b, token, guard });
+    }
+
+   void Compiled::Builder::drop(size_t from, size_t to)
+    {
+      if (from < to)
+       {
+         append(DROP, 0U, static_cast<uint32_t>(from), static_cast<uint32_t>(to - from), NO_TOKEN, NO_TOKEN);
+       }
+    }
+
+   uint32_t Compiled::Builder::temporary()
+    {
+      uint32_t result = makeOperand(TEMPORARY, height);
+      ++height;
+      if (height > out.registers)
+       {
+         out.registers = height;
+       }
+      return result;
+    }
+
+   void Compiled::Builder::release(uint32_t operand)
+    {
+      if (TEMPORARY == kindOf(operand))
+       {
+         --height;
+       }
+    }
+
+   uint32_t Compiled::Builder::variable(const Getter& getter) const
+    {
+      const std::type_info& type = typeid(getter);
+      if (typeid(ArgGetter) == type)
+       {
+         return makeOperand(ARGUMENT, static_cast<const ArgGetter&>(getter).location);
+       }
+      else if (typeid(LocalGetter) == type)
+       {
+         return makeOperand(LOCAL, static_cast<const LocalGetter&>(getter).location);
+       }
+      else if (typeid(CaptureGetter) == type)
+       {
+         return makeOperand(CAPTURE, static_cast<const CaptureGetter&>(getter).location);
+       }
+      else if (typeid(GlobalGetter) == type)
+       {
+         return makeOperand(GLOBAL, static_cast<const GlobalGetter&>(getter).location);
+       }
+      return NO_OPERAND;
+    }
+
+   uint32_t Compiled::Builder::variable(const Setter& setter) const
+    {
+      const std::type_info& type = typeid(setter);
+      if (typeid(ArgSetter) == type)
+       {
+         return makeOperand(ARGUMENT, static_cast<const ArgSetter&>(setter).location);
+       }
+      else if (typeid(LocalSetter) == type)
+       {
+         return makeOperand(LOCAL, static_cast<const LocalSetter&>(setter).location);
+       }
+      else if (typeid(CaptureSetter) == type)
+       {
+         return makeOperand(CAPTURE, static_cast<const CaptureSetter&>(setter).location);
+       }
+      else if (typeid(GlobalSetter) == type)
+       {
+         return makeOperand(GLOBAL, static_cast<const GlobalSetter&>(setter).location);
+       }
+      return NO_OPERAND;
+    }
+
+      // Can evaluating this fail or do anything? If not, it doesn't matter when it is evaluated.
+   bool Compiled::Builder::quiet(const Expression& expr) const
+    {
+      if (typeid(Constant) == typeid(expr))
+       {
+         return true;
+       }
+      if (typeid(Variable) == typeid(expr))
+       {
+         uint32_t operand = variable(*static_cast<const Variable&>(expr).getter);
+         switch (kindOf(operand))
+          {
+         case ARGUMENT:
+         case CAPTURE:
+            return true;
+         case LOCAL:
+            return known.end() != known.find(indexOf(operand));
+         default:
+            return false;
+          }
+       }
+      return false;
+    }
+
+      // Operands are read when the instruction runs, not when the tree would have evaluated them.
+      // If what is evaluated in between could fail or change a global, read the variable now.
+   uint32_t Compiled::Builder::pin(uint32_t operand, bool later)
+    {
+      OperandKind kind = kindOf(operand);
+      if ((true == later) && ((GLOBAL == kind) || ((LOCAL == kind) && (known.end() == known.find(indexOf(operand))))))
+       {
+         uint32_t result = temporary();
+         append(MOVE, result, operand, 0U, NO_TOKEN, NO_TOKEN);
+         return result;
+       }
+      return operand;
+    }
+
+   uint32_t Compiled::Builder::value(const Expression* expr, uint32_t guard)
+    {
+      const std::type_info& type = typeid(*expr);
+      if (typeid(Constant) == type)
+       {
+         out.constants.push_back(static_cast<const Constant*>(expr)->value);
+         return makeOperand(CONSTANT, out.constants.size() - 1U);
+       }
+      if (typeid(Variable) == type)
+       {
+         uint32_t operand = variable(*static_cast<const Variable*>(expr)->getter);
+         if (NO_OPERAND != operand)
+          {
+            return operand;
+          }
+       }
+      uint32_t result = temporary();
+      into(expr, result, guard);
+      return result;
+    }
+
+   void Compiled::Builder::into(const Expression* expr, uint32_t dest, uint32_t guard)
+    {
+      const std::type_info& type = typeid(*expr);
+      if ((typeid(Constant) == type) || ((typeid(Variable) == type) && (NO_OPERAND != variable(*static_cast<const Variable*>(expr)->getter))))
+       {
+         append(MOVE, dest, value(expr, guard), 0U, NO_TOKEN, guard);
+       }
+#define COMPILE_BINARY(x, y) \
+      else if (typeid(x) == type) \
+       { \
+         const x* node = static_cast<const x*>(expr); \
+         uint32_t lhs = pin(value(node->lhs.get(), guard), !quiet(*node->rhs)); \
+         uint32_t rhs = value(node->rhs.get(), guard); \
+         release(rhs); \
+         release(lhs); \
+         append(y, dest, lhs, rhs, token(node->token), guard); \
+       }
+      COMPILE_BINARY(Plus, ADD)
+      COMPILE_BINARY(Minus, SUB)
+      COMPILE_BINARY(Multiply, MUL)
+      COMPILE_BINARY(Divide, DIV)
+      COMPILE_BINARY(Equals, EQ)
+      COMPILE_BINARY(NotEqual, NE)
+      COMPILE_BINARY(Greater, GT)
+      COMPILE_BINARY(Less, LT)
+      COMPILE_BINARY(GEQ, GE)
+      COMPILE_BINARY(LEQ, LE)
+      COMPILE_BINARY(DerefVar, INDEX)
+#undef COMPILE_BINARY
+#define COMPILE_UNARY(x, y) \
+      else if (typeid(x) == type) \
+       { \
+         const x* node = static_cast<const x*>(expr); \
+         uint32_t arg = value(node->arg.get(), guard); \
+         release(arg); \
+         append(y, dest, arg, 0U, token(node->token), guard); \
+       }
+      COMPILE_UNARY(Negate, NEG)
+      COMPILE_UNARY(Not, NOT)
+#undef COMPILE_UNARY
+#define COMPILE_SHORT(x, y) \
+      else if (typeid(x) == type) \
+       { \
+         const x* node = static_cast<const x*>(expr); \
+         uint32_t test = token(node->token); \
+         uint32_t shorted = label(); \
+         uint32_t end = label(); \
+         branch(node->lhs.get(), y, shorted, test, guard); \
+         uint32_t rhs = value(node->rhs.get(), guard); \
+         release(rhs); \
+         append(TRUTH, dest, rhs, 0U, test, guard); \
+         append(JUMP, end, 0U, 0U, NO_TOKEN, NO_TOKEN); \
+         place(shorted); \
+         append(BOOL, dest, y, 0U, NO_TOKEN, NO_TOKEN); \
+         place(end); \
+       }
+      COMPILE_SHORT(ShortAnd, false)
+      COMPILE_SHORT(ShortOr, true)
+#undef COMPILE_SHORT
+      else if (typeid(TernaryOperation) == type)
+       {
+         const TernaryOperation* node = static_cast<const TernaryOperation*>(expr);
+         uint32_t elseCase = label();
+         uint32_t end = label();
+         branch(node->condition.get(), false, elseCase, token(node->token), guard);
+         into(node->thenCase.get(), dest, guard);
+         append(JUMP, end, 0U, 0U, NO_TOKEN, NO_TOKEN);
+         place(elseCase);
+         into(node->elseCase.get(), dest, guard);
+         place(end);
+       }
+      else if (typeid(FunctionCall) == type)
+       {
+         call(static_cast<const FunctionCall*>(expr), dest, guard);
+       }
+      else
+       {
+         out.expressions.push_back(expr);
+         append(EVAL, dest, static_cast<uint32_t>(out.expressions.size() - 1U), 0U, NO_TOKEN, guard);
+       }
+    }
+
+   void Compiled::Builder::call(const FunctionCall* node, uint32_t dest, uint32_t guard)
+    {
+      bool quietArgs = true;
+      for (const std::shared_ptr<Expression>& arg : node->args)
+       {
+         quietArgs = quietArgs && quiet(*arg);
+       }
+
+      uint32_t location = pin(value(node->location.get(), guard), !quietArgs);
+      size_t site = out.calls.size();
+      out.calls.push_back(Call { node, 0U });
+      if (false == quietArgs)
+       {
+            // The tree checks the function before it evaluates the arguments.
+         append(CHECK, 0U, location, static_cast<uint32_t>(site), NO_TOKEN, guard);
+       }
+
+      std::vector<uint32_t> args;
+      for (size_t i = 0U; i < node->args.size(); ++i)
+       {
+         bool later = false;
+         for (size_t j = i + 1U; j < node->args.size(); ++j)
+          {
+            later = later || !quiet(*node->args[j]);
+          }
+         args.push_back(pin(value(node->args[i].get(), guard), later));
+       }
+      for (std::vector<uint32_t>::const_reverse_iterator iter = args.rbegin(); args.rend() != iter; ++iter)
+       {
+         release(*iter);
+       }
+      release(location);
+         // After the arguments' own calls have put their arguments in.
+      out.calls[site].args = out.arguments.size();
+      out.arguments.insert(out.arguments.end(), args.begin(), args.end());
+      append(CALL, dest, location, static_cast<uint32_t>(site), NO_TOKEN, guard);
+    }
+
+      // Jump to target if expr is sense. Comparisons jump on their result, rather than making a number to test.
+      // test is the token of the operator that takes the truth of a value, if there is one: it adds to the message.
+   void Compiled::Builder::branch(const Expression* expr, bool sense, uint32_t target, uint32_t test, uint32_t guard)
+    {
+      const std::type_info& type = typeid(*expr);
+      if (typeid(Not) == type)
+       {
+         const Not* node = static_cast<const Not*>(expr);
+         branch(node->arg.get(), !sense, target, token(node->token), guard);
+       }
+#define COMPILE_RELATION(x, y) \
+      else if (typeid(x) == type) \
+       { \
+         const x* node = static_cast<const x*>(expr); \
+         uint32_t lhs = pin(value(node->lhs.get(), guard), !quiet(*node->rhs)); \
+         uint32_t rhs = value(node->rhs.get(), guard); \
+         release(rhs); \
+         release(lhs); \
+         append(sense ? JT_##y : JF_##y, target, lhs, rhs, token(node->token), guard); \
+       }
+      COMPILE_RELATION(Equals, EQ)
+      COMPILE_RELATION(NotEqual, NE)
+      COMPILE_RELATION(Greater, GT)
+      COMPILE_RELATION(Less, LT)
+      COMPILE_RELATION(GEQ, GE)
+      COMPILE_RELATION(LEQ, LE)
+#undef COMPILE_RELATION
+         // x & y jumps if false when either is false; if true when both are. | is the other way around.
+#define COMPILE_SHORT(x, y) \
+      else if (typeid(x) == type) \
+       { \
+         const x* node = static_cast<const x*>(expr); \
+         uint32_t test = token(node->token); \
+         if (y == sense) \
+          { \
+            branch(node->lhs.get(), y, target, test, guard); \
+            branch(node->rhs.get(), y, target, test, guard); \
+          } \
+         else \
+          { \
+            uint32_t shorted = label(); \
+            branch(node->lhs.get(), y, shorted, test, guard); \
+            branch(node->rhs.get(), sense, target, test, guard); \
+            place(shorted); \
+          } \
+       }
+      COMPILE_SHORT(ShortAnd, false)
+      COMPILE_SHORT(ShortOr, true)
+#undef COMPILE_SHORT
+      else
+       {
+         uint32_t operand = value(expr, guard);
+         release(operand);
+         append(sense ? JT : JF, target, operand, 0U, test, guard);
+       }
+    }
+
+   void Compiled::Builder::statement(const Statement* stmt)
+    {
+      const std::type_info& type = typeid(*stmt);
+      if (typeid(NOP) == type)
+       {
+       }
+      else if (typeid(StatementSeq) == type)
+       {
+         for (const std::shared_ptr<Statement>& next : static_cast<const StatementSeq*>(stmt)->statements)
+          {
+            statement(next.get());
+          }
+       }
+      else if (typeid(Expr) == type)
+       {
+         uint32_t result = temporary();
+         into(static_cast<const Expr*>(stmt)->expr.get(), result, NO_TOKEN);
+         release(result);
+         drop(indexOf(result), indexOf(result) + 1U);
+       }
+      else if (typeid(Assignment) == type)
+       {
+         const Assignment* node = static_cast<const Assignment*>(stmt);
+         uint32_t dest = variable(*node->setter);
+         if ((nullptr != node->update) || (nullptr != node->index.get()) || (NO_OPERAND == dest))
+          {
+            out.statements.push_back(stmt);
+            append(EXEC, 0U, static_cast<uint32_t>(out.statements.size() - 1U), 0U, NO_TOKEN, NO_TOKEN);
+          }
+         else
+          {
+            into(node->rhs.get(), dest, NO_TOKEN);
+          }
+         if (LOCAL == kindOf(dest))
+          {
+            known.insert(indexOf(dest));
+          }
+       }
+      else if (typeid(IfStatement) == type)
+       {
+         const IfStatement* node = static_cast<const IfStatement*>(stmt);
+         uint32_t elseSeq = label();
+         uint32_t end = label();
+         branch(node->condition.get(), false, elseSeq, NO_TOKEN, token(node->token));
+         std::set<size_t> before = known;
+         statement(node->thenSeq.get());
+         known = before;
+         append(JUMP, end, 0U, 0U, NO_TOKEN, NO_TOKEN);
+         place(elseSeq);
+         statement(node->elseSeq.get());
+         known = before;
+         place(end);
+       }
+      else if (typeid(WhileStatement) == type)
+       {
+         const WhileStatement* node = static_cast<const WhileStatement*>(stmt);
+         Loop loop { node->id, height, 0U, label(), label() };
+         place(loop.next);
+         branch(node->condition.get(), false, loop.done, NO_TOKEN, token(node->token));
+         loops.push_back(loop);
+         std::set<size_t> before = known;
+         statement(node->seq.get());
+         known = before;
+         loops.pop_back();
+         append(JUMP, loop.next, 0U, 0U, NO_TOKEN, NO_TOKEN);
+         place(loop.done);
+       }
+      else if (typeid(SelectStatement) == type)
+       {
+         select(static_cast<const SelectStatement*>(stmt));
+       }
+      else if (typeid(ForStatement) == type)
+       {
+         loop(static_cast<const ForStatement*>(stmt));
+       }
+      else if (typeid(FlowControlStatement) == type)
+       {
+         jump(static_cast<const FlowControlStatement*>(stmt));
+       }
+      else
+       {
+         possible = false;
+       }
+    }
+
+   void Compiled::Builder::select(const SelectStatement* node)
+    {
+         // Keep the control in a register: the cases could change a global, and it is read by every case.
+      uint32_t control = value(node->control.get(), NO_TOKEN);
+      OperandKind kind = kindOf(control);
+      if ((LOCAL == kind) || (GLOBAL == kind))
+       {
+         uint32_t result = temporary();
+         append(MOVE, result, control, 0U, NO_TOKEN, NO_TOKEN);
+         control = result;
+       }
+      bool held = TEMPORARY == kindOf(control);
+      uint32_t reading = held ? makeOperand(REGISTER, indexOf(control)) : control;
+
+      uint32_t end = label();
+      std::vector<uint32_t> bodies;
+      for (const std::shared_ptr<CaseContainer>& next : node->cases)
+       {
+         uint32_t body = label();
+         bodies.push_back(body);
+         uint32_t guard = token(next->token);
+         if (nullptr == next->condition.get())
+          {
+            append(JUMP, body, 0U, 0U, NO_TOKEN, NO_TOKEN);
+          }
+         else if (nullptr == next->lower.get())
+          {
+            uint32_t condition = value(next->condition.get(), guard);
+            release(condition);
+            switch (next->type)
+             {
+            case CaseContainer::AT:
+               append(JT_EQ, body, condition, reading, NO_TOKEN, guard);
+               break;
+            case CaseContainer::ABOVE: // The condition is inverted, as it is in the tree.
+               append(JT_LE, body, condition, reading, NO_TOKEN, guard);
+               break;
+            case CaseContainer::BELOW:
+               append(JT_GE, body, condition, reading, NO_TOKEN, guard);
+               break;
+             }
+          }
+         else
+          {
+            uint32_t skip = label();
+            uint32_t top = pin(value(next->condition.get(), guard), !quiet(*next->lower));
+            uint32_t bottom = value(next->lower.get(), guard);
+            release(bottom);
+            append(JF_LE, skip, bottom, reading, NO_TOKEN, guard);
+            release(top);
+            append(JT_GE, body, top, reading, NO_TOKEN, guard);
+            place(skip);
+            if (TEMPORARY == kindOf(top))
+             {
+               drop(indexOf(top), indexOf(top) + 1U);
+             }
+          }
+       }
+      release(control);
+      if (true == held)
+       {
+         drop(indexOf(control), indexOf(control) + 1U);
+       }
+      append(JUMP, end, 0U, 0U, NO_TOKEN, NO_TOKEN);
+
+         // Run into the next case, unless it breaks.
+      for (size_t i = 0U; i < node->cases.size(); ++i)
+       {
+         place(bodies[i]);
+         if (true == held)
+          {
+            drop(indexOf(control), indexOf(control) + 1U);
+          }
+         std::set<size_t> before = known;
+         statement(node->cases[i]->seq.get());
+         known = before;
+         if ((i + 1U < node->cases.size()) && (true == node->cases[i + 1U]->breaking))
+          {
+            append(JUMP, end, 0U, 0U, NO_TOKEN, NO_TOKEN);
+          }
+       }
+      place(end);
+    }
+
+   void Compiled::Builder::loop(const ForStatement* node)
+    {
+      uint32_t lcv = variable(*node->setter);
+      if (NO_OPERAND == lcv)
+       {
+         possible = false;
+         return;
+       }
+
+         // The loop's state is in registers: the body can change the variable without changing the loop.
+      Loop loop { node->id, height, 0U, label(), label() };
+      uint32_t current = makeOperand(REGISTER, loop.base);
+      into(node->lower.get(), temporary(), NO_TOKEN);
+      uint32_t exit = label();
+      uint32_t top = label();
+      uint32_t guard = token(node->token);
+      if (nullptr == node->upper.get())
+       {
+         loop.count = 1U;
+         append(ITER, current, current, 0U, guard, NO_TOKEN);
+         place(top);
+         place(loop.next);
+         append(NEXT, exit, current, lcv, NO_TOKEN, NO_TOKEN);
+       }
+      else
+       {
+         loop.count = 3U;
+         into(node->upper.get(), temporary(), NO_TOKEN);
+         uint32_t step = temporary();
+         if (nullptr == node->step.get())
+          {
+            append(STEP, step, node->to ? 1U : 0U, 0U, NO_TOKEN, NO_TOKEN);
+          }
+         else
+          {
+            into(node->step.get(), step, NO_TOKEN);
+          }
+         place(top);
+         append(MOVE, lcv, current, 0U, NO_TOKEN, NO_TOKEN);
+            // The tree makes a comparison with the for's token, and then adds the for's token to its message.
+         append(node->to ? JF_LE : JF_GE, exit, current, makeOperand(REGISTER, loop.base + 1U), guard, guard);
+       }
+
+      loops.push_back(loop);
+      std::set<size_t> before = known;
+      if (LOCAL == kindOf(lcv))
+       {
+         known.insert(indexOf(lcv));
+       }
+      statement(node->seq.get());
+      known = before;
+      loops.pop_back();
+
+      if (nullptr != node->upper.get())
+       {
+         place(loop.next);
+         append(INC, current, lcv, makeOperand(REGISTER, loop.base + 2U), guard, NO_TOKEN);
+       }
+      append(JUMP, top, 0U, 0U, NO_TOKEN, NO_TOKEN);
+      place(exit);
+      height = loop.base;
+      drop(loop.base, loop.base + loop.count);
+      place(loop.done);
+    }
+
+   void Compiled::Builder::jump(const FlowControlStatement* node)
+    {
+      if (FlowControl::RETURN == node->type)
+       {
+         uint32_t result = value(node->value.get(), token(node->token));
+         release(result);
+         append(RET, 0U, result, 0U, NO_TOKEN, NO_TOKEN);
+         return;
+       }
+
+      std::vector<Loop>::const_reverse_iterator target = loops.rbegin();
+      while ((loops.rend() != target) && (node->target != target->id))
+       {
+         ++target;
+       }
+      if (loops.rend() == target)
+       {
+            // Leaves the function: the tree reports it.
+         possible = false;
+       }
+      else if (FlowControl::BREAK == node->type)
+       {
+         drop(target->base, height);
+         append(JUMP, target->done, 0U, 0U, NO_TOKEN, NO_TOKEN);
+       }
+      else
+       {
+         drop(target->base + target->count, height);
+         append(JUMP, target->next, 0U, 0U, NO_TOKEN, NO_TOKEN);
+       }
+    }
+
+   void Compiled::Builder::finish()
+    {
+      append(END, 0U, 0U, 0U, NO_TOKEN, NO_TOKEN);
+      for (Instruction& next : out.code)
+       {
+         if (((next.op >= JUMP) && (next.op <= JF_LE)) || (NEXT == next.op))
+          {
+            next.dest = static_cast<uint32_t>(labels[next.dest]);
+          }
+       }
+    }
+
+
+namespace
+ {
+
+      // Where the operands are, for one call.
+   class Registers final
+    {
+   public:
+      std::shared_ptr<Types::ValueType>* temps;
+      const std::vector<std::shared_ptr<Types::ValueType> >& constants;
+      CallingContext& context;
+      StackFrame& frame;
+
+      Registers(std::shared_ptr<Types::ValueType>* temps, const std::vector<std::shared_ptr<Types::ValueType> >& constants, CallingContext& context) :
+         temps(temps), constants(constants), context(context), frame(*context.currentFrame)
+       {
+       }
+
+      static const std::shared_ptr<Types::ValueType>& check (const std::shared_ptr<Types::ValueType>& value)
+       {
+         if (nullptr == value.get())
+          {
+            throw FatalException("Read of value before set.");
+          }
+         return value;
+       }
+
+      const std::shared_ptr<Types::ValueType>& get (uint32_t from) const
+       {
+         switch (kindOf(from))
+          {
+         case CONSTANT:
+            return constants[indexOf(from)];
+         case ARGUMENT:
+            return frame.args[indexOf(from)];
+         case LOCAL:
+            return check(frame.locals[indexOf(from)]);
+         case CAPTURE:
+            return frame.captures[indexOf(from)];
+         case GLOBAL:
+            return check(context.globalScope->vars[indexOf(from)]);
+         default:
+            return temps[indexOf(from)];
+          }
+       }
+
+      std::shared_ptr<Types::ValueType> take (uint32_t from)
+       {
+         if (TEMPORARY == kindOf(from))
+          {
+            return std::move(temps[indexOf(from)]);
+          }
+         return get(from);
+       }
+
+      void done (uint32_t from)
+       {
+         if (TEMPORARY == kindOf(from))
+          {
+            temps[indexOf(from)].reset();
+          }
+       }
+
+      void put (uint32_t to, std::shared_ptr<Types::ValueType>&& value)
+       {
+         switch (kindOf(to))
+          {
+         case ARGUMENT:
+            frame.args[indexOf(to)] = std::move(value);
+            break;
+         case LOCAL:
+            frame.locals[indexOf(to)] = std::move(value);
+            break;
+         case CAPTURE:
+            frame.captures[indexOf(to)] = std::move(value);
+            break;
+         case GLOBAL:
+            context.writeShared();
+            context.globalScope->vars[indexOf(to)] = std::move(value);
+            break;
+         default:
+            temps[indexOf(to)] = std::move(value);
+            break;
+          }
+       }
+    };
+
+ }
+
+
+   Compiled::Compiled(const std::shared_ptr<Statement>& tree) : Statement(tree->token), tree(tree), tokens(1U, nullptr), registers(0U)
+    {
+    }
+
+   std::shared_ptr<Statement> Compiled::compile(const std::shared_ptr<Statement>& tree)
+    {
+      if (typeid(Compiled) == typeid(*tree))
+       {
+         return tree;
+       }
+
+      std::shared_ptr<Compiled> result = std::make_shared<Compiled>(tree);
+      Builder builder (*result);
+      builder.statement(tree.get());
+      if (false == builder.possible)
+       {
+         return tree;
+       }
+      builder.finish();
+      return result;
+    }
+
+   FlowControl Compiled::execute (CallingContext& context) const
+    {
+      std::shared_ptr<Types::ValueType> result;
+      if (true == run(context, result))
+       {
+         return FlowControl(token, FlowControl::RETURN, FlowControl::NO_TARGET, result);
+       }
+      return FlowControl();
+    }
+
+   static std::shared_ptr<Types::ValueType> truth (bool value)
+    {
+      return (true == value) ? Expression::FLOAT_ONE() : Expression::FLOAT_ZERO();
+    }
+
+   bool Compiled::run (CallingContext& context, std::shared_ptr<Types::ValueType>& result) const
+    {
+         // Most functions need only a few registers: don't allocate them.
+      static const size_t SMALL = 8U;
+      std::shared_ptr<Types::ValueType> localTemps [SMALL];
+      size_t localCounters [SMALL];
+      std::vector<std::shared_ptr<Types::ValueType> > largeTemps;
+      std::vector<size_t> largeCounters;
+      std::shared_ptr<Types::ValueType>* temps = localTemps;
+      size_t* counters = localCounters;
+      if (registers > SMALL)
+       {
+         largeTemps.resize(registers);
+         largeCounters.resize(registers);
+         temps = largeTemps.data();
+         counters = largeCounters.data();
+       }
+      Registers R (temps, constants, context);
+
+      size_t pc = 0U;
+      try
+       {
+         for (;;)
+          {
+            const Instruction& next = code[pc];
+            ++pc;
+            switch (next.op)
+             {
+            case MOVE:
+               R.put(next.dest, R.take(next.a));
+               break;
+#define RUN_BINARY(x, y) \
+            case x: \
+             { \
+               std::shared_ptr<Types::ValueType> value = R.get(next.a)->y(*R.get(next.b)); \
+               R.done(next.a); \
+               R.done(next.b); \
+               R.put(next.dest, std::move(value)); \
+             } \
+               break;
+            RUN_BINARY(ADD, add)
+            RUN_BINARY(SUB, sub)
+            RUN_BINARY(MUL, mul)
+            RUN_BINARY(DIV, div)
+#undef RUN_BINARY
+#define RUN_RELATION(x, y) \
+            case x: \
+             { \
+               bool value = R.get(next.a)->y(*R.get(next.b)); \
+               R.done(next.a); \
+               R.done(next.b); \
+               R.put(next.dest, truth(value)); \
+             } \
+               break;
+            RUN_RELATION(EQ, equal)
+            RUN_RELATION(NE, notEqual)
+            RUN_RELATION(GT, greater)
+            RUN_RELATION(LT, less)
+            RUN_RELATION(GE, geq)
+            RUN_RELATION(LE, leq)
+#undef RUN_RELATION
+            // Numbers are compared here, as a for loop does: the rest go through the values.
+#define RUN_JUMP(x, y, w, z) \
+            case x: \
+             { \
+               const Types::ValueType& lhs = *R.get(next.a); \
+               const Types::ValueType& rhs = *R.get(next.b); \
+               bool value; \
+               if ((typeid(Types::FloatValue) == typeid(lhs)) && (typeid(Types::FloatValue) == typeid(rhs))) \
+                { \
+                  value = static_cast<const Types::FloatValue&>(lhs).value->w(*static_cast<const Types::FloatValue&>(rhs).value); \
+                } \
+               else \
+                { \
+                  value = lhs.y(rhs); \
+                } \
+               R.done(next.a); \
+               R.done(next.b); \
+               if (z == value) \
+                { \
+                  pc = next.dest; \
+                } \
+             } \
+               break;
+            RUN_JUMP(JT_EQ, equal, equal, true)
+            RUN_JUMP(JT_NE, notEqual, not_equal_to, true)
+            RUN_JUMP(JT_GT, greater, greater, true)
+            RUN_JUMP(JT_LT, less, less, true)
+            RUN_JUMP(JT_GE, geq, greater_equal, true)
+            RUN_JUMP(JT_LE, leq, less_equal, true)
+            RUN_JUMP(JF_EQ, equal, equal, false)
+            RUN_JUMP(JF_NE, notEqual, not_equal_to, false)
+            RUN_JUMP(JF_GT, greater, greater, false)
+            RUN_JUMP(JF_LT, less, less, false)
+            RUN_JUMP(JF_GE, geq, greater_equal, false)
+            RUN_JUMP(JF_LE, leq, less_equal, false)
+#undef RUN_JUMP
+            case NEG:
+             {
+               std::shared_ptr<Types::ValueType> value = R.get(next.a)->neg();
+               R.done(next.a);
+               R.put(next.dest, std::move(value));
+             }
+               break;
+            case NOT:
+             {
+               bool value = R.get(next.a)->logical();
+               R.done(next.a);
+               R.put(next.dest, truth(!value));
+             }
+               break;
+            case TRUTH:
+             {
+               bool value = R.get(next.a)->logical();
+               R.done(next.a);
+               R.put(next.dest, truth(value));
+             }
+               break;
+            case BOOL:
+               R.put(next.dest, truth(0U != next.a));
+               break;
+            case STEP:
+               if (0U != next.a)
+                {
+                  R.put(next.dest, Expression::FLOAT_ONE());
+                }
+               else
+                {
+                  R.put(next.dest, std::make_shared<Types::FloatValue>(-*NumberSystem::getCurrentNumberSystem().FLOAT_ONE));
+                }
+               break;
+            case INC:
+             {
+               std::shared_ptr<Types::ValueType>& current = temps[indexOf(next.dest)];
+               const std::shared_ptr<Types::ValueType>& step = R.get(next.b);
+               if ((typeid(Types::FloatValue) == typeid(*current)) && (typeid(Types::FloatValue) == typeid(*step)))
+                {
+                  bool unshared = (1 == current.use_count()) || ((2 == current.use_count()) && (current.get() == R.get(next.a).get()));
+                  ForStatement::advance(current, static_cast<const Types::FloatValue&>(*step), unshared);
+                }
+               else
+                {
+                  current = current->add(*step);
+                }
+             }
+               break;
+            case INDEX:
+             {
+               const std::shared_ptr<Types::ValueType>& lhs = R.get(next.a);
+               std::shared_ptr<Types::ValueType> value;
+               if ((typeid(Types::ArrayValue) == typeid(*lhs)) || (typeid(Types::CellRangeValue) == typeid(*lhs)))
+                {
+                  value = GetIndex(lhs, R.get(next.b));
+                }
+               else if (typeid(Types::DictionaryValue) == typeid(*lhs))
+                {
+                  value = GetValue(lhs, R.get(next.b));
+                }
+               else
+                {
+                  throw Types::TypedOperationException("Error indexing non-Collection.");
+                }
+               R.done(next.a);
+               R.done(next.b);
+               R.put(next.dest, std::move(value));
+             }
+               break;
+            case EVAL:
+               R.put(next.dest, expressions[next.a]->evaluate(context));
+               break;
+            case EXEC:
+               (void) statements[next.a]->execute(context);
+               break;
+            case CHECK:
+             {
+               std::shared_ptr<Types::FunctionValue> value;
+               (void) calls[next.b].node->getFunction(context, R.get(next.a), value);
+             }
+               break;
+            case CALL:
+             {
+               const Call& site = calls[next.b];
+               std::shared_ptr<Types::FunctionValue> value;
+               std::shared_ptr<FunctionContext> function = site.node->getFunction(context, R.get(next.a), value);
+               PooledFrame pooled (context, function, site.node->token);
+               StackFrame& frame = pooled.frame;
+               frame.captures = value->captures;
+               for (size_t i = 0U; i < frame.args.size(); ++i)
+                {
+                  frame.args[i] = R.take(arguments[site.args + i]);
+                }
+               R.done(next.a);
+               R.put(next.dest, site.node->call(context, frame));
+             }
+               break;
+            case JUMP:
+               pc = next.dest;
+               break;
+            case JT:
+            case JF:
+             {
+               bool value = R.get(next.a)->logical();
+               R.done(next.a);
+               if ((JT == next.op) == value)
+                {
+                  pc = next.dest;
+                }
+             }
+               break;
+            case ITER:
+             {
+               const std::shared_ptr<Types::ValueType>& collection = R.get(next.a);
+               if (typeid(Types::DictionaryValue) == typeid(*collection))
+                {
+                     // The tree makes the [key, value] pairs as it goes: make them all now, so that this is an array.
+                  std::shared_ptr<Types::ArrayValue> pairs = std::make_shared<Types::ArrayValue>();
+                  for (auto iter : static_cast<const Types::DictionaryValue&>(*collection).sorted())
+                   {
+                     std::shared_ptr<Types::ArrayValue> pair = std::make_shared<Types::ArrayValue>();
+                     pair->value.push_back(iter->first);
+                     pair->value.push_back(iter->second);
+                     pairs->value.push_back(pair);
+                   }
+                  R.put(next.dest, pairs);
+                }
+               else if ((typeid(Types::ArrayValue) != typeid(*collection)) && (typeid(Types::CellRangeValue) != typeid(*collection)))
+                {
+                  throw Types::TypedOperationException("Error iterating over non-Collection.");
+                }
+               counters[indexOf(next.dest)] = 0U;
+             }
+               break;
+            case NEXT:
+             {
+               const Types::ValueType& collection = *temps[indexOf(next.a)];
+               size_t& index = counters[indexOf(next.a)];
+               if (typeid(Types::ArrayValue) == typeid(collection))
+                {
+                  const Types::ArrayValue& array = static_cast<const Types::ArrayValue&>(collection);
+                  if (index < array.value.size())
+                   {
+                     R.put(next.b, std::shared_ptr<Types::ValueType>(array.value[index]));
+                     ++index;
+                   }
+                  else
+                   {
+                     pc = next.dest;
+                   }
+                }
+               else
+                {
+                  const Types::CellRangeValue& range = static_cast<const Types::CellRangeValue&>(collection);
+                  if (index < range.value->getSize())
+                   {
+                     R.put(next.b, range.value->getIndex(index));
+                     ++index;
+                   }
+                  else
+                   {
+                     pc = next.dest;
+                   }
+                }
+             }
+               break;
+            case DROP:
+               for (size_t i = next.a; i < next.a + next.b; ++i)
+                {
+                  temps[i].reset();
+                }
+               break;
+            case RET:
+               result = R.take(next.a);
+               return true;
+            case END:
+               return false;
+             }
+          }
+       }
+      catch (const Types::TypedOperationException& e)
+       {
+            // Say what failed where, as the tree does: first the operator, then the statement it is the condition of.
+         const Instruction& failed = code[pc - 1U];
+         if ((NO_TOKEN == failed.token) && (NO_TOKEN == failed.guard))
+          {
+            throw;
+          }
+         std::string msg = e.what();
+         if (NO_TOKEN != failed.token)
+          {
+            msg = Expression::constructMessage(e, *tokens[failed.token]);
+            if (nullptr != context.debugger)
+             {
+               context.debugger->EnterDebugger(msg, context);
+             }
+          }
+         if (NO_TOKEN != failed.guard)
+          {
+            msg = Expression::constructMessage(Types::TypedOperationException(msg), *tokens[failed.guard]);
+            if (nullptr != context.debugger)
+             {
+               context.debugger->EnterDebugger(msg, context);
+             }
+          }
+         throw Types::TypedOperationException(msg);
+       }
+    }
+
+ } // namespace Engine
+
+ } // namespace Backwards
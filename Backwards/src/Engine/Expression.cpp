@@ -321,7 +321,7 @@ namespace Engine
 
 
    StackFrame::StackFrame(std::shared_ptr<FunctionContext> function, const Input::Token& callingToken, StackFrame* prev) :
-      function(function), args(function->nargs), locals(function->nlocals), prev(prev), next(nullptr), callingToken(callingToken), depth(1U)
+      function(function), args(function->nargs), locals(function->nlocals), prev(prev), next(nullptr), callingToken(&callingToken), depth(1U)
     {
       if (nullptr != prev)
        {
@@ -329,6 +329,35 @@ namespace Engine
        }
     }
 
+   void StackFrame::enter(const std::shared_ptr<FunctionContext>& function, const Input::Token& callingToken, StackFrame* prev)
+    {
+      this->function = function;
+      args.resize(function->nargs);
+      locals.resize(function->nlocals);
+      this->prev = prev;
+      next = nullptr;
+      this->callingToken = &callingToken;
+      depth = (nullptr == prev) ? 1U : prev->depth + 1U;
+    }
+
+   void StackFrame::leave()
+    {
+      args.clear();
+      locals.clear();
+      captures.clear();
+      function.reset();
+    }
+
+   PooledFrame::PooledFrame(CallingContext& context, const std::shared_ptr<FunctionContext>& function, const Input::Token& callingToken) :
+      context(context), frame(context.newFrame(function, callingToken))
+    {
+    }
+
+   PooledFrame::~PooledFrame()
+    {
+      context.freeFrame();
+    }
+
 
    FunctionCall::FunctionCall(const Input::Token& token, const std::shared_ptr<Expression>& location, const std::vector<std::shared_ptr<Expression> >& args) :
       Expression(token), location(location), args(args)
@@ -337,9 +366,21 @@ namespace Engine
 
    std::shared_ptr<Types::ValueType> FunctionCall::evaluate (CallingContext& context) const
     {
-      /* We don't want to catch an exception generated while evaluating the arguments, */
-      /* just the one from performing this operation. */
-      std::shared_ptr<Types::ValueType> LOC = location->evaluate(context);
+      std::shared_ptr<Types::FunctionValue> LOC;
+      std::shared_ptr<FunctionContext> function = getFunction(context, LOC);
+      PooledFrame pooled (context, function, token);
+      evaluateArgs(context, pooled.frame, *LOC);
+      return call(context, pooled.frame);
+    }
+
+   std::shared_ptr<FunctionContext> FunctionCall::getFunction (CallingContext& context, std::shared_ptr<Types::FunctionValue>& value) const
+    {
+      return getFunction(context, location->evaluate(context), value);
+    }
+
+   std::shared_ptr<FunctionContext> FunctionCall::getFunction (CallingContext& context, const std::shared_ptr<Types::ValueType>& LOC,
+      std::shared_ptr<Types::FunctionValue>& value) const
+    {
       if (false == (typeid(Types::FunctionValue) == typeid(*LOC)))
        {
          std::stringstream str;
@@ -350,10 +391,11 @@ namespace Engine
           }
          throw FatalException(str.str());
        }
-      std::shared_ptr<FunctionContext> function = std::dynamic_pointer_cast<FunctionContext>((std::dynamic_pointer_cast<Types::FunctionValue>(LOC)->valueToo).lock());
+      value = std::static_pointer_cast<Types::FunctionValue>(LOC);
+      std::shared_ptr<FunctionContext> function = std::dynamic_pointer_cast<FunctionContext>(value->valueToo.lock());
       if (nullptr == function.get())
        {
-         function = std::dynamic_pointer_cast<FunctionContext>(std::dynamic_pointer_cast<Types::FunctionValue>(LOC)->value);
+         function = std::dynamic_pointer_cast<FunctionContext>(value->value);
        }
       if (args.size() != function->nargs)
        {
@@ -366,34 +408,44 @@ namespace Engine
           }
          throw FatalException(str.str());
        }
-      StackFrame frame (function, token, context.currentFrame);
-      frame.captures = std::dynamic_pointer_cast<Types::FunctionValue>(LOC)->captures;
+      return function;
+    }
+
+   void FunctionCall::evaluateArgs (CallingContext& context, StackFrame& frame, const Types::FunctionValue& value) const
+    {
+      frame.captures = value.captures;
       for (size_t i = 0U; i < args.size(); ++i)
        {
          frame.args[i] = args[i]->evaluate(context);
        }
+    }
+
+   std::shared_ptr<Types::ValueType> FunctionCall::call (CallingContext& context, StackFrame& frame) const
+    {
+      /* We don't want to catch an exception generated while evaluating the arguments, */
+      /* just the one from performing this operation. */
       /* Can't link the frames until here, as we may use the current frame to compute the args, */
       /* and/or push multiple other frames onto the stack. */
       context.pushContext(&frame);
       try
        {
-         std::shared_ptr<FlowControl> result;
+         FlowControl result;
          try
           {
-            result = function->function->execute(context);
+            result = frame.function->function->execute(context);
           }
          catch (const Types::TypedOperationException& e)
           {
             std::string msg = constructMessage(e);
             throw Types::TypedOperationException(msg);
           }
-         if (nullptr == result.get())
+         if (FlowControl::NONE == result.type)
           {
             std::stringstream str;
             str << "Function failed to return a value at " << token.lineLocation << " on line " << token.lineNumber << " in file " << token.sourceFile;
             throw FatalException(str.str());
           }
-         if (FlowControl::RETURN != result->type)
+         if (FlowControl::RETURN != result.type)
           {
             std::stringstream str;
             str << "Function had a 'break' or 'continue' outside of a loop at " << token.lineLocation << " on line " << token.lineNumber << " in file " << token.sourceFile;
@@ -404,7 +456,7 @@ namespace Engine
             throw FatalException(str.str());
           }
          context.popContext();
-         return result->value;
+         return result.value;
        }
       catch (...)
        {
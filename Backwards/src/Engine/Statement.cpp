@@ -33,17 +33,20 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "Backwards/Engine/Expression.h"
 #include "Backwards/Engine/StdLib.h"
 #include "Backwards/Engine/StackFrame.h"
+#include "Backwards/Engine/FunctionContext.h"
 
 #include "Backwards/Types/ArrayValue.h"
 #include "Backwards/Types/FloatValue.h"
 #include "Backwards/Types/DictionaryValue.h"
 #include "Backwards/Types/CellRangeValue.h"
+#include "Backwards/Types/FunctionValue.h"
 
 #include "Backwards/Engine/DebuggerHook.h"
 
 #include "NumberSystem.h"
 
 #include <sstream>
+#include <typeinfo>
 
 namespace Backwards
  {
@@ -51,7 +54,7 @@ namespace Backwards
 namespace Engine
  {
 
-   FlowControl::FlowControl(const Input::Token& source, Type type, size_t target, const std::shared_ptr<Types::ValueType>& value) : source(source), type(type), target(target), value(value)
+   FlowControl::FlowControl(const Input::Token& source, Type type, size_t target, const std::shared_ptr<Types::ValueType>& value) : source(&source), type(type), target(target), value(value)
     {
     }
 
@@ -66,9 +69,9 @@ namespace Engine
     {
     }
 
-   std::shared_ptr<FlowControl> NOP::execute (CallingContext&) const
+   FlowControl NOP::execute (CallingContext&) const
     {
-      return std::shared_ptr<FlowControl>();
+      return FlowControl();
     }
 
 
@@ -76,10 +79,10 @@ namespace Engine
     {
     }
 
-   std::shared_ptr<FlowControl> Expr::execute (CallingContext& context) const
+   FlowControl Expr::execute (CallingContext& context) const
     {
       (void) expr->evaluate(context);
-      return std::shared_ptr<FlowControl>();
+      return FlowControl();
     }
 
 
@@ -88,39 +91,56 @@ namespace Engine
     {
     }
 
-   std::shared_ptr<FlowControl> StatementSeq::execute (CallingContext& context) const
+   FlowControl StatementSeq::execute (CallingContext& context) const
     {
       for (std::vector<std::shared_ptr<Statement> >::const_iterator iter = statements.begin();
          statements.end() != iter; ++iter)
        {
-         std::shared_ptr<FlowControl> temp = (*iter)->execute(context);
-         if (nullptr != temp.get())
+         FlowControl temp = (*iter)->execute(context);
+         if (FlowControl::NONE != temp.type)
           {
             return temp;
           }
        }
-      return std::shared_ptr<FlowControl>();
+      return FlowControl();
     }
 
 
    RecAssignState::RecAssignState(const Input::Token& token, const std::shared_ptr<Expression>& index) :
       token(token), index(index)
     {
+    }
+
+      // Values are immutable, but one that only a variable has can be changed, as no one can see it change.
+      // Ask after evaluating everything else: evaluating the rhs could put the value somewhere else.
+   static bool isUnshared (CallingContext& context, const Getter& variable, const std::shared_ptr<Types::ValueType>& value)
+    {
+      return (1 == value.use_count()) || ((2 == value.use_count()) && (value.get() == variable.get(context).get()));
     }
 
    std::shared_ptr<Types::ValueType> RecAssignState::evaluate
-      (CallingContext& context, const std::shared_ptr<Types::ValueType>& lhs, const std::shared_ptr<Expression>& rhs) const
+      (CallingContext& context, const std::shared_ptr<Types::ValueType>& lhs, const std::shared_ptr<Expression>& rhs, const Getter* variable) const
     {
       std::shared_ptr<Types::ValueType> result;
       if (nullptr == next.get())
        {
-         result = setIndex(lhs, index->evaluate(context), rhs->evaluate(context), context);
+         std::shared_ptr<Types::ValueType> arrayIndex = index->evaluate(context);
+         std::shared_ptr<Types::ValueType> value = rhs->evaluate(context);
+         if ((nullptr != variable) && (true == isUnshared(context, *variable, lhs)) &&
+             ((true == SetIndexInPlace(*lhs, arrayIndex, value)) || (true == InsertInPlace(*lhs, arrayIndex, value))))
+          {
+            result = lhs;
+          }
+         else
+          {
+            result = setIndex(lhs, arrayIndex, value, context);
+          }
        }
       else
        {
          std::shared_ptr<Types::ValueType> arrayIndex = index->evaluate(context);
           {
-            result = setIndex(lhs, arrayIndex, next->evaluate(context, getIndex(lhs, arrayIndex, context), rhs), context);
+            result = setIndex(lhs, arrayIndex, next->evaluate(context, getIndex(lhs, arrayIndex, context), rhs, nullptr), context);
           }
        }
       return result;
@@ -191,21 +211,73 @@ namespace Engine
 
    Assignment::Assignment(const Input::Token& token, const std::shared_ptr<Getter>& getter, const std::shared_ptr<Setter>& setter,
       const std::shared_ptr<RecAssignState>& index, const std::shared_ptr<Expression>& rhs) :
-      Statement(token), getter(getter), setter(setter), index(index), rhs(rhs)
+      Statement(token), getter(getter), setter(setter), index(index), rhs(rhs), update(nullptr)
     {
+         // The location has to be a variable: we may evaluate it without calling what it names.
+      if ((nullptr == index.get()) && (nullptr != getter.get()) && (typeid(FunctionCall) == typeid(*rhs)))
+       {
+         const FunctionCall& call = static_cast<const FunctionCall&>(*rhs);
+         if ((false == call.args.empty()) && (typeid(Variable) == typeid(*call.location)) &&
+             (typeid(Variable) == typeid(*call.args[0U])) && (getter == static_cast<const Variable&>(*call.args[0U]).getter))
+          {
+            update = &call;
+          }
+       }
     }
 
-   std::shared_ptr<FlowControl> Assignment::execute (CallingContext& context) const
+      // Does what the standard function does, to its first argument. Returns false if it isn't one that we can do that for.
+   static bool updateInPlace (const Statement& function, const std::vector<std::shared_ptr<Types::ValueType> >& args)
     {
-      if (nullptr == index.get())
+      const std::type_info& type = typeid(function);
+      if (typeid(StandardUnaryFunction) == type)
+       {
+         UnaryFunctionPointer pointer = static_cast<const StandardUnaryFunction&>(function).function;
+         return (PopBack == pointer) && (true == PopBackInPlace(*args[0U]));
+       }
+      else if (typeid(StandardBinaryFunction) == type)
+       {
+         BinaryFunctionPointer pointer = static_cast<const StandardBinaryFunction&>(function).function;
+         return ((PushBack == pointer) && (true == PushBackInPlace(*args[0U], args[1U]))) ||
+            ((RemoveKey == pointer) && (true == RemoveKeyInPlace(*args[0U], args[1U])));
+       }
+      else if (typeid(StandardTernaryFunction) == type)
+       {
+         TernaryFunctionPointer pointer = static_cast<const StandardTernaryFunction&>(function).function;
+         return ((SetIndex == pointer) && (true == SetIndexInPlace(*args[0U], args[1U], args[2U]))) ||
+            ((Insert == pointer) && (true == InsertInPlace(*args[0U], args[1U], args[2U])));
+       }
+      return false;
+    }
+
+   FlowControl Assignment::execute (CallingContext& context) const
+    {
+      if (nullptr != update)
+       {
+            // "set a to PushBack(a; x)": evaluate the call as usual, but look at the arguments before calling.
+            // If no one else can see a, do the work to a itself, instead of to a copy that replaces it.
+         std::shared_ptr<Types::FunctionValue> LOC;
+         std::shared_ptr<FunctionContext> function = update->getFunction(context, LOC);
+         PooledFrame pooled (context, function, update->token);
+         StackFrame& frame = pooled.frame;
+         update->evaluateArgs(context, frame, *LOC);
+         if ((true == isUnshared(context, *getter, frame.args[0U])) && (true == updateInPlace(*function->function, frame.args)))
+          {
+            setter->set(context, frame.args[0U]);
+          }
+         else
+          {
+            setter->set(context, update->call(context, frame));
+          }
+       }
+      else if (nullptr == index.get())
        {
          setter->set(context, rhs->evaluate(context));
        }
       else
        {
-         setter->set(context, index->evaluate(context, getter->get(context), rhs));
+         setter->set(context, index->evaluate(context, getter->get(context), rhs, getter.get()));
        }
-      return std::shared_ptr<FlowControl>();
+      return FlowControl();
     }
 
 
@@ -215,7 +287,7 @@ namespace Engine
     {
     }
 
-   std::shared_ptr<FlowControl> IfStatement::execute (CallingContext& context) const
+   FlowControl IfStatement::execute (CallingContext& context) const
     {
       bool conditional = true;
       try
@@ -247,7 +319,7 @@ namespace Engine
     {
     }
 
-   std::shared_ptr<FlowControl> WhileStatement::execute (CallingContext& context) const
+   FlowControl WhileStatement::execute (CallingContext& context) const
     {
       bool conditional = true;
       try
@@ -265,30 +337,29 @@ namespace Engine
        }
       while (true == conditional)
        {
-         std::shared_ptr<FlowControl> temp = seq->execute(context);
+         FlowControl temp = seq->execute(context);
 
-         if (nullptr != temp.get())
+         switch (temp.type)
           {
-            switch (temp->type)
+         case FlowControl::NONE:
+            break;
+         case FlowControl::RETURN:
+            return temp; // Pass it up.
+         case FlowControl::BREAK:
+            if (id == temp.target)
              {
-            case FlowControl::RETURN:
-               return temp; // Pass it up.
-            case FlowControl::BREAK:
-               if (id == temp->target)
-                {
-                  return std::shared_ptr<FlowControl>(); // Loop is done.
-                }
-               else
-                {
-                  return temp; // Not for me, pass it up.
-                }
-            case FlowControl::CONTINUE:
-               if (id != temp->target)
-                {
-                  return temp; // Not for me, pass it up.
-                }
-               // Else do nothing: the previous iteration has stopped and we will move on to the next.
+               return FlowControl(); // Loop is done.
+             }
+            else
+             {
+               return temp; // Not for me, pass it up.
              }
+         case FlowControl::CONTINUE:
+            if (id != temp.target)
+             {
+               return temp; // Not for me, pass it up.
+             }
+            // Else do nothing: the previous iteration has stopped and we will move on to the next.
           }
 
          try
@@ -305,7 +376,7 @@ namespace Engine
             throw Types::TypedOperationException(msg);
           }
        }
-      return std::shared_ptr<FlowControl>();
+      return FlowControl();
     }
 
 
@@ -362,7 +433,7 @@ namespace Engine
     {
     }
 
-   std::shared_ptr<FlowControl> SelectStatement::execute (CallingContext& context) const
+   FlowControl SelectStatement::execute (CallingContext& context) const
     {
       std::shared_ptr<Types::ValueType> controlVal = control->evaluate(context);
 
@@ -374,8 +445,8 @@ namespace Engine
           {
             do
              {
-               std::shared_ptr<FlowControl> temp = (*iter)->seq->execute(context);
-               if (nullptr != temp.get())
+               FlowControl temp = (*iter)->seq->execute(context);
+               if (FlowControl::NONE != temp.type)
                 {
                   return temp;
                 }
@@ -385,7 +456,7 @@ namespace Engine
             end = true;
           }
        }
-      return std::shared_ptr<FlowControl>();
+      return FlowControl();
     }
 
 
@@ -396,7 +467,7 @@ namespace Engine
     {
     }
 
-   std::shared_ptr<FlowControl> ForStatement::execute (CallingContext& context) const
+   FlowControl ForStatement::execute (CallingContext& context) const
     {
       std::shared_ptr<Types::ValueType> currentValue = lower->evaluate(context);
 
@@ -410,7 +481,7 @@ namespace Engine
        }
     }
 
-   std::shared_ptr<FlowControl> ForStatement::loopIter (CallingContext& context, std::shared_ptr<Types::ValueType> currentValue) const
+   FlowControl ForStatement::loopIter (CallingContext& context, std::shared_ptr<Types::ValueType> currentValue) const
     {
       std::shared_ptr<Types::ValueType> UPPER = upper->evaluate(context);
       std::shared_ptr<Types::ValueType> STEP;
@@ -429,6 +500,52 @@ namespace Engine
        {
          STEP = step->evaluate(context);
        }
+
+         // Numbers are compared and stepped without making an expression for it: nothing can go wrong with them.
+      if ((typeid(Types::FloatValue) == typeid(*currentValue)) && (typeid(Types::FloatValue) == typeid(*UPPER)) && (typeid(Types::FloatValue) == typeid(*STEP)))
+       {
+         const NumberHolder& limit = *static_cast<const Types::FloatValue&>(*UPPER).value;
+         const Types::FloatValue& del = static_cast<const Types::FloatValue&>(*STEP);
+         while (true)
+          {
+            setter->set(context, currentValue);
+
+            const NumberHolder& lcv = *static_cast<const Types::FloatValue&>(*currentValue).value;
+            if (false == (to ? lcv.less_equal(limit) : lcv.greater_equal(limit)))
+             {
+               break;
+             }
+
+            FlowControl temp = seq->execute(context);
+
+            switch (temp.type)
+             {
+            case FlowControl::NONE:
+               break;
+            case FlowControl::RETURN:
+               return temp; // Pass it up.
+            case FlowControl::BREAK:
+               if (id == temp.target)
+                {
+                  return FlowControl(); // Loop is done.
+                }
+               else
+                {
+                  return temp; // Not for me, pass it up.
+                }
+            case FlowControl::CONTINUE:
+               if (id != temp.target)
+                {
+                  return temp; // Not for me, pass it up.
+                }
+               // Else do nothing: the previous iteration has stopped and we will move on to the next.
+             }
+
+            advance(currentValue, del, isUnshared(context, *getter, currentValue));
+          }
+         return FlowControl();
+       }
+
       std::shared_ptr<Expression> del = std::make_shared<Constant>(token, STEP);
 
       while (true)
@@ -467,147 +584,156 @@ namespace Engine
             break;
           }
 
-         std::shared_ptr<FlowControl> temp = seq->execute(context);
+         FlowControl temp = seq->execute(context);
 
-         if (nullptr != temp.get())
+         switch (temp.type)
           {
-            switch (temp->type)
+         case FlowControl::NONE:
+            break;
+         case FlowControl::RETURN:
+            return temp; // Pass it up.
+         case FlowControl::BREAK:
+            if (id == temp.target)
              {
-            case FlowControl::RETURN:
-               return temp; // Pass it up.
-            case FlowControl::BREAK:
-               if (id == temp->target)
-                {
-                  return std::shared_ptr<FlowControl>(); // Loop is done.
-                }
-               else
-                {
-                  return temp; // Not for me, pass it up.
-                }
-            case FlowControl::CONTINUE:
-               if (id != temp->target)
-                {
-                  return temp; // Not for me, pass it up.
-                }
-               // Else do nothing: the previous iteration has stopped and we will move on to the next.
+               return FlowControl(); // Loop is done.
+             }
+            else
+             {
+               return temp; // Not for me, pass it up.
+             }
+         case FlowControl::CONTINUE:
+            if (id != temp.target)
+             {
+               return temp; // Not for me, pass it up.
              }
+            // Else do nothing: the previous iteration has stopped and we will move on to the next.
           }
 
          Plus plus (token, lcv, del);
          currentValue = plus.evaluate(context);
        }
-      return std::shared_ptr<FlowControl>();
+      return FlowControl();
     }
 
-   static std::shared_ptr<FlowControl> arrayIter(CallingContext& context, std::shared_ptr<Types::ArrayValue> currentValue, const std::shared_ptr<Setter>& setter, const std::shared_ptr<Statement>& seq, size_t id)
+   void ForStatement::advance (std::shared_ptr<Types::ValueType>& current, const Types::FloatValue& step, bool unshared)
+    {
+      Types::FloatValue& value = static_cast<Types::FloatValue&>(*current);
+      if ((true == unshared) && (1 == value.value.use_count()))
+       {
+         value.value->addAssign(*step.value);
+       }
+      else
+       {
+         current = std::make_shared<Types::FloatValue>(*value.value + *step.value);
+       }
+    }
+
+   static FlowControl arrayIter(CallingContext& context, std::shared_ptr<Types::ArrayValue> currentValue, const std::shared_ptr<Setter>& setter, const std::shared_ptr<Statement>& seq, size_t id)
     {
       for (std::shared_ptr<Types::ValueType> iter : currentValue->value)
        {
          setter->set(context, iter);
 
-         std::shared_ptr<FlowControl> temp = seq->execute(context);
+         FlowControl temp = seq->execute(context);
 
-         if (nullptr != temp.get())
+         switch (temp.type)
           {
-            switch (temp->type)
+         case FlowControl::NONE:
+            break;
+         case FlowControl::RETURN:
+            return temp; // Pass it up.
+         case FlowControl::BREAK:
+            if (id == temp.target)
              {
-            case FlowControl::RETURN:
-               return temp; // Pass it up.
-            case FlowControl::BREAK:
-               if (id == temp->target)
-                {
-                  return std::shared_ptr<FlowControl>(); // Loop is done.
-                }
-               else
-                {
-                  return temp; // Not for me, pass it up.
-                }
-            case FlowControl::CONTINUE:
-               if (id != temp->target)
-                {
-                  return temp; // Not for me, pass it up.
-                }
-               // Else do nothing: the previous iteration has stopped and we will move on to the next.
+               return FlowControl(); // Loop is done.
+             }
+            else
+             {
+               return temp; // Not for me, pass it up.
              }
+         case FlowControl::CONTINUE:
+            if (id != temp.target)
+             {
+               return temp; // Not for me, pass it up.
+             }
+            // Else do nothing: the previous iteration has stopped and we will move on to the next.
           }
        }
-      return std::shared_ptr<FlowControl>();
+      return FlowControl();
     }
 
-   static std::shared_ptr<FlowControl> dictIter(CallingContext& context, std::shared_ptr<Types::DictionaryValue> currentValue, const std::shared_ptr<Setter>& setter, const std::shared_ptr<Statement>& seq, size_t id)
+   static FlowControl dictIter(CallingContext& context, std::shared_ptr<Types::DictionaryValue> currentValue, const std::shared_ptr<Setter>& setter, const std::shared_ptr<Statement>& seq, size_t id)
     {
-      for (auto iter : currentValue->value)
+      for (auto iter : currentValue->sorted())
        {
          std::shared_ptr<Types::ArrayValue> currIter = std::make_shared<Types::ArrayValue>();
-         currIter->value.push_back(iter.first);
-         currIter->value.push_back(iter.second);
+         currIter->value.push_back(iter->first);
+         currIter->value.push_back(iter->second);
          setter->set(context, currIter);
 
-         std::shared_ptr<FlowControl> temp = seq->execute(context);
+         FlowControl temp = seq->execute(context);
 
-         if (nullptr != temp.get())
+         switch (temp.type)
           {
-            switch (temp->type)
+         case FlowControl::NONE:
+            break;
+         case FlowControl::RETURN:
+            return temp; // Pass it up.
+         case FlowControl::BREAK:
+            if (id == temp.target)
              {
-            case FlowControl::RETURN:
-               return temp; // Pass it up.
-            case FlowControl::BREAK:
-               if (id == temp->target)
-                {
-                  return std::shared_ptr<FlowControl>(); // Loop is done.
-                }
-               else
-                {
-                  return temp; // Not for me, pass it up.
-                }
-            case FlowControl::CONTINUE:
-               if (id != temp->target)
-                {
-                  return temp; // Not for me, pass it up.
-                }
-               // Else do nothing: the previous iteration has stopped and we will move on to the next.
+               return FlowControl(); // Loop is done.
+             }
+            else
+             {
+               return temp; // Not for me, pass it up.
+             }
+         case FlowControl::CONTINUE:
+            if (id != temp.target)
+             {
+               return temp; // Not for me, pass it up.
              }
+            // Else do nothing: the previous iteration has stopped and we will move on to the next.
           }
        }
-      return std::shared_ptr<FlowControl>();
+      return FlowControl();
     }
 
-   static std::shared_ptr<FlowControl> rangeIter(CallingContext& context, std::shared_ptr<Types::CellRangeValue> currentValue, const std::shared_ptr<Setter>& setter, const std::shared_ptr<Statement>& seq, size_t id)
+   static FlowControl rangeIter(CallingContext& context, std::shared_ptr<Types::CellRangeValue> currentValue, const std::shared_ptr<Setter>& setter, const std::shared_ptr<Statement>& seq, size_t id)
     {
       for (size_t index = 0; index < currentValue->value->getSize(); ++index)
        {
          setter->set(context, currentValue->value->getIndex(index));
 
-         std::shared_ptr<FlowControl> temp = seq->execute(context);
+         FlowControl temp = seq->execute(context);
 
-         if (nullptr != temp.get())
+         switch (temp.type)
           {
-            switch (temp->type)
+         case FlowControl::NONE:
+            break;
+         case FlowControl::RETURN:
+            return temp; // Pass it up.
+         case FlowControl::BREAK:
+            if (id == temp.target)
              {
-            case FlowControl::RETURN:
-               return temp; // Pass it up.
-            case FlowControl::BREAK:
-               if (id == temp->target)
-                {
-                  return std::shared_ptr<FlowControl>(); // Loop is done.
-                }
-               else
-                {
-                  return temp; // Not for me, pass it up.
-                }
-            case FlowControl::CONTINUE:
-               if (id != temp->target)
-                {
-                  return temp; // Not for me, pass it up.
-                }
-               // Else do nothing: the previous iteration has stopped and we will move on to the next.
+               return FlowControl(); // Loop is done.
+             }
+            else
+             {
+               return temp; // Not for me, pass it up.
+             }
+         case FlowControl::CONTINUE:
+            if (id != temp.target)
+             {
+               return temp; // Not for me, pass it up.
              }
+            // Else do nothing: the previous iteration has stopped and we will move on to the next.
           }
        }
-      return std::shared_ptr<FlowControl>();
+      return FlowControl();
     }
 
-   std::shared_ptr<FlowControl> ForStatement::collIter (CallingContext& context, std::shared_ptr<Types::ValueType> currentValue) const
+   FlowControl ForStatement::collIter (CallingContext& context, std::shared_ptr<Types::ValueType> currentValue) const
     {
       if (typeid(Types::ArrayValue) == typeid(*currentValue.get()))
        {
@@ -639,7 +765,7 @@ namespace Engine
     {
     }
 
-   std::shared_ptr<FlowControl> FlowControlStatement::execute (CallingContext& context) const
+   FlowControl FlowControlStatement::execute (CallingContext& context) const
     {
       std::shared_ptr<Types::ValueType> VALUE;
       if (nullptr != value.get())
@@ -658,7 +784,7 @@ namespace Engine
             throw Types::TypedOperationException(msg);
           }
        }
-      return std::make_shared<FlowControl>(token, type, target, VALUE);
+      return FlowControl(token, type, target, VALUE);
     }
 
 
@@ -666,9 +792,9 @@ namespace Engine
     {
     }
 
-   std::shared_ptr<FlowControl> StandardConstantFunction::execute (CallingContext&) const
+   FlowControl StandardConstantFunction::execute (CallingContext&) const
     {
-      return std::make_shared<FlowControl>(token, FlowControl::RETURN, FlowControl::NO_TARGET, function());
+      return FlowControl(token, FlowControl::RETURN, FlowControl::NO_TARGET, function());
     }
 
 
@@ -676,9 +802,9 @@ namespace Engine
     {
     }
 
-   std::shared_ptr<FlowControl> StandardConstantFunctionWithContext::execute (CallingContext& context) const
+   FlowControl StandardConstantFunctionWithContext::execute (CallingContext& context) const
     {
-      return std::make_shared<FlowControl>(token, FlowControl::RETURN, FlowControl::NO_TARGET, function(context));
+      return FlowControl(token, FlowControl::RETURN, FlowControl::NO_TARGET, function(context));
     }
 
 
@@ -686,12 +812,12 @@ namespace Engine
     {
     }
 
-   std::shared_ptr<FlowControl> StandardUnaryFunction::execute (CallingContext& context) const
+   FlowControl StandardUnaryFunction::execute (CallingContext& context) const
     {
       std::shared_ptr<Types::ValueType> arg = context.currentFrame->args[0U];
       try
        {
-         return std::make_shared<FlowControl>(token, FlowControl::RETURN, FlowControl::NO_TARGET, function(arg));
+         return FlowControl(token, FlowControl::RETURN, FlowControl::NO_TARGET, function(arg));
        }
       catch (const Types::TypedOperationException& e)
        {
@@ -708,12 +834,12 @@ namespace Engine
     {
     }
 
-   std::shared_ptr<FlowControl> StandardUnaryFunctionWithContext::execute (CallingContext& context) const
+   FlowControl StandardUnaryFunctionWithContext::execute (CallingContext& context) const
     {
       std::shared_ptr<Types::ValueType> arg = context.currentFrame->args[0U];
       try
        {
-         return std::make_shared<FlowControl>(token, FlowControl::RETURN, FlowControl::NO_TARGET, function(context, arg));
+         return FlowControl(token, FlowControl::RETURN, FlowControl::NO_TARGET, function(context, arg));
        }
       catch (const Types::TypedOperationException& e)
        {
@@ -730,13 +856,13 @@ namespace Engine
     {
     }
 
-   std::shared_ptr<FlowControl> StandardBinaryFunction::execute (CallingContext& context) const
+   FlowControl StandardBinaryFunction::execute (CallingContext& context) const
     {
       std::shared_ptr<Types::ValueType> lhs = context.currentFrame->args[0U];
       std::shared_ptr<Types::ValueType> rhs = context.currentFrame->args[1U];
       try
        {
-         return std::make_shared<FlowControl>(token, FlowControl::RETURN, FlowControl::NO_TARGET, function(lhs, rhs));
+         return FlowControl(token, FlowControl::RETURN, FlowControl::NO_TARGET, function(lhs, rhs));
        }
       catch (const Types::TypedOperationException& e)
        {
@@ -753,14 +879,14 @@ namespace Engine
     {
     }
 
-   std::shared_ptr<FlowControl> StandardTernaryFunction::execute (CallingContext& context) const
+   FlowControl StandardTernaryFunction::execute (CallingContext& context) const
     {
       std::shared_ptr<Types::ValueType> first = context.currentFrame->args[0U];
       std::shared_ptr<Types::ValueType> second = context.currentFrame->args[1U];
       std::shared_ptr<Types::ValueType> third = context.currentFrame->args[2U];
       try
        {
-         return std::make_shared<FlowControl>(token, FlowControl::RETURN, FlowControl::NO_TARGET, function(first, second, third));
+         return FlowControl(token, FlowControl::RETURN, FlowControl::NO_TARGET, function(first, second, third));
        }
       catch (const Types::TypedOperationException& e)
        {
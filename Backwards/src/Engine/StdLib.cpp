@@ -102,7 +102,7 @@ namespace Engine
          // Yes, construct a new container on modification.
          std::shared_ptr<Types::DictionaryValue> result = std::make_shared<Types::DictionaryValue>();
          result->value = static_cast<const Types::DictionaryValue&>(*first).value;
-         result->value[second] = third;
+         result->value.set(second, third);
          return result;
        }
       else
@@ -115,11 +115,10 @@ namespace Engine
     {
       if (typeid(Types::DictionaryValue) == typeid(*first))
        {
-         std::map<std::shared_ptr<Types::ValueType>, std::shared_ptr<Types::ValueType>, Types::ChristHowHorrifying>::const_iterator iter =
-            static_cast<const Types::DictionaryValue&>(*first).value.find(second);
-         if (static_cast<const Types::DictionaryValue&>(*first).value.end() != iter)
+         const Types::DictionaryValue::Map::value_type* found = static_cast<const Types::DictionaryValue&>(*first).value.find(second);
+         if (nullptr != found)
           {
-            return iter->second;
+            return found->second;
           }
          else
           {
@@ -190,7 +189,7 @@ namespace Engine
                // Yes, construct a new container on modification.
                std::shared_ptr<Types::ArrayValue> result = std::make_shared<Types::ArrayValue>();
                result->value = static_cast<const Types::ArrayValue&>(*first).value;
-               result->value[static_cast<size_t>(index)] = third;
+               result->value.set(static_cast<size_t>(index), third);
                return result;
              }
             else
@@ -209,6 +208,59 @@ namespace Engine
        }
     }
 
+   bool PushBackInPlace(Types::ValueType& first, const std::shared_ptr<Types::ValueType>& second)
+    {
+      if (typeid(Types::ArrayValue) == typeid(first))
+       {
+         static_cast<Types::ArrayValue&>(first).value.push_back(second);
+         return true;
+       }
+      return false;
+    }
+
+   bool PopBackInPlace(Types::ValueType& arg)
+    {
+      if ((typeid(Types::ArrayValue) == typeid(arg)) && (false == static_cast<Types::ArrayValue&>(arg).value.empty()))
+       {
+         static_cast<Types::ArrayValue&>(arg).value.pop_back();
+         return true;
+       }
+      return false;
+    }
+
+   bool RemoveKeyInPlace(Types::ValueType& first, const std::shared_ptr<Types::ValueType>& second)
+    {
+      if (typeid(Types::DictionaryValue) == typeid(first))
+       {
+         return 1U == static_cast<Types::DictionaryValue&>(first).value.erase(second);
+       }
+      return false;
+    }
+
+   bool SetIndexInPlace(Types::ValueType& first, const std::shared_ptr<Types::ValueType>& second, const std::shared_ptr<Types::ValueType>& third)
+    {
+      if ((typeid(Types::ArrayValue) == typeid(first)) && (typeid(Types::FloatValue) == typeid(*second)))
+       {
+         double index = static_cast<const Types::FloatValue&>(*second).value->asDouble();
+         if ((index >= 0.0) && (index < static_cast<double>(static_cast<Types::ArrayValue&>(first).value.size())))
+          {
+            static_cast<Types::ArrayValue&>(first).value.set(static_cast<size_t>(index), third);
+            return true;
+          }
+       }
+      return false;
+    }
+
+   bool InsertInPlace(Types::ValueType& first, const std::shared_ptr<Types::ValueType>& second, const std::shared_ptr<Types::ValueType>& third)
+    {
+      if (typeid(Types::DictionaryValue) == typeid(first))
+       {
+         static_cast<Types::DictionaryValue&>(first).value.set(second, third);
+         return true;
+       }
+      return false;
+    }
+
    //////////
    // These next 5 are the most basic in telling if it works.
    //////////
@@ -266,8 +318,10 @@ namespace Engine
        {
          std::shared_ptr<Types::ArrayValue> result = std::make_shared<Types::ArrayValue>();
          result->value.push_back(second);
-         const std::vector<std::shared_ptr<Types::ValueType> >& source = static_cast<const Types::ArrayValue&>(*first).value;
-         result->value.insert(result->value.end(), source.begin(), source.end());
+         for (const std::shared_ptr<Types::ValueType>& item : static_cast<const Types::ArrayValue&>(*first).value)
+          {
+            result->value.push_back(item);
+          }
          return result;
        }
       else
@@ -305,8 +359,8 @@ namespace Engine
          if (false == static_cast<const Types::ArrayValue&>(*arg).value.empty())
           {
             std::shared_ptr<Types::ArrayValue> result = std::make_shared<Types::ArrayValue>();
-            const std::vector<std::shared_ptr<Types::ValueType> >& source = static_cast<const Types::ArrayValue&>(*arg).value;
-            result->value.assign(source.begin() + 1U, source.end());
+            const Types::PersistentVector<std::shared_ptr<Types::ValueType> >& source = static_cast<const Types::ArrayValue&>(*arg).value;
+            result->value = Types::PersistentVector<std::shared_ptr<Types::ValueType> >(source.begin() + 1U, source.end());
             return result;
           }
          else
@@ -383,7 +437,7 @@ namespace Engine
              (*static_cast<const Types::FloatValue&>(*first).value < *NumberSystem::getCurrentNumberSystem().fromInt(std::numeric_limits<unsigned int>::max())))
           {
             std::shared_ptr<Types::ArrayValue> result = std::make_shared<Types::ArrayValue>();
-            result->value.resize(static_cast<size_t>(size), second);
+            result->value = Types::PersistentVector<std::shared_ptr<Types::ValueType> >(static_cast<size_t>(size), second);
             return result;
           }
          else
@@ -441,9 +495,8 @@ namespace Engine
     {
       if (typeid(Types::DictionaryValue) == typeid(*first))
        {
-         std::map<std::shared_ptr<Types::ValueType>, std::shared_ptr<Types::ValueType>, Types::ChristHowHorrifying>::const_iterator iter =
-            static_cast<const Types::DictionaryValue&>(*first).value.find(second);
-         if (static_cast<const Types::DictionaryValue&>(*first).value.end() != iter)
+         const Types::DictionaryValue::Map::value_type* found = static_cast<const Types::DictionaryValue&>(*first).value.find(second);
+         if (nullptr != found)
           {
             return Expression::FLOAT_ONE();
           }
@@ -462,9 +515,8 @@ namespace Engine
     {
       if (typeid(Types::DictionaryValue) == typeid(*first))
        {
-         std::map<std::shared_ptr<Types::ValueType>, std::shared_ptr<Types::ValueType>, Types::ChristHowHorrifying>::const_iterator iter =
-            static_cast<const Types::DictionaryValue&>(*first).value.find(second);
-         if (static_cast<const Types::DictionaryValue&>(*first).value.end() != iter)
+         const Types::DictionaryValue::Map::value_type* found = static_cast<const Types::DictionaryValue&>(*first).value.find(second);
+         if (nullptr != found)
           {
             std::shared_ptr<Types::DictionaryValue> result = std::make_shared<Types::DictionaryValue>();
             result->value = static_cast<const Types::DictionaryValue&>(*first).value;
@@ -487,11 +539,10 @@ namespace Engine
       if (typeid(Types::DictionaryValue) == typeid(*arg))
        {
          std::shared_ptr<Types::ArrayValue> result = std::make_shared<Types::ArrayValue>();
-         for (std::map<std::shared_ptr<Types::ValueType>, std::shared_ptr<Types::ValueType>, Types::ChristHowHorrifying>::const_iterator iter =
-            static_cast<const Types::DictionaryValue&>(*arg).value.begin();
-            static_cast<const Types::DictionaryValue&>(*arg).value.end() != iter; ++iter)
+         std::vector<const Types::DictionaryValue::Map::value_type*> items = static_cast<const Types::DictionaryValue&>(*arg).sorted();
+         for (std::vector<const Types::DictionaryValue::Map::value_type*>::const_iterator iter = items.begin(); items.end() != iter; ++iter)
           {
-            result->value.push_back(iter->first);
+            result->value.push_back((*iter)->first);
           }
          return result;
        }
@@ -72,9 +72,9 @@ namespace Engine
           }
          else if (typeid(Types::ArrayValue) == typeid(*val))
           {
-            const std::vector<std::shared_ptr<Types::ValueType> >& array = std::dynamic_pointer_cast<const Types::ArrayValue>(val)->value;
+            const Types::PersistentVector<std::shared_ptr<Types::ValueType> >& array = std::dynamic_pointer_cast<const Types::ArrayValue>(val)->value;
             stream << "{ ";
-            for (std::vector<std::shared_ptr<Types::ValueType> >::const_iterator iter = array.begin();
+            for (Types::PersistentVector<std::shared_ptr<Types::ValueType> >::const_iterator iter = array.begin();
                array.end() != iter; ++iter)
              {
                if (array.begin() != iter)
@@ -87,19 +87,19 @@ namespace Engine
           }
          else if (typeid(Types::DictionaryValue) == typeid(*val))
           {
-            const std::map<std::shared_ptr<Types::ValueType>, std::shared_ptr<Types::ValueType>, Types::ChristHowHorrifying>& dict =
-               std::dynamic_pointer_cast<const Types::DictionaryValue>(val)->value;
+            const std::vector<const Types::DictionaryValue::Map::value_type*> dict =
+               std::dynamic_pointer_cast<const Types::DictionaryValue>(val)->sorted();
             stream << "{ ";
-            for (std::map<std::shared_ptr<Types::ValueType>, std::shared_ptr<Types::ValueType>, Types::ChristHowHorrifying>::const_iterator
+            for (std::vector<const Types::DictionaryValue::Map::value_type*>::const_iterator
                iter = dict.begin(); dict.end() != iter; ++iter)
              {
                if (dict.begin() != iter)
                 {
                   stream << "; ";
                 }
-               printValue(stream, iter->first);
+               printValue(stream, (*iter)->first);
                stream << ":";
-               printValue(stream, iter->second);
+               printValue(stream, (*iter)->second);
              }
             stream << " }";
           }
@@ -136,7 +136,7 @@ namespace Engine
    static void outputFrame(std::ostream& out, StackFrame* frame)
    {
       out << "#" << frame->depth << ": >" << frame->function->name <<
-         "< from line " << frame->callingToken.lineNumber << " in " << frame->callingToken.sourceFile;
+         "< from line " << frame->callingToken->lineNumber << " in " << frame->callingToken->sourceFile;
    }
 
    void DefaultDebugger::EnterDebugger(const std::string& exceptionMessage, CallingContext& context)
@@ -31,6 +31,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #include "Backwards/Parser/Parser.h"
 
+#include "Backwards/Engine/Compiled.h"
 #include "Backwards/Engine/Expression.h"
 #include "Backwards/Engine/FunctionContext.h"
 #include "Backwards/Engine/Statement.h"
@@ -551,6 +552,10 @@ namespace Parser
 
             if ((nullptr != block.get()) && (false == badWrong))
              {
+               if (true == table.compile)
+                {
+                  block = Engine::Compiled::compile(block);
+                }
                table.getContext()->function = block;
                table.getContext()->nlocals = table.getContext()->locals.size();
                 // Nota bene : we are being very loosey-goosey with the functions.
@@ -42,7 +42,7 @@ namespace Parser
  {
 
    SymbolTable::SymbolTable(GetterSetter& gs, Engine::Scope& globalScope) :
-      globalScope(&globalScope), gs(gs)
+      globalScope(&globalScope), gs(gs), compile(false)
     {
       if (globalScope.var.end() != globalScope.var.find("PushBack"))
        {
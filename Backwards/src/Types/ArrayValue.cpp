@@ -55,8 +55,7 @@ namespace Types
    std::shared_ptr<ValueType> ArrayValue::neg() const
     {
       std::shared_ptr<ArrayValue> result = std::make_shared<ArrayValue>();
-      result->value.reserve(value.size());
-      for (std::vector<std::shared_ptr<ValueType> >::const_iterator iter = value.begin();
+      for (PersistentVector<std::shared_ptr<ValueType> >::const_iterator iter = value.begin();
          value.end() != iter; ++iter)
        {
          result->value.emplace_back((*iter)->neg());
@@ -68,8 +67,7 @@ namespace Types
    std::shared_ptr<ValueType> ArrayValue::x (const y& lhs) const \
     { \
       std::shared_ptr<ArrayValue> result = std::make_shared<ArrayValue>(); \
-      result->value.reserve(value.size()); \
-      for (std::vector<std::shared_ptr<ValueType> >::const_iterator iter = value.begin(); \
+      for (PersistentVector<std::shared_ptr<ValueType> >::const_iterator iter = value.begin(); \
          value.end() != iter; ++iter) \
        { \
          result->value.emplace_back(lhs.x(**iter)); \
@@ -98,7 +96,7 @@ namespace Types
       if (lhs.value.size() == value.size())
        {
          are_equal = true;
-         for (std::vector<std::shared_ptr<ValueType> >::const_iterator iter1 = lhs.value.begin(),
+         for (PersistentVector<std::shared_ptr<ValueType> >::const_iterator iter1 = lhs.value.begin(),
             iter2 = value.begin(); (lhs.value.end() != iter1) && (true == are_equal); ++iter1, ++iter2)
           {
             are_equal &= ((*iter1)->compare(**iter2));
@@ -117,8 +115,7 @@ namespace Types
    std::shared_ptr<ValueType> ArrayValue::x (const ValueType& rhs) const \
     { \
       std::shared_ptr<ArrayValue> result = std::make_shared<ArrayValue>(); \
-      result->value.reserve(value.size()); \
-      for (std::vector<std::shared_ptr<ValueType> >::const_iterator iter = value.begin(); \
+      for (PersistentVector<std::shared_ptr<ValueType> >::const_iterator iter = value.begin(); \
          value.end() != iter; ++iter) \
        { \
          result->value.emplace_back((*iter)->x(rhs)); \
@@ -153,7 +150,7 @@ namespace Types
       bool is_less = false;
       if (lhs.value.size() == value.size())
        {
-         for (std::vector<std::shared_ptr<ValueType> >::const_iterator iter1 = lhs.value.begin(),
+         for (PersistentVector<std::shared_ptr<ValueType> >::const_iterator iter1 = lhs.value.begin(),
             iter2 = value.begin(); lhs.value.end() != iter1; ++iter1, ++iter2)
           {
             if (false == (*iter1)->compare(**iter2))
@@ -199,7 +196,7 @@ namespace Types
     {
                       // S H I A L A B E O U F
       size_t result = 0x534849414C414245;
-      for (std::vector<std::shared_ptr<ValueType> >::const_iterator iter = value.begin();
+      for (PersistentVector<std::shared_ptr<ValueType> >::const_iterator iter = value.begin();
          value.end() != iter; ++iter)
        {
          boost_hash_combine(result, (*iter)->hash());
@@ -40,6 +40,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "Backwards/Types/CellRefValue.h"
 #include "Backwards/Types/CellRangeValue.h"
 
+#include <algorithm>
+
 namespace Backwards
  {
 
@@ -51,16 +53,39 @@ namespace Types
       return lhs->sort(*rhs);
     }
 
+   size_t HashValue::operator() (const std::shared_ptr<ValueType>& key) const
+    {
+      return key->hash();
+    }
+
+   bool CompareValue::operator() (const std::shared_ptr<ValueType>& lhs, const std::shared_ptr<ValueType>& rhs) const
+    {
+      return lhs->compare(*rhs);
+    }
+
    const std::string& DictionaryValue::getTypeName() const
     {
       static const std::string name ("Dictionary");
       return name;
     }
 
+   std::vector<const DictionaryValue::Map::value_type*> DictionaryValue::sorted() const
+    {
+      std::vector<const Map::value_type*> result;
+      result.reserve(value.size());
+      for (Map::const_iterator iter = value.begin(); value.end() != iter; ++iter)
+       {
+         result.push_back(&*iter);
+       }
+      ChristHowHorrifying less;
+      std::sort(result.begin(), result.end(), [&less](const Map::value_type* lhs, const Map::value_type* rhs) { return less(lhs->first, rhs->first); });
+      return result;
+    }
+
    std::shared_ptr<ValueType> DictionaryValue::neg() const
     {
       std::shared_ptr<DictionaryValue> result = std::make_shared<DictionaryValue>();
-      for (std::map<std::shared_ptr<ValueType>, std::shared_ptr<ValueType>, ChristHowHorrifying>::const_iterator iter = value.begin();
+      for (Map::const_iterator iter = value.begin();
          value.end() != iter; ++iter)
        {
          result->value.emplace(std::make_pair(iter->first, iter->second->neg()));
@@ -72,7 +97,7 @@ namespace Types
    std::shared_ptr<ValueType> DictionaryValue::x (const y& lhs) const \
     { \
       std::shared_ptr<DictionaryValue> result = std::make_shared<DictionaryValue>(); \
-      for (std::map<std::shared_ptr<ValueType>, std::shared_ptr<ValueType>, ChristHowHorrifying>::const_iterator iter = value.begin(); \
+      for (Map::const_iterator iter = value.begin(); \
          value.end() != iter; ++iter) \
        { \
          result->value.emplace(std::make_pair(iter->first, lhs.x(*(iter->second)))); \
@@ -101,14 +126,10 @@ namespace Types
       if (lhs.value.size() == value.size())
        {
          are_equal = true;
-         for (std::map<std::shared_ptr<ValueType>, std::shared_ptr<ValueType>, ChristHowHorrifying>::const_iterator iter1 = lhs.value.begin(),
-            iter2 = value.begin(); (lhs.value.end() != iter1) && (true == are_equal); ++iter1, ++iter2)
+         for (Map::const_iterator iter = lhs.value.begin(); (lhs.value.end() != iter) && (true == are_equal); ++iter)
           {
-            are_equal &= (iter1->first->compare(*(iter2->first)));
-            if (true == are_equal)
-             {
-               are_equal &= (iter1->second->compare(*(iter2->second)));
-             }
+            const Map::value_type* found = value.find(iter->first);
+            are_equal = (nullptr != found) && (true == iter->second->compare(*(found->second)));
           }
        }
       return are_equal;
@@ -124,7 +145,7 @@ namespace Types
    std::shared_ptr<ValueType> DictionaryValue::x (const ValueType& rhs) const \
     { \
       std::shared_ptr<DictionaryValue> result = std::make_shared<DictionaryValue>(); \
-      for (std::map<std::shared_ptr<ValueType>, std::shared_ptr<ValueType>, ChristHowHorrifying>::const_iterator iter = value.begin(); \
+      for (Map::const_iterator iter = value.begin(); \
          value.end() != iter; ++iter) \
        { \
          result->value.emplace(std::make_pair(iter->first, iter->second->x(rhs))); \
@@ -164,17 +185,19 @@ namespace Types
       bool is_less = false;
       if (lhs.value.size() == value.size())
        {
-         for (std::map<std::shared_ptr<ValueType>, std::shared_ptr<ValueType>, ChristHowHorrifying>::const_iterator iter1 = lhs.value.begin(),
-            iter2 = value.begin(); lhs.value.end() != iter1; ++iter1, ++iter2)
+         std::vector<const Map::value_type*> left = lhs.sorted();
+         std::vector<const Map::value_type*> right = sorted();
+         for (std::vector<const Map::value_type*>::const_iterator iter1 = left.begin(),
+            iter2 = right.begin(); left.end() != iter1; ++iter1, ++iter2)
           {
-            if (false == (iter1->first->compare(*(iter2->first))))
+            if (false == ((*iter1)->first->compare(*((*iter2)->first))))
              {
-               is_less = (iter1->first->sort(*(iter2->first)));
+               is_less = ((*iter1)->first->sort(*((*iter2)->first)));
                break;
              }
-            if (false == (iter1->second->compare(*(iter2->second))))
+            if (false == ((*iter1)->second->compare(*((*iter2)->second))))
              {
-               is_less = (iter1->second->sort(*(iter2->second)));
+               is_less = ((*iter1)->second->sort(*((*iter2)->second)));
                break;
              }
           }
@@ -210,7 +233,7 @@ namespace Types
     {
                       // B E E F C A K E
       size_t result = 0x4245454643414B45;
-      for (std::map<std::shared_ptr<ValueType>, std::shared_ptr<ValueType>, ChristHowHorrifying>::const_iterator iter = value.begin();
+      for (Map::const_iterator iter = value.begin();
          value.end() != iter; ++iter)
        {
          size_t temp = iter->first->hash();
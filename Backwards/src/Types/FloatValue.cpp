@@ -168,7 +168,12 @@ namespace Types
 
    size_t FloatValue::hash() const
     {
-      return std::hash<std::string>()(value->toString());
+         // Numbers that compare equal have to hash the same to find each other in a Dictionary, and
+         // the string doesn't do that: -0 and 0, or 1.0 and 1.00 in decimal. The double does.
+                      // F L O A T I N G
+      size_t result = 0x464C4F4154494E47;
+      boost_hash_combine(result, std::hash<double>()(value->asDouble()));
+      return result;
     }
 
  } // namespace Types
@@ -658,13 +658,13 @@ int ProcessInput(SharedData& data)
          data.inputMode = false;
          data.context->theSheet->commitCell(curCell);
          curCell->previousValue.reset();
-         data.context->theSheet->recalc(*data.context);
+         data.context->theSheet->update(*data.context);
        }
       else if ((KEY_DOWN == c) || (KEY_UP == c) || (KEY_NPAGE == c) || (KEY_PPAGE == c))
        {
          data.inputMode = false;
          data.context->theSheet->commitCell(curCell);
-         data.context->theSheet->recalc(*data.context);
+         data.context->theSheet->update(*data.context);
          done = false;
          if (KEY_NPAGE == c)
           {
@@ -897,7 +897,7 @@ int ProcessInput(SharedData& data)
          data.context->theSheet->clearRow(data.c_row);
          break;
        }
-      data.context->theSheet->recalc(*data.context);
+      data.context->theSheet->update(*data.context);
       break;
    case 'y':
       if ('y' == getch())
@@ -925,7 +925,7 @@ int ProcessInput(SharedData& data)
          curCell->type = data.yankedType;
          curCell->value = data.yanked;
          data.context->theSheet->commitCell(curCell);
-         data.context->theSheet->recalc(*data.context);
+         data.context->theSheet->update(*data.context);
        }
       break;
    case 'e':
@@ -31,6 +31,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #include <iostream>
 #include <filesystem>
+#include <thread>
+#include <cstdlib>
 
 #include "Backwards/Engine/Logger.h"
 
@@ -47,6 +49,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "NumberSystem.h"
 
 #include "DBManager.h"
+#include "DBSpreadSheet.h"
 #include "BatchMode.h"
 #include "GetAndSet.h"
 #include "LibraryLoader.h"
@@ -54,6 +57,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "Screen.h"
 
+   // A worker thread gets the same 8MiB stack as the main thread: an unoptimized build runs out of it
+   // somewhere between 6800 and 7000 nested calls, an optimized build past 9000. Stop short of the smaller.
+static const size_t DEFAULT_MAX_DEPTH = 6000U;
+
 int main (int argc, char ** argv)
  {
    Forwards::Engine::CallingContext context;
@@ -67,6 +74,7 @@ int main (int argc, char ** argv)
    context.map = &map;
    Forwards::Engine::NameMap names;
    context.names = &names;
+   context.maxDepth = DEFAULT_MAX_DEPTH;
 
    std::list<std::string> batches;
    std::vector<std::pair<std::string, std::string> > argLibs;
@@ -114,6 +122,59 @@ int main (int argc, char ** argv)
    file = PreLoadLibraries(argc, argv, file, argLibs);
    file = ReadBatches(argc, argv, file, batches);
 
+   bool statistics = false;
+   bool preload = false;
+   bool budgeted = false;
+   size_t cacheBudget = 0U;
+   size_t pageBudget = 0U;
+   while (file < argc)
+    {
+      if (std::string("-s") == argv[file])
+       {
+         statistics = true;
+         ++file;
+       }
+      else if (std::string("-p") == argv[file])
+       {
+         preload = true;
+         ++file;
+       }
+      else if (std::string("-c") == argv[file])
+       {
+         sheet.compiled = true;
+         ++file;
+       }
+      else if ((std::string("-t") == argv[file]) && (file + 1 < argc))
+       {
+         sheet.threads = std::strtoul(argv[file + 1], nullptr, 10);
+         if (0U == sheet.threads)
+          {
+            sheet.threads = std::thread::hardware_concurrency();
+          }
+         file += 2;
+       }
+      else if ((std::string("-d") == argv[file]) && (file + 1 < argc))
+       {
+         context.maxDepth = std::strtoul(argv[file + 1], nullptr, 10);
+         file += 2;
+       }
+      else if ((std::string("-k") == argv[file]) && (file + 1 < argc))
+       {
+         budgeted = true;
+         cacheBudget = std::strtoul(argv[file + 1], nullptr, 10);
+         file += 2;
+       }
+      else if ((std::string("-m") == argv[file]) && (file + 1 < argc))
+       {
+         pageBudget = std::strtoul(argv[file + 1], nullptr, 10) * 1024U * 1024U;
+         file += 2;
+       }
+      else
+       {
+         break;
+       }
+    }
+
 
    SharedData state;
 
@@ -149,7 +210,25 @@ int main (int argc, char ** argv)
 
       if (file < argc)
        {
-         AttachDB(argv[file], manager);
+         AttachDB(argv[file], manager, pageBudget);
+       }
+
+      if (true == budgeted)
+       {
+         DBSpreadSheet* working = dynamic_cast<DBSpreadSheet*>(manager.getWorkingSpreadSheet());
+         if (nullptr != working)
+          {
+            working->setCacheBudget(cacheBudget);
+          }
+       }
+
+      if (true == preload)
+       {
+         DBSpreadSheet* working = dynamic_cast<DBSpreadSheet*>(manager.getWorkingSpreadSheet());
+         if (nullptr != working)
+          {
+            working->preload();
+          }
        }
 
       sheet.currentSheet = manager.getWorkingSpreadSheet();
@@ -169,6 +248,10 @@ int main (int argc, char ** argv)
       if (false == batches.empty())
        {
          RunBatches(batches, context);
+         if (true == statistics)
+          {
+            std::cerr << manager.getStatistics() << std::endl;
+          }
          return 0;
        }
 
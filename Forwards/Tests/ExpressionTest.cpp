@@ -1455,9 +1455,9 @@ TEST(EngineTests, testCellRangeExpand)
    ASSERT_TRUE(typeid(Backwards::Types::CellRefValue) == typeid(*res.get()));
    ASSERT_TRUE(typeid(Forwards::Engine::CellRefEval) == typeid(*std::dynamic_pointer_cast<Backwards::Types::CellRefValue>(res)->value.get()));
    temp1 = std::dynamic_pointer_cast<Forwards::Engine::CellRefEval>(std::dynamic_pointer_cast<Backwards::Types::CellRefValue>(res)->value);
-   ASSERT_TRUE(typeid(Forwards::Engine::Constant) == typeid(*temp1->value.get()));
-   ASSERT_TRUE(typeid(Forwards::Types::CellRefValue) == typeid(*std::dynamic_pointer_cast<Forwards::Engine::Constant>(temp1->value)->value.get()));
-   ras = std::dynamic_pointer_cast<Forwards::Engine::Constant>(temp1->value)->value;
+   ASSERT_TRUE(typeid(Forwards::Engine::Constant) == typeid(*temp1->getExpression().get()));
+   ASSERT_TRUE(typeid(Forwards::Types::CellRefValue) == typeid(*std::dynamic_pointer_cast<Forwards::Engine::Constant>(temp1->getExpression())->value.get()));
+   ras = std::dynamic_pointer_cast<Forwards::Engine::Constant>(temp1->getExpression())->value;
    EXPECT_EQ(true, std::dynamic_pointer_cast<Forwards::Types::CellRefValue>(ras)->colAbsolute);
    EXPECT_EQ(0U, std::dynamic_pointer_cast<Forwards::Types::CellRefValue>(ras)->colRef);
    EXPECT_EQ(true, std::dynamic_pointer_cast<Forwards::Types::CellRefValue>(ras)->rowAbsolute);
@@ -1478,9 +1478,9 @@ TEST(EngineTests, testCellRangeExpand)
    ASSERT_TRUE(typeid(Backwards::Types::CellRefValue) == typeid(*res.get()));
    ASSERT_TRUE(typeid(Forwards::Engine::CellRefEval) == typeid(*std::dynamic_pointer_cast<Backwards::Types::CellRefValue>(res)->value.get()));
    temp1 = std::dynamic_pointer_cast<Forwards::Engine::CellRefEval>(std::dynamic_pointer_cast<Backwards::Types::CellRefValue>(res)->value);
-   ASSERT_TRUE(typeid(Forwards::Engine::Constant) == typeid(*temp1->value.get()));
-   ASSERT_TRUE(typeid(Forwards::Types::CellRefValue) == typeid(*std::dynamic_pointer_cast<Forwards::Engine::Constant>(temp1->value)->value.get()));
-   ras = std::dynamic_pointer_cast<Forwards::Engine::Constant>(temp1->value)->value;
+   ASSERT_TRUE(typeid(Forwards::Engine::Constant) == typeid(*temp1->getExpression().get()));
+   ASSERT_TRUE(typeid(Forwards::Types::CellRefValue) == typeid(*std::dynamic_pointer_cast<Forwards::Engine::Constant>(temp1->getExpression())->value.get()));
+   ras = std::dynamic_pointer_cast<Forwards::Engine::Constant>(temp1->getExpression())->value;
    EXPECT_EQ(true, std::dynamic_pointer_cast<Forwards::Types::CellRefValue>(ras)->colAbsolute);
    EXPECT_EQ(3U, std::dynamic_pointer_cast<Forwards::Types::CellRefValue>(ras)->colRef);
    EXPECT_EQ(true, std::dynamic_pointer_cast<Forwards::Types::CellRefValue>(ras)->rowAbsolute);
@@ -1490,9 +1490,9 @@ TEST(EngineTests, testCellRangeExpand)
    ASSERT_TRUE(typeid(Backwards::Types::CellRefValue) == typeid(*res.get()));
    ASSERT_TRUE(typeid(Forwards::Engine::CellRefEval) == typeid(*std::dynamic_pointer_cast<Backwards::Types::CellRefValue>(res)->value.get()));
    temp1 = std::dynamic_pointer_cast<Forwards::Engine::CellRefEval>(std::dynamic_pointer_cast<Backwards::Types::CellRefValue>(res)->value);
-   ASSERT_TRUE(typeid(Forwards::Engine::Constant) == typeid(*temp1->value.get()));
-   ASSERT_TRUE(typeid(Forwards::Types::CellRefValue) == typeid(*std::dynamic_pointer_cast<Forwards::Engine::Constant>(temp1->value)->value.get()));
-   ras = std::dynamic_pointer_cast<Forwards::Engine::Constant>(temp1->value)->value;
+   ASSERT_TRUE(typeid(Forwards::Engine::Constant) == typeid(*temp1->getExpression().get()));
+   ASSERT_TRUE(typeid(Forwards::Types::CellRefValue) == typeid(*std::dynamic_pointer_cast<Forwards::Engine::Constant>(temp1->getExpression())->value.get()));
+   ras = std::dynamic_pointer_cast<Forwards::Engine::Constant>(temp1->getExpression())->value;
    EXPECT_EQ(true, std::dynamic_pointer_cast<Forwards::Types::CellRefValue>(ras)->colAbsolute);
    EXPECT_EQ(5U, std::dynamic_pointer_cast<Forwards::Types::CellRefValue>(ras)->colRef);
    EXPECT_EQ(true, std::dynamic_pointer_cast<Forwards::Types::CellRefValue>(ras)->rowAbsolute);
@@ -1557,6 +1557,17 @@ TEST(EngineTests, testCellRefEval_EqualCases)
    EXPECT_TRUE(un.sort(quatre) | quatre.sort(un));
    EXPECT_TRUE(un.sort(cinq) | cinq.sort(un));
    EXPECT_FALSE(un.sort(six) | six.sort(un));
+
+      // A reference straight to a cell is the same as an absolute reference to it.
+   Backwards::Types::CellRefValue sept (std::make_shared<Forwards::Engine::CellRefEval>(0U, 0U, ""));
+   Backwards::Types::CellRefValue huit (std::make_shared<Forwards::Engine::CellRefEval>(
+      std::make_shared<Forwards::Engine::Constant>(Forwards::Input::Token(), std::make_shared<Forwards::Types::CellRefValue>(true, 0, true, 0, ""))));
+
+   EXPECT_TRUE(sept.equal(huit));
+   EXPECT_TRUE(huit.equal(sept));
+   EXPECT_FALSE(sept.equal(un));
+   EXPECT_FALSE(sept.sort(huit) | huit.sort(sept));
+   EXPECT_EQ(sept.hash(), huit.hash());
  }
 
 TEST(EngineTests, testCellRangeExpand_EqualCases)
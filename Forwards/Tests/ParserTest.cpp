@@ -40,6 +40,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "Forwards/Engine/Expression.h"
 #include "Forwards/Input/Lexer.h"
 #include "Forwards/Parser/Parser.h"
+#include "Forwards/Parser/ParseCache.h"
 
 class StringLogger final : public Backwards::Engine::Logger
  {
@@ -435,3 +436,88 @@ TEST(ParserTests, testName)
     }
    ASSERT_TRUE(typeid(Forwards::Engine::Name) == typeid(*parse.get()));
  }
+
+TEST(ParserTests, testParseCache)
+ {
+   StringLogger logger;
+   Forwards::Engine::GetterMap map;
+   Forwards::Parser::ParseCache cache;
+
+      // Filled down a column: one tree.
+   std::shared_ptr<Forwards::Engine::Expression> first = cache.parse("B1+$A$1", map, logger, 2U, 2U);
+   std::shared_ptr<Forwards::Engine::Expression> second = cache.parse("B2+$A$1", map, logger, 2U, 3U);
+   ASSERT_NE(nullptr, first.get());
+   EXPECT_EQ(first.get(), second.get());
+   EXPECT_EQ("B1+$A$1", first->toString(2U, 2U));
+   EXPECT_EQ("B2+$A$1", second->toString(2U, 3U));
+   EXPECT_EQ(1U, cache.size());
+
+      // The same text in a different place is a different formula.
+   std::shared_ptr<Forwards::Engine::Expression> third = cache.parse("B1+$A$1", map, logger, 2U, 3U);
+   ASSERT_NE(nullptr, third.get());
+   EXPECT_NE(first.get(), third.get());
+   EXPECT_EQ("B1+$A$1", third->toString(2U, 3U));
+   EXPECT_EQ(2U, cache.size());
+
+      // Failures aren't remembered.
+   EXPECT_EQ(nullptr, cache.parse("@FUN(B1)", map, logger, 2U, 2U).get());
+   EXPECT_EQ(2U, cache.size());
+   map.insert(std::make_pair("FUN", std::shared_ptr<Backwards::Engine::Getter>()));
+   EXPECT_NE(nullptr, cache.parse("@FUN(B1)", map, logger, 2U, 2U).get());
+   EXPECT_EQ(3U, cache.size());
+
+   cache.setBudget(3U);
+   EXPECT_NE(nullptr, cache.parse("12+13", map, logger, 2U, 2U).get());
+   EXPECT_EQ(1U, cache.size());
+ }
+
+static std::shared_ptr<Forwards::Engine::Expression> parseAt (const std::string& line, const Forwards::Engine::GetterMap& map, size_t col, size_t row)
+ {
+   Backwards::Input::StringInput string (line);
+   Forwards::Input::Lexer lexer (string);
+   StringLogger logger;
+   return Forwards::Parser::Parser::ParseFullExpression(lexer, map, logger, col, row);
+ }
+
+TEST(ParserTests, testOptimizer)
+ {
+   Forwards::Engine::GetterMap map;
+   map.insert(std::make_pair("SUM", std::shared_ptr<Backwards::Engine::Getter>()));
+   map.insert(std::make_pair("FUN", std::shared_ptr<Backwards::Engine::Getter>()));
+
+      // Constants are computed, but still print what was typed.
+   std::shared_ptr<Forwards::Engine::Expression> parse = parseAt("12*7+13/15-(12--5)", map, 1U, 1U);
+   ASSERT_NE(nullptr, parse.get());
+   EXPECT_TRUE(typeid(Forwards::Engine::Folded) == typeid(*parse.get()));
+   EXPECT_EQ("12*7+13/15-(12--5)", parse->toString(1U, 1U));
+
+   parse = parseAt("A1*(2+3)", map, 1U, 1U);
+   ASSERT_TRUE(typeid(Forwards::Engine::Multiply) == typeid(*parse.get()));
+   EXPECT_TRUE(typeid(Forwards::Engine::Folded) == typeid(*std::static_pointer_cast<Forwards::Engine::Multiply>(parse)->rhs.get()));
+   EXPECT_EQ("A1*(2+3)", parse->toString(1U, 1U));
+
+      // Errors are left for when the cell is evaluated.
+   parse = parseAt("\"a\"-1", map, 1U, 1U);
+   EXPECT_TRUE(typeid(Forwards::Engine::Minus) == typeid(*parse.get()));
+
+      // Repeats are made into one.
+   parse = parseAt("(A1+B1)*(A1+B1)-@SUM(A1:B2)/@SUM(A1:B2)", map, 1U, 1U);
+   ASSERT_TRUE(typeid(Forwards::Engine::Minus) == typeid(*parse.get()));
+   EXPECT_EQ("(A1+B1)*(A1+B1)-@SUM(A1:B2)/@SUM(A1:B2)", parse->toString(1U, 1U));
+   std::shared_ptr<Forwards::Engine::Multiply> product = std::static_pointer_cast<Forwards::Engine::Multiply>(std::static_pointer_cast<Forwards::Engine::Minus>(parse)->lhs);
+   EXPECT_TRUE(typeid(Forwards::Engine::Shared) == typeid(*product->lhs.get()));
+   EXPECT_EQ(product->lhs.get(), product->rhs.get());
+   std::shared_ptr<Forwards::Engine::Divide> quotient = std::static_pointer_cast<Forwards::Engine::Divide>(std::static_pointer_cast<Forwards::Engine::Minus>(parse)->rhs);
+   EXPECT_TRUE(typeid(Forwards::Engine::Shared) == typeid(*quotient->lhs.get()));
+   EXPECT_EQ(quotient->lhs.get(), quotient->rhs.get());
+
+      // But not when they might differ: functions we don't know, names, and different cells.
+   parse = parseAt("@FUN(A1)+@FUN(A1)", map, 1U, 1U);
+   EXPECT_NE(std::static_pointer_cast<Forwards::Engine::Plus>(parse)->lhs.get(), std::static_pointer_cast<Forwards::Engine::Plus>(parse)->rhs.get());
+   parse = parseAt("-_X*-_X", map, 1U, 1U);
+   EXPECT_NE(std::static_pointer_cast<Forwards::Engine::Multiply>(parse)->lhs.get(), std::static_pointer_cast<Forwards::Engine::Multiply>(parse)->rhs.get());
+   parse = parseAt("-A1*-$A1*-A$1", map, 1U, 1U);
+   EXPECT_TRUE(typeid(Forwards::Engine::Negate) == typeid(*std::static_pointer_cast<Forwards::Engine::Multiply>(parse)->rhs.get()));
+   parse = parseAt("-A1*-A2", map, 1U, 1U);
+   EXPECT_NE(std::static_pointer_cast<Forwards::Engine::Multiply>(parse)->lhs.get(), std::static_pointer_cast<Forwards::Engine::Multiply>(parse)->rhs.get());
+ }
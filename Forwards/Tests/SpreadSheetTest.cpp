@@ -36,8 +36,13 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "Forwards/Engine/SpreadSheet.h"
 #include "Forwards/Engine/Cell.h"
 #include "Forwards/Engine/MemorySpreadSheet.h"
+#include "Forwards/Engine/CellRangeExpand.h"
+#include "Forwards/Engine/CellRefEval.h"
+#include "Forwards/Engine/StdLib.h"
+#include "Forwards/Engine/Compiled.h"
 
 #include "Forwards/Parser/StringLogger.h"
+#include "Forwards/Parser/ContextBuilder.h"
 
 #include "Forwards/Types/FloatValue.h"
 #include "Forwards/Types/StringValue.h"
@@ -45,10 +50,17 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "Forwards/Types/CellRefValue.h"
 #include "Forwards/Types/CellRangeValue.h"
 
+#include "Backwards/Types/FloatValue.h"
+#include "Backwards/Types/StringValue.h"
+#include "Backwards/Types/CellRefValue.h"
+#include "Backwards/Types/CellRangeValue.h"
+
 #include "Backwards/Engine/FatalException.h"
 #include "Backwards/Engine/Logger.h"
 #include "Backwards/Engine/ProgrammingException.h"
 #include "Backwards/Engine/Statement.h"
+#include "Backwards/Engine/FunctionContext.h"
+#include "Backwards/Engine/StackFrame.h"
 
 #include "Backwards/Input/Lexer.h"
 #include "Backwards/Input/LineBufferedStreamInput.h"
@@ -613,3 +625,593 @@ TEST(EngineTests, testSpreadSheet_ClearRowColumn)
    shet.commitCell(nullptr);
    shet.dispose(nullptr);
  }
+
+TEST(EngineTests, testSpreadSheet_Update)
+ {
+   Forwards::Engine::CallingContext context;
+   Forwards::Engine::SpreadSheet shet;
+   context.theSheet = &shet;
+   Forwards::Engine::MemorySpreadSheet backing;
+   shet.currentSheet = &backing;
+   Forwards::Engine::NameMap names;
+   context.names = &names;
+
+   shet.initCellAt(0U, 0U);
+   shet.initCellAt(0U, 1U);
+   shet.initCellAt(0U, 2U);
+   shet.initCellAt(1U, 0U);
+   shet.initCellAt(1U, 1U);
+
+   Forwards::Engine::Cell* cell = shet.getCellAt(0U, 0U, "");
+   cell->type = Forwards::Engine::VALUE;
+   cell->currentInput = "1";
+   cell = shet.getCellAt(0U, 1U, "");
+   cell->type = Forwards::Engine::VALUE;
+   cell->currentInput = "A0 + 1";
+   cell = shet.getCellAt(0U, 2U, "");
+   cell->type = Forwards::Engine::VALUE;
+   cell->currentInput = "A1 * 2";
+   cell = shet.getCellAt(1U, 0U, "");
+   cell->type = Forwards::Engine::VALUE;
+   cell->currentInput = "5";
+   cell = shet.getCellAt(1U, 1U, "");
+   cell->type = Forwards::Engine::VALUE;
+   cell->currentInput = "B0 * 2";
+
+      // The first update doesn't know anything, so it must do everything.
+   shet.update(context);
+
+   cell = shet.getCellAt(0U, 2U, "");
+   ASSERT_TRUE(typeid(Forwards::Types::FloatValue) == typeid(*cell->previousValue.get()));
+   EXPECT_EQ(*NumberSystem::getCurrentNumberSystem().fromString("4"), *std::dynamic_pointer_cast<Forwards::Types::FloatValue>(cell->previousValue)->value);
+   cell = shet.getCellAt(1U, 1U, "");
+   ASSERT_TRUE(typeid(Forwards::Types::FloatValue) == typeid(*cell->previousValue.get()));
+   EXPECT_EQ(*NumberSystem::getCurrentNumberSystem().fromString("10"), *std::dynamic_pointer_cast<Forwards::Types::FloatValue>(cell->previousValue)->value);
+   size_t untouched = cell->previousGeneration;
+
+      // Change A0: A1 and A2 change, B doesn't get computed.
+   cell = shet.getCellAt(0U, 0U, "");
+   cell->currentInput = "10";
+   cell->value.reset();
+   shet.commitCell(cell);
+   shet.update(context);
+
+   cell = shet.getCellAt(0U, 2U, "");
+   ASSERT_TRUE(typeid(Forwards::Types::FloatValue) == typeid(*cell->previousValue.get()));
+   EXPECT_EQ(*NumberSystem::getCurrentNumberSystem().fromString("22"), *std::dynamic_pointer_cast<Forwards::Types::FloatValue>(cell->previousValue)->value);
+   EXPECT_NE(untouched, cell->previousGeneration);
+   cell = shet.getCellAt(1U, 1U, "");
+   EXPECT_EQ(untouched, cell->previousGeneration);
+
+      // Change A1 to no longer read A0: changing A0 no longer affects A2.
+   cell = shet.getCellAt(0U, 1U, "");
+   cell->currentInput = "3";
+   cell->value.reset();
+   shet.commitCell(cell);
+   shet.update(context);
+
+   cell = shet.getCellAt(0U, 2U, "");
+   ASSERT_TRUE(typeid(Forwards::Types::FloatValue) == typeid(*cell->previousValue.get()));
+   EXPECT_EQ(*NumberSystem::getCurrentNumberSystem().fromString("6"), *std::dynamic_pointer_cast<Forwards::Types::FloatValue>(cell->previousValue)->value);
+   untouched = cell->previousGeneration;
+
+   cell = shet.getCellAt(0U, 0U, "");
+   cell->currentInput = "7";
+   cell->value.reset();
+   shet.commitCell(cell);
+   shet.update(context);
+
+   cell = shet.getCellAt(0U, 2U, "");
+   EXPECT_EQ(untouched, cell->previousGeneration);
+
+      // Clearing the row that B0 is on recomputes B1.
+   shet.clearRow(0U);
+   shet.update(context);
+
+   cell = shet.getCellAt(1U, 1U, "");
+   ASSERT_TRUE(typeid(Forwards::Types::FloatValue) == typeid(*cell->previousValue.get())); // Nil * 2 is 0
+   EXPECT_EQ(*NumberSystem::getCurrentNumberSystem().fromString("0"), *std::dynamic_pointer_cast<Forwards::Types::FloatValue>(cell->previousValue)->value);
+   cell = shet.getCellAt(0U, 2U, "");
+   EXPECT_EQ(untouched, cell->previousGeneration);
+ }
+
+TEST(EngineTests, testSpreadSheet_PresentCells)
+ {
+   Forwards::Engine::MemorySpreadSheet backing;
+   backing.initCellAt(0U, 0U);
+   backing.initCellAt(0U, 900U);
+   backing.initCellAt(2U, 1U);
+
+   std::unique_ptr<Forwards::Engine::CellCursor> cursor = backing.getPresentCells(true, true, true);
+   size_t col, row;
+   ASSERT_TRUE(cursor->next(col, row));
+   EXPECT_EQ(0U, col);
+   EXPECT_EQ(0U, row);
+   ASSERT_TRUE(cursor->next(col, row));
+   EXPECT_EQ(0U, col);
+   EXPECT_EQ(900U, row);
+   ASSERT_TRUE(cursor->next(col, row));
+   EXPECT_EQ(2U, col);
+   EXPECT_EQ(1U, row);
+   EXPECT_FALSE(cursor->next(col, row));
+
+   cursor = backing.getPresentCells(false, false, false);
+   ASSERT_TRUE(cursor->next(col, row));
+   EXPECT_EQ(0U, col);
+   EXPECT_EQ(900U, row);
+   ASSERT_TRUE(cursor->next(col, row));
+   EXPECT_EQ(2U, col);
+   EXPECT_EQ(1U, row);
+   ASSERT_TRUE(cursor->next(col, row));
+   EXPECT_EQ(0U, col);
+   EXPECT_EQ(0U, row);
+   EXPECT_FALSE(cursor->next(col, row));
+
+   cursor = backing.getPresentCellsIn(0U, 1U, 5U, 900U);
+   ASSERT_TRUE(cursor->next(col, row));
+   EXPECT_EQ(0U, col);
+   EXPECT_EQ(900U, row);
+   ASSERT_TRUE(cursor->next(col, row));
+   EXPECT_EQ(2U, col);
+   EXPECT_EQ(1U, row);
+   EXPECT_FALSE(cursor->next(col, row));
+
+   cursor = backing.getPresentCellsIn(1U, 0U, 1U, 1000U);
+   EXPECT_FALSE(cursor->next(col, row));
+ }
+
+static void fillChains(Forwards::Engine::SpreadSheet& shet)
+ {
+      // Column A counts up, column B doubles what is beside it, and column C reads backwards up column A.
+   for (size_t row = 0U; row < 64U; ++row)
+    {
+      for (size_t col = 0U; col < 3U; ++col)
+       {
+         shet.initCellAt(col, row);
+         Forwards::Engine::Cell* cell = shet.getCellAt(col, row, "");
+         cell->type = Forwards::Engine::VALUE;
+         switch (col)
+          {
+         case 0U:
+            cell->currentInput = (0U == row) ? "1" : ("A" + std::to_string(row - 1U) + " + 1");
+            break;
+         case 1U:
+            cell->currentInput = "A" + std::to_string(row) + " * 2";
+            break;
+         default:
+            cell->currentInput = "B" + std::to_string(row) + " + A" + std::to_string(63U - row);
+            break;
+          }
+       }
+    }
+ }
+
+TEST(EngineTests, testSpreadSheet_Threads)
+ {
+   Forwards::Engine::CallingContext context;
+   Forwards::Engine::NameMap names;
+   context.names = &names;
+
+   Forwards::Engine::SpreadSheet serial;
+   Forwards::Engine::MemorySpreadSheet serialBacking;
+   serial.currentSheet = &serialBacking;
+   fillChains(serial);
+   context.theSheet = &serial;
+   serial.recalc(context);
+
+   Forwards::Engine::SpreadSheet parallel;
+   Forwards::Engine::MemorySpreadSheet parallelBacking;
+   parallel.currentSheet = &parallelBacking;
+   parallel.threads = 4U;
+   fillChains(parallel);
+   context.theSheet = &parallel;
+
+      // The first recalc doesn't know what reads what; the second one does.
+   for (size_t pass = 0U; pass < 2U; ++pass)
+    {
+      parallel.recalc(context);
+      for (size_t row = 0U; row < 64U; ++row)
+       {
+         for (size_t col = 0U; col < 3U; ++col)
+          {
+            Forwards::Engine::Cell* expected = serial.getCellAt(col, row, "");
+            Forwards::Engine::Cell* actual = parallel.getCellAt(col, row, "");
+            ASSERT_TRUE(typeid(Forwards::Types::FloatValue) == typeid(*actual->previousValue.get()));
+            EXPECT_EQ(*std::dynamic_pointer_cast<Forwards::Types::FloatValue>(expected->previousValue)->value,
+               *std::dynamic_pointer_cast<Forwards::Types::FloatValue>(actual->previousValue)->value);
+          }
+       }
+    }
+
+      // The graph it built is good for an update.
+   Forwards::Engine::Cell* cell = parallel.getCellAt(0U, 0U, "");
+   cell->currentInput = "2";
+   cell->value.reset();
+   parallel.commitCell(cell);
+   parallel.update(context);
+   cell = parallel.getCellAt(2U, 0U, "");
+   EXPECT_EQ(*NumberSystem::getCurrentNumberSystem().fromString("69"), *std::dynamic_pointer_cast<Forwards::Types::FloatValue>(cell->previousValue)->value);
+ }
+
+static void fillErrors(Forwards::Engine::SpreadSheet& shet, bool later)
+ {
+      // Columns B and E fail. Column C reads a failed cell computed before it, and column D (if later) one computed after it.
+   const char* const formulas [] = { nullptr, "A# * 2", "B# * 2 + 1", later ? "E# * 2 + 1" : "C# * 2", "A# * 2" };
+   for (size_t row = 0U; row < 128U; ++row)
+    {
+      for (size_t col = 0U; col < 5U; ++col)
+       {
+         shet.initCellAt(col, row);
+         Forwards::Engine::Cell* cell = shet.getCellAt(col, row, "");
+         if (nullptr == formulas[col])
+          {
+            cell->type = Forwards::Engine::LABEL;
+            cell->currentInput = "x";
+          }
+         else
+          {
+            cell->type = Forwards::Engine::VALUE;
+            cell->currentInput = formulas[col];
+            cell->currentInput.replace(cell->currentInput.find('#'), 1U, std::to_string(row));
+          }
+       }
+    }
+ }
+
+TEST(EngineTests, testSpreadSheet_ThreadsWithErrors)
+ {
+   Forwards::Engine::CallingContext context;
+   Forwards::Parser::StringLogger logger;
+   context.logger = &logger;
+   Forwards::Engine::NameMap names;
+   context.names = &names;
+
+      // Without column D reading a later failure, the recalc isn't redone in order.
+   for (bool later : { false, true })
+    {
+      Forwards::Engine::SpreadSheet serial;
+      Forwards::Engine::MemorySpreadSheet serialBacking;
+      serial.currentSheet = &serialBacking;
+      fillErrors(serial, later);
+      context.theSheet = &serial;
+      serial.recalc(context);
+
+      Forwards::Engine::SpreadSheet parallel;
+      Forwards::Engine::MemorySpreadSheet parallelBacking;
+      parallel.currentSheet = &parallelBacking;
+      parallel.threads = 4U;
+      fillErrors(parallel, later);
+      context.theSheet = &parallel;
+
+         // A failure is only seen by whoever reads the cell before it is computed in order.
+      for (size_t pass = 0U; pass < 4U; ++pass)
+       {
+         parallel.recalc(context);
+         for (size_t row = 0U; row < 128U; ++row)
+          {
+            for (size_t col = 1U; col < 5U; ++col)
+             {
+               const std::shared_ptr<Forwards::Types::ValueType>& expected = serial.getCellAt(col, row, "")->previousValue;
+               const std::shared_ptr<Forwards::Types::ValueType>& actual = parallel.getCellAt(col, row, "")->previousValue;
+               ASSERT_EQ(nullptr == expected.get(), nullptr == actual.get()) << pass << " " << col << " " << row;
+               if (nullptr != expected.get())
+                {
+                  EXPECT_EQ(expected->toString(col, row, false), actual->toString(col, row, false)) << pass << " " << col << " " << row;
+                }
+             }
+          }
+       }
+      ASSERT_TRUE(nullptr != serial.getCellAt(2U, 0U, "")->previousValue.get());
+      EXPECT_EQ(later, nullptr == serial.getCellAt(3U, 0U, "")->previousValue.get());
+    }
+ }
+
+TEST(EngineTests, testSpreadSheet_ThreadsWithGlobals)
+ {
+   Forwards::Engine::CallingContext context;
+   Forwards::Parser::StringLogger logger;
+   context.logger = &logger;
+   Forwards::Engine::SpreadSheet shet;
+   context.theSheet = &shet;
+   Forwards::Engine::MemorySpreadSheet backing;
+   shet.currentSheet = &backing;
+   Forwards::Engine::NameMap names;
+   context.names = &names;
+
+   Backwards::Engine::Scope global;
+   context.globalScope = &global;
+   Forwards::Parser::ContextBuilder::createGlobalScope(global);
+   Backwards::Parser::GetterSetter gs;
+   Backwards::Parser::SymbolTable table (gs, global);
+   Forwards::Engine::GetterMap map;
+   context.map = &map;
+
+   Backwards::Input::StringInput tick ("set count to 0 set TICK to function (x) is set count to count + 1 return count end");
+   Backwards::Input::Lexer lexer (tick, "TICK");
+   std::shared_ptr<Backwards::Engine::Statement> lib = Backwards::Parser::Parser::ParseFunctions(lexer, table, logger);
+   ASSERT_NE(nullptr, lib.get());
+   lib->execute(context);
+   map.insert(std::make_pair("TICK", table.getVariableGetter("TICK")));
+
+   for (size_t row = 0U; row < 64U; ++row)
+    {
+      shet.initCellAt(0U, row);
+      Forwards::Engine::Cell* cell = shet.getCellAt(0U, row, "");
+      cell->type = Forwards::Engine::VALUE;
+      cell->currentInput = "@TICK(1)";
+    }
+
+      // Each cell writes a global that the next one reads, so the cells must count up in order.
+   for (size_t threads = 1U; threads <= 4U; threads += 3U)
+    {
+      shet.threads = threads;
+      ++context.generation;
+      shet.recalc(context);
+
+      std::shared_ptr<Forwards::Types::FloatValue> first = std::dynamic_pointer_cast<Forwards::Types::FloatValue>(shet.getCellAt(0U, 0U, "")->previousValue);
+      ASSERT_NE(nullptr, first.get());
+      for (size_t row = 1U; row < 64U; ++row)
+       {
+         std::shared_ptr<Forwards::Types::FloatValue> value = std::dynamic_pointer_cast<Forwards::Types::FloatValue>(shet.getCellAt(0U, row, "")->previousValue);
+         ASSERT_NE(nullptr, value.get());
+         EXPECT_EQ(*NumberSystem::getCurrentNumberSystem().fromString(std::to_string(row)), *(*value->value - *first->value));
+       }
+    }
+ }
+
+TEST(EngineTests, testSpreadSheet_RangeValues)
+ {
+   Forwards::Engine::CallingContext context;
+   Forwards::Engine::SpreadSheet shet;
+   context.theSheet = &shet;
+   Forwards::Engine::MemorySpreadSheet backing;
+   shet.currentSheet = &backing;
+   Forwards::Engine::NameMap names;
+   context.names = &names;
+
+      // A0 = 1, B0 = 2, A1 = 3, B1 = 4
+   for (size_t row = 0U; row < 2U; ++row)
+    {
+      for (size_t col = 0U; col < 2U; ++col)
+       {
+         shet.initCellAt(col, row);
+         Forwards::Engine::Cell* cell = shet.getCellAt(col, row, "");
+         cell->type = Forwards::Engine::VALUE;
+         cell->currentInput = std::to_string(row * 2U + col + 1U);
+       }
+    }
+   shet.recalc(context);
+
+   Forwards::Engine::CellRangeExpand range (std::make_shared<Forwards::Types::CellRangeValue>(0U, 0U, 1U, 1U, ""));
+   std::string seen;
+   Forwards::Engine::CellRangeExpand::Visitor visitor = [&seen](const std::shared_ptr<Backwards::Types::ValueType>& value)
+    {
+      ASSERT_TRUE(typeid(Backwards::Types::FloatValue) == typeid(*value.get()));
+      seen += std::static_pointer_cast<Backwards::Types::FloatValue>(value)->value->toString();
+    };
+
+   range.forEachValue(context, true, visitor);
+   EXPECT_EQ("1324", seen);
+   seen.clear();
+   range.forEachValue(context, false, visitor);
+   EXPECT_EQ("1234", seen);
+
+      // A cell from a range evaluates like any other reference.
+   std::shared_ptr<Backwards::Types::ValueType> res = range.getIndex(1U);
+   ASSERT_TRUE(typeid(Backwards::Types::CellRangeValue) == typeid(*res.get()));
+   res = std::static_pointer_cast<Backwards::Types::CellRangeValue>(res)->getIndex(0U);
+   ASSERT_TRUE(typeid(Backwards::Types::CellRefValue) == typeid(*res.get()));
+   res = std::static_pointer_cast<Forwards::Engine::CellRefEval>(std::static_pointer_cast<Backwards::Types::CellRefValue>(res)->value)->evaluate(context);
+   ASSERT_TRUE(typeid(Backwards::Types::FloatValue) == typeid(*res.get()));
+   EXPECT_EQ(*NumberSystem::getCurrentNumberSystem().fromString("2"), *std::static_pointer_cast<Backwards::Types::FloatValue>(res)->value);
+ }
+
+TEST(EngineTests, testSpreadSheet_Aggregates)
+ {
+   Forwards::Engine::CallingContext context;
+   Forwards::Parser::StringLogger logger;
+   context.logger = &logger;
+   Forwards::Engine::SpreadSheet shet;
+   context.theSheet = &shet;
+   Forwards::Engine::MemorySpreadSheet backing;
+   shet.currentSheet = &backing;
+   Forwards::Engine::NameMap names;
+   context.names = &names;
+
+   Backwards::Engine::Scope global;
+   context.globalScope = &global;
+   Forwards::Parser::ContextBuilder::createGlobalScope(global);
+   Backwards::Parser::GetterSetter gs;
+   Backwards::Parser::SymbolTable table (gs, global);
+   Forwards::Engine::GetterMap map;
+   context.map = &map;
+   for (const std::string& name : global.names)
+    {
+      std::string temp = name;
+      std::transform(temp.begin(), temp.end(), temp.begin(), [](unsigned char c){ return std::toupper(c); });
+      if (name == temp)
+       {
+         map.insert(std::make_pair(name, table.getVariableGetter(name)));
+       }
+    }
+
+   const char* const inputs [][2] = {
+      { "A0", "1" }, { "A2", "3" }, { "A5", "5" }, { "C0", "2" }, { "C1", "4" }, { "D1", "6" },
+      { "B0", "@SUM(A0:A9)" }, { "B1", "@COUNT(A0:A9)" }, { "B2", "@MAX(A0:A9;10)" }, { "B3", "@MIN(A0:A9)" },
+      { "B4", "@AVERAGE(A0:A9)" }, { "B5", "@MAX(E0:E9)" }, { "B6", "@SUM(C0:D1;A0)" }, { "B7", "@COUNT(A1)" }
+    };
+   for (const auto& input : inputs)
+    {
+      size_t col = input[0][0] - 'A';
+      size_t row = input[0][1] - '0';
+      shet.initCellAt(col, row);
+      Forwards::Engine::Cell* cell = shet.getCellAt(col, row, "");
+      cell->type = Forwards::Engine::VALUE;
+      cell->currentInput = input[1];
+    }
+      // Labels are skipped.
+   shet.initCellAt(0U, 1U);
+   shet.getCellAt(0U, 1U, "")->type = Forwards::Engine::LABEL;
+   shet.getCellAt(0U, 1U, "")->currentInput = "12";
+
+   const char* const expected [] = { "9", "3", "10", "1", "3", nullptr, "13", "0" };
+
+      // The same answers when the cells are computed in parallel.
+   for (size_t threads = 1U; threads <= 4U; threads += 3U)
+    {
+      shet.threads = threads;
+      ++context.generation;
+      shet.recalc(context);
+
+      for (size_t row = 0U; row < 8U; ++row)
+       {
+         const std::shared_ptr<Forwards::Types::ValueType>& value = shet.getCellAt(1U, row, "")->previousValue;
+         if (nullptr == expected[row])
+          {
+            ASSERT_TRUE(typeid(Forwards::Types::StringValue) == typeid(*value.get()));
+            EXPECT_EQ("Empty", std::dynamic_pointer_cast<Forwards::Types::StringValue>(value)->value);
+          }
+         else
+          {
+            ASSERT_TRUE(typeid(Forwards::Types::FloatValue) == typeid(*value.get()));
+            EXPECT_EQ(*NumberSystem::getCurrentNumberSystem().fromString(expected[row]), *std::dynamic_pointer_cast<Forwards::Types::FloatValue>(value)->value);
+          }
+       }
+    }
+
+      // Each argument must be a collection.
+   Backwards::Engine::StandardUnaryFunctionWithContext sum (Forwards::Engine::Sum);
+   std::shared_ptr<Backwards::Engine::FunctionContext> func = std::make_shared<Backwards::Engine::FunctionContext>();
+   func->nargs = 1;
+   func->nlocals = 0;
+   Backwards::Engine::StackFrame frame (func, Backwards::Input::Token(), nullptr);
+   context.pushContext(&frame);
+   frame.args[0] = std::make_shared<Backwards::Types::StringValue>("hello");
+   EXPECT_THROW(sum.execute(context), Backwards::Types::TypedOperationException);
+   context.popContext();
+ }
+
+TEST(EngineTests, testSpreadSheet_Compiled)
+ {
+   Forwards::Engine::CallingContext context;
+   Forwards::Parser::StringLogger logger;
+   context.logger = &logger;
+   Forwards::Engine::SpreadSheet shet;
+   context.theSheet = &shet;
+   Forwards::Engine::MemorySpreadSheet backing;
+   shet.currentSheet = &backing;
+   Forwards::Engine::NameMap names;
+   context.names = &names;
+   Forwards::Engine::GetterMap map;
+   context.map = &map;
+
+   shet.initCellAt(0U, 0U);
+   shet.getCellAt(0U, 0U, "")->type = Forwards::Engine::VALUE;
+   shet.getCellAt(0U, 0U, "")->currentInput = "3";
+   shet.initCellAt(0U, 1U);
+   shet.getCellAt(0U, 1U, "")->type = Forwards::Engine::LABEL;
+   shet.getCellAt(0U, 1U, "")->currentInput = "hi";
+   shet.initCellAt(1U, 0U);
+   Forwards::Engine::Cell* cell = shet.getCellAt(1U, 0U, "");
+   cell->type = Forwards::Engine::VALUE;
+
+      // A0 is 3, A1 is a label, and A2 is empty.
+   const char* const formulas [] = {
+      "A0+1", "A0-A2", "-A0*2", "A0/4", "A2/A0", "A0/A2", "A2-A0",
+      "A0=3", "A0<>3", "A0>A2", "A2<A0", "A0>=3", "A0<=2", "A1=A2", "A1>A2",
+      "A1&A0", "A0&A2", "A2&A2", "$A$0*A$0+$A0",
+      "A0-(A0-(A0-(A0-(A0-(A0-(A0-(A0-(A0-(A0-1)))))))))",
+      "A0+A1", "A1*2", "-A1", "2<A1", "A0:A1"
+    };
+
+   for (const char* formula : formulas)
+    {
+      std::shared_ptr<Forwards::Types::ValueType> expected, actual;
+
+      shet.compiled = false;
+      cell->value.reset();
+      cell->currentInput = formula;
+      ++context.generation;
+      std::string expectedMessage = shet.computeCell(context, expected, 1U, 0U);
+      std::string expectedText = cell->value->toString(1U, 0U);
+
+      shet.compiled = true;
+      cell->value.reset();
+      cell->currentInput = formula;
+      ++context.generation;
+      std::string actualMessage = shet.computeCell(context, actual, 1U, 0U);
+
+      EXPECT_EQ(expectedMessage, actualMessage) << formula;
+      ASSERT_EQ(nullptr == expected.get(), nullptr == actual.get()) << formula;
+      if (nullptr != expected.get())
+       {
+         EXPECT_EQ(expected->getType(), actual->getType()) << formula;
+         EXPECT_EQ(expected->toString(1U, 0U, false), actual->toString(1U, 0U, false)) << formula;
+       }
+      EXPECT_EQ(expectedText, cell->value->toString(1U, 0U)) << formula;
+    }
+
+      // Compiling is only worth it with something to compute.
+   cell->value.reset();
+   cell->currentInput = "A0*2";
+   ++context.generation;
+   shet.computeCell(context, 1U, 0U, false);
+   EXPECT_TRUE(typeid(Forwards::Engine::Compiled) == typeid(*cell->value.get()));
+   cell->value.reset();
+   cell->currentInput = "12";
+   ++context.generation;
+   shet.computeCell(context, 1U, 0U, false);
+   EXPECT_TRUE(typeid(Forwards::Engine::Constant) == typeid(*cell->value.get()));
+ }
+
+TEST(EngineTests, testSpreadSheet_Optimized)
+ {
+   Forwards::Engine::CallingContext context;
+   Forwards::Parser::StringLogger logger;
+   context.logger = &logger;
+   Forwards::Engine::SpreadSheet shet;
+   context.theSheet = &shet;
+   Forwards::Engine::MemorySpreadSheet backing;
+   shet.currentSheet = &backing;
+   Forwards::Engine::NameMap names;
+   context.names = &names;
+
+   Backwards::Engine::Scope global;
+   context.globalScope = &global;
+   Forwards::Parser::ContextBuilder::createGlobalScope(global);
+   Backwards::Parser::GetterSetter gs;
+   Backwards::Parser::SymbolTable table (gs, global);
+   Forwards::Engine::GetterMap map;
+   context.map = &map;
+   map.insert(std::make_pair("SUM", table.getVariableGetter("SUM")));
+
+   const char* const inputs [][2] = {
+      { "A0", "9" }, { "A1", "6" }, { "B0", "9/6" }, { "B1", "(A0+A1)*(A0+A1)+@SUM(A0:A1)-@SUM(A0:A1)*A1" }
+    };
+   for (const auto& input : inputs)
+    {
+      size_t col = input[0][0] - 'A';
+      size_t row = input[0][1] - '0';
+      shet.initCellAt(col, row);
+      Forwards::Engine::Cell* cell = shet.getCellAt(col, row, "");
+      cell->type = Forwards::Engine::VALUE;
+      cell->currentInput = input[1];
+    }
+
+   shet.recalc(context);
+
+   Forwards::Engine::Cell* cell = shet.getCellAt(1U, 1U, "");
+   ASSERT_TRUE(typeid(Forwards::Types::FloatValue) == typeid(*cell->previousValue.get()));
+   EXPECT_EQ(*NumberSystem::getCurrentNumberSystem().fromString("150"), *std::dynamic_pointer_cast<Forwards::Types::FloatValue>(cell->previousValue)->value);
+   EXPECT_EQ("(A0+A1)*(A0+A1)+@SUM(A0:A1)-@SUM(A0:A1)*A1", cell->value->toString(1U, 1U));
+
+      // A folded constant follows the precision it is evaluated under, not the one it was parsed under.
+   cell = shet.getCellAt(1U, 0U, "");
+   ASSERT_TRUE(typeid(Forwards::Engine::Folded) == typeid(*cell->value.get()));
+   size_t precision = NumberSystem::getCurrentNumberSystem().getDefaultPrecision();
+   NumberSystem::getCurrentNumberSystem().setDefaultPrecision(1U);
+   shet.recalc(context);
+   NumberSystem::getCurrentNumberSystem().setDefaultPrecision(precision);
+   ASSERT_TRUE(typeid(Forwards::Types::FloatValue) == typeid(*cell->previousValue.get()));
+   EXPECT_EQ(*NumberSystem::getCurrentNumberSystem().fromString("1.5"), *std::dynamic_pointer_cast<Forwards::Types::FloatValue>(cell->previousValue)->value);
+ }
@@ -38,6 +38,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "Forwards/Types/NilValue.h"
 #include "Forwards/Types/CellRefValue.h"
 #include "Forwards/Types/CellRangeValue.h"
+#include "Forwards/Types/Serialization.h"
+#include "Forwards/Types/Value.h"
 
 #include "NumberSystem.h"
 
@@ -187,3 +189,96 @@ TEST(TypesTests, testCellRange)
    Forwards::Types::CellRangeValue bob (1, 1, 2, 2, "bob");
    EXPECT_EQ("B1:C2!bob", bob.toString(1U, 1U, false));
  }
+
+TEST(TypesTests, testSerialization)
+ {
+   Forwards::Types::FloatValue number (NumberSystem::getCurrentNumberSystem().fromString("-12.5"));
+   Forwards::Types::StringValue text (std::string("Hello\0World", 11U));
+   Forwards::Types::NilValue nil;
+   Forwards::Types::CellRefValue ref (true, 5, false, -3, "bob");
+   Forwards::Types::CellRangeValue range (1, 2, 3, 4, "");
+
+   std::shared_ptr<Forwards::Types::ValueType> result = Forwards::Types::deserialize(Forwards::Types::serialize(number));
+   ASSERT_NE(nullptr, result.get());
+   ASSERT_EQ(Forwards::Types::FLOAT, result->getType());
+   EXPECT_EQ(number.toString(0U, 0U, true), result->toString(0U, 0U, true));
+   EXPECT_TRUE(number.value->equal(*std::static_pointer_cast<Forwards::Types::FloatValue>(result)->value));
+
+   result = Forwards::Types::deserialize(Forwards::Types::serialize(text));
+   ASSERT_NE(nullptr, result.get());
+   ASSERT_EQ(Forwards::Types::STRING, result->getType());
+   EXPECT_EQ(text.value, std::static_pointer_cast<Forwards::Types::StringValue>(result)->value);
+
+   result = Forwards::Types::deserialize(Forwards::Types::serialize(nil));
+   ASSERT_NE(nullptr, result.get());
+   EXPECT_EQ(Forwards::Types::NIL, result->getType());
+
+   result = Forwards::Types::deserialize(Forwards::Types::serialize(ref));
+   ASSERT_NE(nullptr, result.get());
+   ASSERT_EQ(Forwards::Types::CELL_REF, result->getType());
+   EXPECT_EQ(ref.toString(10U, 10U, false), result->toString(10U, 10U, false));
+
+   result = Forwards::Types::deserialize(Forwards::Types::serialize(range));
+   ASSERT_NE(nullptr, result.get());
+   ASSERT_EQ(Forwards::Types::CELL_RANGE, result->getType());
+   EXPECT_EQ(range.toString(0U, 0U, false), result->toString(0U, 0U, false));
+
+      // Garbage, or a truncated value, fails instead of making something up.
+   EXPECT_EQ(nullptr, Forwards::Types::deserialize("").get());
+   EXPECT_EQ(nullptr, Forwards::Types::deserialize("12.5").get());
+   std::string truncated = Forwards::Types::serialize(text);
+   truncated.pop_back();
+   EXPECT_EQ(nullptr, Forwards::Types::deserialize(truncated).get());
+ }
+
+static void checkValues()
+ {
+   const NumberSystem& system = NumberSystem::getCurrentNumberSystem();
+   std::shared_ptr<Forwards::Types::ValueType> six = std::make_shared<Forwards::Types::FloatValue>(system.fromString("6"));
+   std::shared_ptr<Forwards::Types::ValueType> nine = std::make_shared<Forwards::Types::FloatValue>(system.fromString("9"));
+   std::shared_ptr<Forwards::Types::ValueType> nil = std::make_shared<Forwards::Types::NilValue>();
+   std::shared_ptr<Forwards::Types::ValueType> text = std::make_shared<Forwards::Types::StringValue>("9");
+
+      // Unboxing then boxing gives back the same box.
+   EXPECT_EQ(six.get(), Forwards::Types::Value(six).box().get());
+   EXPECT_EQ(nil.get(), Forwards::Types::Value(nil).box().get());
+   EXPECT_EQ(text.get(), Forwards::Types::Value(text).box().get());
+   EXPECT_EQ(Forwards::Types::FLOAT, Forwards::Types::Value(six).getType());
+   EXPECT_EQ(Forwards::Types::NIL, Forwards::Types::Value(nil).getType());
+   EXPECT_EQ(Forwards::Types::STRING, Forwards::Types::Value(text).getType());
+   EXPECT_EQ(Forwards::Types::NIL, Forwards::Types::Value().box()->getType());
+
+   Forwards::Types::Value sum, product, less, negated;
+   ASSERT_TRUE(Forwards::Types::Value::numeric(INLINE_ADD, Forwards::Types::Value(six), Forwards::Types::Value(nine), sum));
+   ASSERT_TRUE(Forwards::Types::Value::numeric(INLINE_MULTIPLY, sum, Forwards::Types::Value(six), product));
+   ASSERT_TRUE(Forwards::Types::Value::numeric(INLINE_LESS, Forwards::Types::Value(six), product, less));
+   ASSERT_TRUE(Forwards::Types::Value::negate(product, negated));
+   EXPECT_EQ("15", sum.box()->toString(0U, 0U, false));
+   EXPECT_EQ("90", product.box()->toString(0U, 0U, false));
+   EXPECT_EQ("1", less.box()->toString(0U, 0U, false));
+   EXPECT_EQ("-90", negated.box()->toString(0U, 0U, false));
+
+      // Without the system's inline math, it's done with the holders: the same answers.
+   Forwards::Types::Value held;
+   ASSERT_TRUE(Forwards::Types::Value::numericWith<NoInlineMath>(INLINE_MULTIPLY, Forwards::Types::Value(six), Forwards::Types::Value(nine), held));
+   EXPECT_EQ("54", held.box()->toString(0U, 0U, false));
+   ASSERT_TRUE(Forwards::Types::Value::numericWith<NoInlineMath>(INLINE_GREATER, Forwards::Types::Value(six), Forwards::Types::Value(nine), held));
+   EXPECT_EQ("0", held.box()->toString(0U, 0U, false));
+
+      // Only numbers are done here.
+   EXPECT_FALSE(Forwards::Types::Value::numeric(INLINE_ADD, Forwards::Types::Value(six), Forwards::Types::Value(nil), sum));
+   EXPECT_FALSE(Forwards::Types::Value::numeric(INLINE_EQUAL, Forwards::Types::Value(text), Forwards::Types::Value(nine), sum));
+   EXPECT_FALSE(Forwards::Types::Value::negate(Forwards::Types::Value(text), negated));
+ }
+
+TEST(TypesTests, testValue)
+ {
+   checkValues();
+
+   NumberSystem_System original = NumberSystem::getCurrentNumberSystem().getSystem();
+   NumberSystem::setCurrentNumberSystem(DOUBLE_NUMBER_SYSTEM);
+   checkValues();
+   NumberSystem::setCurrentNumberSystem(LIBDECMATH_NUMBER_SYSTEM);
+   checkValues();
+   NumberSystem::setCurrentNumberSystem(original);
+ }
@@ -34,11 +34,18 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "Backwards/Engine/CallingContext.h"
 
+#include <memory>
+#include <utility>
 #include <vector>
 
 namespace Forwards
  {
 
+namespace Types
+ {
+   class ValueType;
+ }
+
 namespace Engine
  {
 
@@ -56,6 +63,9 @@ namespace Engine
       Cell* cell;
       size_t col;
       size_t row;
+
+         // The values of Shared subexpressions, for this one evaluation of this cell.
+      std::vector<std::pair<const Expression*, std::shared_ptr<Types::ValueType> > > shared;
     };
 
    class CallingContext : public Backwards::Engine::CallingContext
@@ -73,6 +83,9 @@ namespace Engine
       void pushCell(CellFrame* cell);
       void popCell();
 
+         // What a cell writes to a scope may be read by any cell after it, so it makes the cell volatile.
+      virtual void writeShared() override;
+
       virtual std::shared_ptr<Backwards::Engine::CallingContext> duplicate() override; // This function exists for the debugger.
 
    private:
@@ -50,6 +50,7 @@ namespace Engine
       explicit CellRangeExpand(const std::shared_ptr<Types::CellRangeValue>&);
 
       virtual std::shared_ptr<Backwards::Types::ValueType> expand (Backwards::Engine::CallingContext&) const override;
+      virtual void forEachValue (Backwards::Engine::CallingContext&, bool byColumn, const Visitor&) const override;
       virtual std::shared_ptr<Backwards::Types::ValueType> getIndex (size_t index) const override;
       virtual size_t getSize() const override;
 
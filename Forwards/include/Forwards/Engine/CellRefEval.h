@@ -33,6 +33,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define FORWARDS_ENGINE_CELLREFEVAL_H
 
 #include "Backwards/Engine/CellRefEval.h"
+#include "Forwards/Types/ValueType.h"
 
 namespace Forwards
  {
@@ -41,17 +42,28 @@ namespace Engine
  {
 
    class Expression;
+   class CallingContext;
 
    class CellRefEval final : public Backwards::Engine::CellRefEval
     {
    public:
-      std::shared_ptr<Expression> value;
+      std::shared_ptr<Expression> value; // If null, this refers directly to the cell at col, row on sheet.
+      size_t col;
+      size_t row;
+      std::string sheet;
 
       CellRefEval();
       explicit CellRefEval(const std::shared_ptr<Expression>&);
+      CellRefEval(size_t col, size_t row, const std::string& sheet);
+
+         // The expression this refers to, made if need be.
+      std::shared_ptr<Expression> getExpression() const;
 
       virtual std::shared_ptr<Backwards::Types::ValueType> evaluate (Backwards::Engine::CallingContext&) const override;
 
+         // Turns the value of a cell into the equivalent Backwards value.
+      static std::shared_ptr<Backwards::Types::ValueType> toBackwards (CallingContext&, const std::shared_ptr<Types::ValueType>&);
+
       virtual bool equal (const Backwards::Types::CellRefValue& lhs) const override;
       virtual bool notEqual (const Backwards::Types::CellRefValue& lhs) const override;
       virtual bool sort (const Backwards::Types::CellRefValue& lhs) const override;
@@ -0,0 +1,117 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2023, Thomas DiModica
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef FORWARDS_ENGINE_COMPILED_H
+#define FORWARDS_ENGINE_COMPILED_H
+
+#include "Forwards/Engine/Expression.h"
+
+#include <vector>
+#include <cstdint>
+
+namespace Forwards
+ {
+
+namespace Engine
+ {
+
+   /*
+      A formula compiled to code for a little stack machine.
+
+      The tree evaluator goes through two virtual calls per operator. Here, the operators are a
+      loop over an array, and cell references are resolved from their offsets without going
+      through a Constant. The stack holds Values and the work is done by the operators' apply,
+      which is what the tree uses, so the results and the error messages are the same.
+      Function calls, names, ranges and moved references are evaluated as trees: a function's
+      arguments have to be trees anyway. The machine is compiled once for each way of doing math
+      on numbers, and evaluate picks the one for the current number system, so that the math of
+      the systems that keep numbers in 64 bits is inlined into the loop.
+   */
+   class Compiled final : public Expression
+    {
+   public:
+      std::shared_ptr<Expression> tree; // What was compiled: the reference, and what we print.
+
+      explicit Compiled(const std::shared_ptr<Expression>&);
+
+         // Returns the tree itself if there's nothing to gain from compiling it.
+      static std::shared_ptr<Expression> compile(const std::shared_ptr<Expression>&);
+
+      std::shared_ptr<Types::ValueType> evaluate (CallingContext&) const override;
+      std::string toString(size_t, size_t, int) const override;
+
+   private:
+      enum OpCode : uint8_t
+       {
+         PUSH, // Push a constant.
+         LOAD, // Push the value of a cell.
+         EVAL, // Push the value of a tree.
+         ADD,
+         SUB,
+         MUL,
+         DIV,
+         CAT,
+         EQ,
+         NE,
+         GT,
+         LT,
+         GE,
+         LE,
+         NEG
+       };
+
+      class Instruction final
+       {
+      public:
+         OpCode op;
+         uint32_t arg; // The constant, reference, or node it works on.
+       };
+
+      std::vector<Instruction> code;
+      std::vector<Types::Value> constants;
+      std::vector<const Types::CellRefValue*> references;
+      std::vector<const Expression*> nodes; // The trees for EVAL, and the operators, for their tokens.
+      size_t depth;
+
+      void emit(const Expression*, size_t& height);
+      void append(OpCode, size_t arg);
+
+      static Types::Value binary(OpCode, const Expression*, const Types::Value& lhs, const Types::Value& rhs);
+
+         // The machine, specialized on the number system's math: see InlineNumbers.h.
+      template <class Math> std::shared_ptr<Types::ValueType> run (CallingContext&) const;
+    };
+
+ } // namespace Engine
+
+ } // namespace Forwards
+
+#endif /* FORWARDS_ENGINE_COMPILED_H */
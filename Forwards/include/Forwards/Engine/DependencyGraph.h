@@ -0,0 +1,140 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2023, Thomas DiModica
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef FORWARDS_ENGINE_DEPENDENCYGRAPH_H
+#define FORWARDS_ENGINE_DEPENDENCYGRAPH_H
+
+#include <cstddef>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+#include <set>
+
+namespace Forwards
+ {
+
+namespace Engine
+ {
+
+   class SpreadSheetHolder;
+
+   /*
+      Records what each cell read the last time it was computed, so that an edit only
+      recomputes the cells that (transitively) read the edited cell.
+      Cells that use something we can't track (names, evaluating strings) are "volatile",
+      and their existence means that we can't trust the graph.
+   */
+   class DependencyGraph final
+    {
+   public:
+      DependencyGraph();
+      DependencyGraph(const DependencyGraph&) = delete;
+      DependencyGraph& operator=(const DependencyGraph&) = delete;
+
+      static size_t makeCellId(size_t col, size_t row);
+      static size_t getColumn(size_t id);
+      static size_t getRow(size_t id);
+
+         // Forget everything, and start tracking the given sheet.
+      void reset(SpreadSheetHolder* sheet);
+      bool isValidFor(SpreadSheetHolder* sheet) const;
+
+         // Recording reads. The reader is the cell currently being computed.
+      void forgetReads(size_t readerCol, size_t readerRow);
+      void addCell(size_t readerCol, size_t readerRow, size_t col, size_t row);
+      void addRange(size_t readerCol, size_t readerRow, size_t col1, size_t row1, size_t col2, size_t row2);
+      void addVolatile(size_t readerCol, size_t readerRow);
+      bool hasVolatile() const;
+
+         // Recording changes.
+      void markCell(size_t col, size_t row);
+      void markColumn(size_t col);
+      void markRow(size_t row);
+
+         // Determine every cell that needs to be recomputed, and treat every other cell as current until finish.
+      std::vector<size_t> beginUpdate();
+      bool isStale(size_t col, size_t row) const;
+      void finishUpdate();
+
+      class RangeRead final
+       {
+      public:
+         RangeRead(size_t col1, size_t row1, size_t col2, size_t row2) : col1(col1), row1(row1), col2(col2), row2(row2) { }
+
+         size_t col1;
+         size_t row1;
+         size_t col2;
+         size_t row2;
+       };
+
+      class Reads final
+       {
+      public:
+         std::vector<size_t> cells;
+         std::vector<RangeRead> ranges;
+       };
+
+         // What a cell read the last time it was computed, or nullptr if it read nothing (that we know of).
+      const Reads* getReads(size_t id) const;
+
+   private:
+      class RangeReader final
+       {
+      public:
+         RangeReader(size_t row1, size_t row2, size_t reader) : row1(row1), row2(row2), reader(reader) { }
+
+         size_t row1;
+         size_t row2;
+         size_t reader;
+       };
+
+      SpreadSheetHolder* sheet;
+
+      std::unordered_map<size_t, Reads> reads; // What each cell read.
+      std::unordered_map<size_t, std::unordered_set<size_t> > readers; // Who read each cell.
+      std::unordered_map<size_t, std::vector<RangeReader> > rangeReaders; // Who read a range, by column.
+      std::unordered_set<size_t> volatiles;
+
+      std::unordered_set<size_t> marked;
+      std::set<size_t> markedColumns;
+      std::set<size_t> markedRows;
+
+      bool updating;
+      std::unordered_set<size_t> stale;
+
+      void addReaders(size_t id, std::vector<size_t>& work);
+    };
+
+ } // namespace Engine
+
+ } // namespace Forwards
+
+#endif /* FORWARDS_ENGINE_DEPENDENCYGRAPH_H */
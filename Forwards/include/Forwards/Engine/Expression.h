@@ -35,8 +35,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "Forwards/Engine/CallingContext.h"
 #include "Forwards/Input/Token.h"
 #include "Forwards/Types/ValueType.h"
+#include "Forwards/Types/Value.h"
 #include "Backwards/Types/ValueType.h"
 #include "Backwards/Engine/Expression.h"
+#include "NumberSystem.h"
 
 namespace Forwards
  {
@@ -65,6 +67,9 @@ namespace Engine
       virtual std::shared_ptr<Types::ValueType> evaluate (CallingContext&) const = 0;
       virtual std::string toString(size_t, size_t, int level = 0) const = 0;
 
+         // The same, without boxing the result. Operators give numbers to each other this way.
+      virtual Types::Value evaluateValue (CallingContext&) const;
+
       static std::string constructMessage(const std::string&, const Input::Token&);
       std::string constructMessage(const std::string&) const;
 
@@ -85,6 +90,11 @@ namespace Engine
       static std::shared_ptr<Types::ValueType> finalConst(std::shared_ptr<Types::CellRefValue>, CallingContext&);
     };
 
+   /*
+      The operators are split in two: evaluate gets the operands, and apply does the work.
+      That way, something that already has the operands, like the bytecode VM, can reuse apply.
+      Numbers go through the Value form of apply, which only boxes what it can't compute itself.
+   */
 #define FFBinaryOperation(x) \
    class x final : public Expression \
     { \
@@ -93,6 +103,9 @@ namespace Engine
       x(const Input::Token&, const std::shared_ptr<Expression>&, const std::shared_ptr<Expression>&); \
       std::shared_ptr<Types::ValueType> evaluate (CallingContext&) const override; \
       std::string toString(size_t, size_t, int) const override; \
+      Types::Value evaluateValue (CallingContext&) const override; \
+      static std::shared_ptr<Types::ValueType> apply (const Input::Token&, const std::shared_ptr<Types::ValueType>&, const std::shared_ptr<Types::ValueType>&); \
+      static Types::Value apply (const Input::Token&, const Types::Value&, const Types::Value&); \
     };
 
    FFBinaryOperation(Plus)
@@ -106,7 +119,15 @@ namespace Engine
    FFBinaryOperation(GEQ)
    FFBinaryOperation(LEQ)
    FFBinaryOperation(Cat)
-   FFBinaryOperation(MakeRange)
+
+   class MakeRange final : public Expression
+    {
+   public:
+      std::shared_ptr<Expression> lhs, rhs;
+      MakeRange(const Input::Token&, const std::shared_ptr<Expression>&, const std::shared_ptr<Expression>&);
+      std::shared_ptr<Types::ValueType> evaluate (CallingContext&) const override;
+      std::string toString(size_t, size_t, int) const override;
+    };
 
 
 #define FFUnaryOperation(x) \
@@ -119,9 +140,20 @@ namespace Engine
       std::string toString(size_t, size_t, int) const override; \
     };
 
-   FFUnaryOperation(Negate)
    FFUnaryOperation(MoveReference)
 
+   class Negate final : public Expression
+    {
+   public:
+      std::shared_ptr<Expression> arg;
+      Negate(const Input::Token&, const std::shared_ptr<Expression>&);
+      std::shared_ptr<Types::ValueType> evaluate (CallingContext&) const override;
+      std::string toString(size_t, size_t, int) const override;
+      Types::Value evaluateValue (CallingContext&) const override;
+      static std::shared_ptr<Types::ValueType> apply (const Input::Token&, const std::shared_ptr<Types::ValueType>&);
+      static Types::Value apply (const Input::Token&, const Types::Value&);
+    };
+
 
 
    class FunctionCall final : public Expression
@@ -149,6 +181,41 @@ namespace Engine
     };
 
 
+   /*
+      These are made by the Optimizer, and print what the user typed.
+      Folded is a constant subtree, computed when it was parsed. If the number system's settings
+      have changed since, then the subtree is computed again.
+   */
+   class Folded final : public Expression
+    {
+   public:
+      std::shared_ptr<Expression> tree;
+      std::shared_ptr<Types::ValueType> value;
+
+      Folded(const std::shared_ptr<Expression>&, const std::shared_ptr<Types::ValueType>&);
+
+      std::shared_ptr<Types::ValueType> evaluate (CallingContext&) const override;
+      std::string toString(size_t, size_t, int) const override;
+
+   private:
+      const NumberSystem* system;
+      size_t precision;
+      NumberSystem_Round_Mode mode;
+    };
+
+      // Shared is a subtree that appears more than once in a formula: it is computed once per evaluation of the cell.
+   class Shared final : public Expression
+    {
+   public:
+      std::shared_ptr<Expression> tree;
+
+      explicit Shared(const std::shared_ptr<Expression>&);
+
+      std::shared_ptr<Types::ValueType> evaluate (CallingContext&) const override;
+      std::string toString(size_t, size_t, int) const override;
+    };
+
+
  } // namespace Engine
 
  } // namespace Forwards
@@ -75,12 +75,17 @@ namespace Engine
 
       virtual void returnCell(Cell* cell) override;
       virtual bool isCellPresent(size_t col, size_t row) override;
+      virtual std::unique_ptr<CellCursor> getPresentCells(bool c_major, bool colsAscending, bool rowsAscending) override;
+      virtual std::unique_ptr<CellCursor> getPresentCellsIn(size_t col1, size_t row1, size_t col2, size_t row2) override;
 
       virtual void makeEvergreen(Cell* cell) override;
       virtual void commitCell(Cell* cell) override;
       virtual void dispose(Cell* cell) override;
 
       virtual void stashResult(Cell* cell, size_t generation) override;
+
+      virtual void beginBatch() override;
+      virtual void endBatch() override;
     };
 
  } // namespace Engine
@@ -33,7 +33,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define FORWARDS_ENGINE_SPREADSHEET_H
 
 #include <vector>
+#include <functional>
 #include <memory>
+#include <utility>
+
+#include "Forwards/Engine/DependencyGraph.h"
 
 namespace Forwards
  {
@@ -49,6 +53,26 @@ namespace Engine
    class CallingContext;
    class Cell;
 
+      // Walks the cells that are present in a sheet, in order.
+   class CellCursor
+    {
+   public:
+      virtual ~CellCursor() { }
+      virtual bool next(size_t& col, size_t& row) = 0;
+    };
+
+      // Walks a vector of positions, for sheets that are cheap to scan up front.
+   class VectorCursor final : public CellCursor
+    {
+   public:
+      std::vector<std::pair<size_t, size_t> > cells;
+      size_t index;
+
+      VectorCursor() : index(0U) { }
+      virtual bool next(size_t& col, size_t& row) override;
+      void sort(bool c_major, bool colsAscending, bool rowsAscending);
+    };
+
    class SpreadSheetHolder
     {
    public:
@@ -65,12 +89,20 @@ namespace Engine
 
       virtual void returnCell(Cell* cell) = 0;
       virtual bool isCellPresent(size_t col, size_t row) = 0;
+         // The present cells, by column then row if c_major, else by row then column.
+      virtual std::unique_ptr<CellCursor> getPresentCells(bool c_major, bool colsAscending, bool rowsAscending) = 0;
+         // The present cells in a range, by column then row, ascending.
+      virtual std::unique_ptr<CellCursor> getPresentCellsIn(size_t col1, size_t row1, size_t col2, size_t row2) = 0;
 
       virtual void makeEvergreen(Cell* cell) = 0;
       virtual void commitCell(Cell* cell) = 0;
       virtual void dispose(Cell* cell) = 0;
 
       virtual void stashResult(Cell* cell, size_t generation) = 0;
+
+         // Brackets a recalc: writes in between may be held back until endBatch. These nest.
+      virtual void beginBatch() = 0;
+      virtual void endBatch() = 0;
     };
 
    class SpreadSheet final
@@ -90,6 +122,11 @@ namespace Engine
       bool top_down;
       bool left_right;
 
+         // How many threads recalc may use. With more than one, cells that don't read each other are computed at once.
+      size_t threads;
+         // Evaluate formulas compiled to bytecode, rather than by walking their trees. The trees are the reference.
+      bool compiled;
+
       Cell* getCellAt(size_t col, size_t row, const std::string& sheet);
       bool isCellPresent(size_t col, size_t row);
       void initCellAt(size_t col, size_t row);
@@ -107,7 +144,36 @@ namespace Engine
 
       std::string computeCell(CallingContext&, std::shared_ptr<Types::ValueType>& OUT, size_t col, size_t row);
       std::shared_ptr<Types::ValueType> computeCell(CallingContext&, size_t col, size_t row, bool rethrow);
+         // What a cell reference evaluates to: the value of the cell, computed if need be.
+      std::shared_ptr<Types::ValueType> fetchCell(CallingContext&, size_t col, size_t row, const std::string& sheet);
+         // The same, for a caller that has already recorded reading the cell, as part of a range.
+      std::shared_ptr<Types::ValueType> fetchReadCell(CallingContext&, size_t col, size_t row, const std::string& sheet);
+         // Fetch each cell in a range that has something in it, by column then row, skipping the empty ones.
+         // Like fetchReadCell, the caller records reading the range.
+      typedef std::function<void (size_t col, const std::shared_ptr<Types::ValueType>&)> PresentVisitor;
+      void fetchPresentCells(CallingContext&, size_t col1, size_t row1, size_t col2, size_t row2, const std::string& sheet, const PresentVisitor&);
       void recalc(CallingContext&);
+         // Recompute only what changed since the last recalc, if we can.
+      void update(CallingContext&);
+
+         // Called during evaluation to record what the cell being computed read.
+      void readCell(CallingContext&, size_t col, size_t row);
+      void readRange(CallingContext&, size_t col1, size_t row1, size_t col2, size_t row2);
+      void readVolatile(CallingContext&);
+
+   private:
+      DependencyGraph dependencies;
+
+      class Recalculation;
+      Recalculation* running; // The parallel recalc in progress, if there is one.
+
+      bool evaluate(CallingContext&, Cell* cell, size_t col, size_t row, bool rethrow, std::shared_ptr<Types::ValueType>& OUT, std::string& message);
+      bool recalcInParallel(CallingContext&);
+
+      bool isCurrent(CallingContext&, Cell* cell, size_t col, size_t row);
+      bool evaluatedBefore(size_t lhs, size_t rhs) const;
+      bool colsAscending() const;
+      bool rowsAscending() const;
     };
 
    class AutoCell final
@@ -119,6 +185,14 @@ namespace Engine
       ~AutoCell();
     };
 
+   class AutoBatch final
+    {
+   public:
+      SpreadSheetHolder* sheet;
+      explicit AutoBatch(SpreadSheetHolder*);
+      ~AutoBatch();
+    };
+
  } // namespace Engine
 
  } // namespace Forwards
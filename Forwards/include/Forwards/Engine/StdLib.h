@@ -47,6 +47,12 @@ namespace Engine
 
    STDLIB_UNARY_DECL_WITH_CONTEXT(CellEval);
 
+   STDLIB_UNARY_DECL_WITH_CONTEXT(Sum);
+   STDLIB_UNARY_DECL_WITH_CONTEXT(Count);
+   STDLIB_UNARY_DECL_WITH_CONTEXT(Maximum);
+   STDLIB_UNARY_DECL_WITH_CONTEXT(Minimum);
+   STDLIB_UNARY_DECL_WITH_CONTEXT(Average);
+
 
    typedef std::shared_ptr<Backwards::Types::ValueType> (*BinaryFunctionPointerWithContext) (Backwards::Engine::CallingContext& context,
       const std::shared_ptr<Backwards::Types::ValueType>&, const std::shared_ptr<Backwards::Types::ValueType>&);
@@ -56,7 +62,7 @@ namespace Engine
    public:
       BinaryFunctionPointerWithContext function;
       explicit StandardBinaryFunctionWithContext(BinaryFunctionPointerWithContext);
-      std::shared_ptr<Backwards::Engine::FlowControl> execute (Backwards::Engine::CallingContext&) const override;
+      Backwards::Engine::FlowControl execute (Backwards::Engine::CallingContext&) const override;
     };
 
 #define STDLIB_BINARY_DECL_WITH_CONTEXT(x) \
@@ -0,0 +1,82 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2023, Thomas DiModica
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef FORWARDS_PARSER_OPTIMIZER_H
+#define FORWARDS_PARSER_OPTIMIZER_H
+
+#include <map>
+#include <memory>
+#include <string>
+
+namespace Forwards
+ {
+
+namespace Engine
+ {
+   class Expression;
+   class Shared;
+ }
+
+namespace Parser
+ {
+
+      /*
+         Runs over a freshly parsed tree, before anyone else has seen it.
+         Subtrees of constants are computed now, and identical subtrees that
+         can't see anything change during one evaluation of the cell are made into one.
+      */
+   class Optimizer final
+    {
+   public:
+      static std::shared_ptr<Engine::Expression> optimize (const std::shared_ptr<Engine::Expression>&, size_t, size_t);
+
+   private:
+      Optimizer(size_t col, size_t row) : col(col), row(row) { }
+
+      size_t col;
+      size_t row;
+      std::map<const Engine::Expression*, std::string> keys;
+      std::map<std::string, size_t> counts;
+      std::map<std::string, std::shared_ptr<Engine::Shared> > made;
+
+      static std::shared_ptr<Engine::Expression> fold (const std::shared_ptr<Engine::Expression>&);
+
+      const std::string& key (const Engine::Expression*);
+      bool worthSharing (const Engine::Expression*);
+      void count (const Engine::Expression*);
+      std::shared_ptr<Engine::Expression> share (const std::shared_ptr<Engine::Expression>&);
+    };
+
+ } // namespace Parser
+
+ } // namespace Forwards
+
+#endif /* FORWARDS_PARSER_OPTIMIZER_H */
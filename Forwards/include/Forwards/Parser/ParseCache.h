@@ -0,0 +1,77 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2023, Thomas DiModica
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef FORWARDS_PARSER_PARSECACHE_H
+#define FORWARDS_PARSER_PARSECACHE_H
+
+#include "Forwards/Parser/Parser.h"
+
+#include <string>
+#include <unordered_map>
+
+namespace Forwards
+ {
+
+namespace Parser
+ {
+
+      /*
+         Formulas are stored with absolute names, but parse to trees of relative references:
+         "A1+1" in B1 and "A2+1" in B2 are the same tree. This keys parsed trees by the
+         formula's tokens with the cell references made relative to the cell, so every cell
+         of a filled-down column shares one parse. The trees are immutable, so sharing is safe.
+      */
+   class ParseCache final
+    {
+   public:
+      ParseCache();
+
+      std::shared_ptr<Engine::Expression> parse (const std::string&, const Engine::GetterMap&, Backwards::Engine::Logger&, size_t, size_t);
+
+         // Forget everything, say, when the number system or the function scope changes.
+      void clear (void) { trees.clear(); }
+      size_t size (void) const { return trees.size(); }
+
+      void setBudget (size_t newBudget) { budget = newBudget; }
+
+         // Returns an empty string if the formula doesn't lex.
+      static std::string normalize (const std::string&, size_t, size_t);
+
+   private:
+      std::unordered_map<std::string, std::shared_ptr<Engine::Expression> > trees;
+      size_t budget;
+    };
+
+ } // namespace Parser
+
+ } // namespace Forwards
+
+#endif /* FORWARDS_PARSER_PARSECACHE_H */
@@ -77,6 +77,8 @@ namespace Parser
       static std::shared_ptr<Engine::Expression> primary (Input::Lexer& src, const Engine::GetterMap&, Backwards::Engine::Logger&, size_t, size_t);
 
       static std::shared_ptr<Engine::Expression> cellref (const Input::Token&, size_t, size_t);
+
+      friend class ParseCache;
     };
 
  } // namespace Parser
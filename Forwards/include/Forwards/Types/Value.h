@@ -0,0 +1,145 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2023, Thomas DiModica
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef FORWARDS_TYPES_VALUE_H
+#define FORWARDS_TYPES_VALUE_H
+
+#include "NumberSystem.h"
+#include "InlineNumbers.h"
+#include "Forwards/Types/ValueType.h"
+
+#include <cstdint>
+#include <memory>
+
+namespace Forwards
+ {
+
+namespace Types
+ {
+
+      /*
+         What a formula works with while it is being computed. A number from a system
+         that can do its math in 64 bits is kept in the Value itself, so computing
+         one doesn't allocate. Anything else is a NumberHolder or a ValueType, which is
+         what the rest of the program sees: box() makes one when it is needed.
+      */
+   class Value final
+    {
+   public:
+      enum Representation : uint8_t
+       {
+         EMPTY,   // NIL
+         INLINE,  // A number, in the current system's bits.
+         HOLDER,  // A number.
+         BOXED    // Anything else.
+       };
+
+      Value() : rep(EMPTY), bits(0U) { }
+      explicit Value(const std::shared_ptr<ValueType>&);
+
+      static Value fromBits(uint64_t bits)
+       {
+         Value result;
+         result.rep = INLINE;
+         result.bits = bits;
+         return result;
+       }
+      static Value fromHolder(const std::shared_ptr<NumberHolder>&);
+      static Value fromBool(bool);
+
+      ValueTypes getType() const;
+      std::shared_ptr<ValueType> box() const;
+
+         // If both are numbers, computes op on them and returns true.
+      static bool numeric(NumberSystem_Inline_Op, const Value&, const Value&, Value&);
+      static bool negate(const Value&, Value&);
+
+         // The same, specialized on the current number system's math, from InlineNumbers.h.
+         // The two above pick the specialization on every call: a loop can pick it once.
+      template <class Math> static bool numericWith(NumberSystem_Inline_Op, const Value&, const Value&, Value&);
+      template <class Math> static bool negateWith(const Value&, Value&);
+
+   private:
+      Representation rep;
+      uint64_t bits;
+      std::shared_ptr<NumberHolder> holder;
+      std::shared_ptr<ValueType> boxed; // If we came from a box, hand that one back.
+
+      bool asInline(uint64_t& out) const
+       {
+         if (INLINE == rep)
+          {
+            out = bits;
+            return true;
+          }
+         return (HOLDER == rep) && (true == NumberSystem::getCurrentNumberSystem().toInline(*holder, out));
+       }
+
+      static bool numericHolders(NumberSystem_Inline_Op, const Value&, const Value&, Value&);
+      static bool negateHolder(const Value&, Value&);
+    };
+
+   template <class Math>
+   bool Value::numericWith(NumberSystem_Inline_Op op, const Value& lhs, const Value& rhs, Value& result)
+    {
+      uint64_t left, right;
+      if ((true == Math::INLINE) && (true == lhs.asInline(left)) && (true == rhs.asInline(right)))
+       {
+         if (op >= INLINE_EQUAL)
+          {
+            result = fromBits(Math::truth(Math::compare(op, left, right)));
+          }
+         else
+          {
+            result = fromBits(Math::arithmetic(op, left, right));
+          }
+         return true;
+       }
+      return numericHolders(op, lhs, rhs, result);
+    }
+
+   template <class Math>
+   bool Value::negateWith(const Value& arg, Value& result)
+    {
+      uint64_t bits;
+      if ((true == Math::INLINE) && (true == arg.asInline(bits)))
+       {
+         result = fromBits(Math::negate(bits));
+         return true;
+       }
+      return negateHolder(arg, result);
+    }
+
+ } // namespace Types
+
+ } // namespace Forwards
+
+#endif /* FORWARDS_TYPES_VALUE_H */
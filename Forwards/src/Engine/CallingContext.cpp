@@ -30,6 +30,7 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #include "Forwards/Engine/CallingContext.h"
+#include "Forwards/Engine/SpreadSheet.h"
 
 namespace Forwards
  {
@@ -60,6 +61,14 @@ namespace Engine
       cells.pop_back();
     }
 
+   void CallingContext::writeShared()
+    {
+      if (nullptr != theSheet)
+       {
+         theSheet->readVolatile(*this);
+       }
+    }
+
    std::shared_ptr<Backwards::Engine::CallingContext> CallingContext::duplicate()
     {
       std::shared_ptr<CallingContext> result = std::make_shared<CallingContext>();
@@ -31,8 +31,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #include "Forwards/Engine/CellRangeExpand.h"
 #include "Forwards/Engine/CellRefEval.h"
-#include "Forwards/Engine/Expression.h"
-#include "Forwards/Types/CellRefValue.h"
+#include "Forwards/Engine/CallingContext.h"
+#include "Forwards/Engine/SpreadSheet.h"
 
 #include "Backwards/Types/ArrayValue.h"
 #include "Backwards/Types/CellRefValue.h"
@@ -63,9 +63,7 @@ namespace Engine
        {
          result->value.emplace_back(
             std::make_shared<Backwards::Types::CellRefValue>(
-               std::make_shared<CellRefEval>(
-                  std::make_shared<Constant>(Input::Token(),
-                     std::make_shared<Types::CellRefValue>(true, value->col1, true, value->row1, value->sheet)))));
+               std::make_shared<CellRefEval>(value->col1, value->row1, value->sheet)));
        }
       else if (value->col1 == value->col2)
        {
@@ -73,9 +71,7 @@ namespace Engine
           {
             result->value.emplace_back(
                std::make_shared<Backwards::Types::CellRefValue>(
-                  std::make_shared<CellRefEval>(
-                     std::make_shared<Constant>(Input::Token(),
-                        std::make_shared<Types::CellRefValue>(true, value->col1, true, row, value->sheet)))));
+                  std::make_shared<CellRefEval>(value->col1, row, value->sheet)));
           }
        }
       else if (value->row1 == value->row2)
@@ -84,9 +80,7 @@ namespace Engine
           {
             result->value.emplace_back(
                std::make_shared<Backwards::Types::CellRefValue>(
-                  std::make_shared<CellRefEval>(
-                     std::make_shared<Constant>(Input::Token(),
-                        std::make_shared<Types::CellRefValue>(true, col, true, value->row1, value->sheet)))));
+                  std::make_shared<CellRefEval>(col, value->row1, value->sheet)));
           }
        }
       else
@@ -103,6 +97,44 @@ namespace Engine
       return result;
     }
 
+   void CellRangeExpand::forEachValue (Backwards::Engine::CallingContext& context, bool byColumn, const Visitor& visitor) const
+    {
+      try
+       {
+         CallingContext& text = dynamic_cast<CallingContext&>(context);
+            // Say we read it all at once, rather than a cell at a time.
+         if ((nullptr != text.theSheet) && (true == value->sheet.empty()))
+          {
+            text.theSheet->readRange(text, value->col1, value->row1, value->col2, value->row2);
+          }
+
+         if (true == byColumn)
+          {
+            for (size_t col = value->col1; col <= value->col2; ++col)
+             {
+               for (size_t row = value->row1; row <= value->row2; ++row)
+                {
+                  visitor(CellRefEval::toBackwards(text, text.theSheet->fetchReadCell(text, col, row, value->sheet)));
+                }
+             }
+          }
+         else
+          {
+            for (size_t row = value->row1; row <= value->row2; ++row)
+             {
+               for (size_t col = value->col1; col <= value->col2; ++col)
+                {
+                  visitor(CellRefEval::toBackwards(text, text.theSheet->fetchReadCell(text, col, row, value->sheet)));
+                }
+             }
+          }
+       }
+      catch (const std::bad_cast&)
+       {
+         throw Backwards::Engine::ProgrammingException("Backwards context wasn't Forwards context.");
+       }
+    }
+
    std::shared_ptr<Backwards::Types::ValueType> CellRangeExpand::getIndex (size_t index) const
     {
       std::shared_ptr<Backwards::Types::ValueType> result;
@@ -114,9 +146,7 @@ namespace Engine
           {
             result =
                std::make_shared<Backwards::Types::CellRefValue>(
-                  std::make_shared<CellRefEval>(
-                     std::make_shared<Constant>(Input::Token(),
-                        std::make_shared<Types::CellRefValue>(true, value->col1, true, value->row1, value->sheet))));
+                  std::make_shared<CellRefEval>(value->col1, value->row1, value->sheet));
           }
        }
       else if (value->col1 == value->col2)
@@ -125,9 +155,7 @@ namespace Engine
           {
             result =
                std::make_shared<Backwards::Types::CellRefValue>(
-                  std::make_shared<CellRefEval>(
-                     std::make_shared<Constant>(Input::Token(),
-                        std::make_shared<Types::CellRefValue>(true, value->col1, true, value->row1 + index, value->sheet))));
+                  std::make_shared<CellRefEval>(value->col1, value->row1 + index, value->sheet));
           }
        }
       else if (value->row1 == value->row2)
@@ -136,9 +164,7 @@ namespace Engine
           {
             result =
                std::make_shared<Backwards::Types::CellRefValue>(
-                  std::make_shared<CellRefEval>(
-                     std::make_shared<Constant>(Input::Token(),
-                        std::make_shared<Types::CellRefValue>(true, value->col1 + index, true, value->row1, value->sheet))));
+                  std::make_shared<CellRefEval>(value->col1 + index, value->row1, value->sheet));
           }
        }
       else
@@ -37,6 +37,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "Forwards/Types/StringValue.h"
 #include "Forwards/Types/CellRangeValue.h"
 #include "Forwards/Engine/CellRangeExpand.h"
+#include "Forwards/Engine/CallingContext.h"
+#include "Forwards/Engine/SpreadSheet.h"
 
 #include "Backwards/Types/CellRefValue.h"
 #include "Backwards/Types/FloatValue.h"
@@ -52,55 +54,85 @@ namespace Forwards
 namespace Engine
  {
 
-   static const Types::CellRefValue* getReferencedCell(const std::shared_ptr<Expression>& expr)
+      // Where a reference points, whichever way it is held.
+   class ReferencedCell final
     {
-      if (typeid(Constant) == typeid(*expr.get()))
+   public:
+      bool colAbsolute;
+      bool rowAbsolute;
+      int64_t colRef;
+      int64_t rowRef;
+      const std::string* sheet;
+    };
+
+   static const ReferencedCell* getReferencedCell(const CellRefEval& eval, ReferencedCell& OUT)
+    {
+      if (nullptr == eval.value.get())
+       {
+         OUT.colAbsolute = true;
+         OUT.rowAbsolute = true;
+         OUT.colRef = static_cast<int64_t>(eval.col);
+         OUT.rowRef = static_cast<int64_t>(eval.row);
+         OUT.sheet = &eval.sheet;
+         return &OUT;
+       }
+      if (typeid(Constant) == typeid(*eval.value.get()))
        {
-         const Constant& temp1 = static_cast<const Constant&>(*expr.get());
+         const Constant& temp1 = static_cast<const Constant&>(*eval.value.get());
          if (typeid(Types::CellRefValue) == typeid(*temp1.value.get()))
           {
-            return static_cast<const Types::CellRefValue*>(temp1.value.get());
+            const Types::CellRefValue& temp2 = static_cast<const Types::CellRefValue&>(*temp1.value.get());
+            OUT.colAbsolute = temp2.colAbsolute;
+            OUT.rowAbsolute = temp2.rowAbsolute;
+            OUT.colRef = temp2.colRef;
+            OUT.rowRef = temp2.rowRef;
+            OUT.sheet = &temp2.sheet;
+            return &OUT;
           }
        }
       return nullptr;
     }
 
-   static const Types::CellRefValue* getReferencedCell(const Backwards::Types::CellRefValue& val)
+   static const ReferencedCell* getReferencedCell(const Backwards::Types::CellRefValue& val, ReferencedCell& OUT)
     {
       if (typeid(CellRefEval) == typeid(*val.value.get()))
        {
-         return getReferencedCell(static_cast<const CellRefEval&>(*val.value.get()).value);
+         return getReferencedCell(static_cast<const CellRefEval&>(*val.value.get()), OUT);
        }
       throw Backwards::Engine::ProgrammingException("CellRefHolder is not a Forward CellRefValue.");
     }
 
-   CellRefEval::CellRefEval()
+   CellRefEval::CellRefEval() : col(0U), row(0U)
+    {
+    }
+
+   CellRefEval::CellRefEval(const std::shared_ptr<Expression>& value) : value(value), col(0U), row(0U)
     {
     }
 
-   CellRefEval::CellRefEval(const std::shared_ptr<Expression>& value) : value(value)
+   CellRefEval::CellRefEval(size_t col, size_t row, const std::string& sheet) : col(col), row(row), sheet(sheet)
     {
     }
 
+   std::shared_ptr<Expression> CellRefEval::getExpression() const
+    {
+      if (nullptr != value.get())
+       {
+         return value;
+       }
+      return std::make_shared<Constant>(Input::Token(), std::make_shared<Types::CellRefValue>(true, col, true, row, sheet));
+    }
+
    std::shared_ptr<Backwards::Types::ValueType> CellRefEval::evaluate (Backwards::Engine::CallingContext& context) const
     {
       try
        {
-         std::shared_ptr<Types::ValueType> result = value->evaluate(dynamic_cast<Forwards::Engine::CallingContext&>(context));
-         switch (result->getType())
+         Forwards::Engine::CallingContext& text = dynamic_cast<Forwards::Engine::CallingContext&>(context);
+         if (nullptr == value.get())
           {
-         case Types::FLOAT:
-            return std::make_shared<Backwards::Types::FloatValue>(static_cast<Types::FloatValue&>(*result.get()).value);
-         case Types::STRING:
-            return std::make_shared<Backwards::Types::StringValue>(static_cast<Types::StringValue&>(*result.get()).value);
-         case Types::NIL:
-            return std::make_shared<Backwards::Types::NilValue>();
-         case Types::CELL_REF:
-            throw Backwards::Engine::ProgrammingException("CellRefEval::evaluate did not resolve to a Backwards Type.");
-         case Types::CELL_RANGE:
-            return std::make_shared<Backwards::Types::CellRangeValue>(std::make_shared<CellRangeExpand>(std::static_pointer_cast<Types::CellRangeValue>(result)));
+            return toBackwards(text, text.theSheet->fetchCell(text, col, row, sheet));
           }
-         throw Backwards::Engine::ProgrammingException("Forward getType returned invalid type.");
+         return toBackwards(text, value->evaluate(text));
        }
       catch (const std::bad_cast&)
        {
@@ -108,16 +140,42 @@ namespace Engine
        }
     }
 
+   std::shared_ptr<Backwards::Types::ValueType> CellRefEval::toBackwards (CallingContext& context, const std::shared_ptr<Types::ValueType>& result)
+    {
+      switch (result->getType())
+       {
+      case Types::FLOAT:
+         return std::make_shared<Backwards::Types::FloatValue>(static_cast<Types::FloatValue&>(*result.get()).value);
+      case Types::STRING:
+         return std::make_shared<Backwards::Types::StringValue>(static_cast<Types::StringValue&>(*result.get()).value);
+      case Types::NIL:
+         return std::make_shared<Backwards::Types::NilValue>();
+      case Types::CELL_REF:
+         throw Backwards::Engine::ProgrammingException("CellRefEval::evaluate did not resolve to a Backwards Type.");
+      case Types::CELL_RANGE:
+       {
+         const Types::CellRangeValue& range = static_cast<Types::CellRangeValue&>(*result.get());
+         if ((nullptr != context.theSheet) && (true == range.sheet.empty()))
+          {
+            context.theSheet->readRange(context, range.col1, range.row1, range.col2, range.row2);
+          }
+       }
+         return std::make_shared<Backwards::Types::CellRangeValue>(std::make_shared<CellRangeExpand>(std::static_pointer_cast<Types::CellRangeValue>(result)));
+       }
+      throw Backwards::Engine::ProgrammingException("Forward getType returned invalid type.");
+    }
+
    bool CellRefEval::equal (const Backwards::Types::CellRefValue& lhs) const
     {
-      const Types::CellRefValue* LHS = getReferencedCell(lhs);
-      const Types::CellRefValue* RHS = getReferencedCell(value);
+      ReferencedCell left, right;
+      const ReferencedCell* LHS = getReferencedCell(lhs, left);
+      const ReferencedCell* RHS = getReferencedCell(*this, right);
 
       if ((nullptr != LHS) && (nullptr != RHS))
        {
          return (LHS->colAbsolute == RHS->colAbsolute) && (LHS->rowAbsolute == RHS->rowAbsolute) &&
             (LHS->colRef == RHS->colRef) && (LHS->rowRef == RHS->rowRef) &&
-            (LHS->sheet == RHS->sheet);
+            (*LHS->sheet == *RHS->sheet);
        }
       return lhs.value.get() == this;
     }
@@ -129,8 +187,9 @@ namespace Engine
 
    bool CellRefEval::sort (const Backwards::Types::CellRefValue& lhs) const
     {
-      const Types::CellRefValue* LHS = getReferencedCell(lhs);
-      const Types::CellRefValue* RHS = getReferencedCell(value);
+      ReferencedCell left, right;
+      const ReferencedCell* LHS = getReferencedCell(lhs, left);
+      const ReferencedCell* RHS = getReferencedCell(*this, right);
 
       if ((nullptr != LHS) && (nullptr != RHS))
        {
@@ -138,22 +197,23 @@ namespace Engine
          if (LHS->rowAbsolute != RHS->rowAbsolute) return LHS->rowAbsolute < RHS->rowAbsolute;
          if (LHS->colRef != RHS->colRef) return LHS->colRef < RHS->colRef;
          if (LHS->rowRef != RHS->rowRef) return LHS->rowRef < RHS->rowRef;
-         return LHS->sheet < RHS->sheet;
+         return *LHS->sheet < *RHS->sheet;
        }
       return lhs.value.get() < this;
     }
 
    size_t CellRefEval::hash() const
     {
-      const Types::CellRefValue* THIS = getReferencedCell(value);
+      ReferencedCell self;
+      const ReferencedCell* THIS = getReferencedCell(*this, self);
 
       if (nullptr != THIS)
        {
          size_t result = std::hash<bool>()(THIS->colAbsolute);
-         Backwards::Types::boost_hash_combine(result, std::hash<size_t>()(THIS->colRef));
+         Backwards::Types::boost_hash_combine(result, std::hash<size_t>()(static_cast<size_t>(THIS->colRef)));
          Backwards::Types::boost_hash_combine(result, std::hash<bool>()(THIS->rowAbsolute));
-         Backwards::Types::boost_hash_combine(result, std::hash<size_t>()(THIS->rowRef));
-         Backwards::Types::boost_hash_combine(result, std::hash<std::string>()(THIS->sheet));
+         Backwards::Types::boost_hash_combine(result, std::hash<size_t>()(static_cast<size_t>(THIS->rowRef)));
+         Backwards::Types::boost_hash_combine(result, std::hash<std::string>()(*THIS->sheet));
          return result;
        }
       return std::hash<void*>()(value.get());
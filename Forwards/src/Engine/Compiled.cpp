@@ -0,0 +1,255 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2023, Thomas DiModica
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "Forwards/Engine/Compiled.h"
+#include "Forwards/Engine/SpreadSheet.h"
+
+#include "Forwards/Types/CellRefValue.h"
+
+#include <typeinfo>
+
+namespace Forwards
+ {
+
+namespace Engine
+ {
+
+   Compiled::Compiled(const std::shared_ptr<Expression>& tree) : Expression(tree->token), tree(tree), depth(0U)
+    {
+    }
+
+   std::shared_ptr<Expression> Compiled::compile(const std::shared_ptr<Expression>& tree)
+    {
+         // Only operators have anything to gain: a lone constant, reference or function call would just be a tree in a box.
+         // Cells keep what this returns, so this is asked again of every cell on every recalc: answer it cheaply.
+      const std::type_info& type = typeid(*tree);
+      if ((typeid(Compiled) == type) || (typeid(Constant) == type) || (typeid(Folded) == type) || (typeid(Name) == type) ||
+          (typeid(FunctionCall) == type) || (typeid(MakeRange) == type) || (typeid(MoveReference) == type))
+       {
+         return tree;
+       }
+
+      std::shared_ptr<Compiled> result = std::make_shared<Compiled>(tree);
+      size_t height = 0U;
+      result->emit(tree.get(), height);
+      return result;
+    }
+
+   void Compiled::append(OpCode op, size_t arg)
+    {
+      code.push_back(Instruction { op, static_cast<uint32_t>(arg) });
+    }
+
+   void Compiled::emit(const Expression* node, size_t& height)
+    {
+      const std::type_info& type = typeid(*node);
+      if (typeid(Constant) == type)
+       {
+         const std::shared_ptr<Types::ValueType>& value = static_cast<const Constant*>(node)->value;
+         if (Types::CELL_REF == value->getType())
+          {
+            references.push_back(static_cast<const Types::CellRefValue*>(value.get()));
+            append(LOAD, references.size() - 1U);
+          }
+         else
+          {
+            constants.emplace_back(value);
+            append(PUSH, constants.size() - 1U);
+          }
+         ++height;
+       }
+      else if (typeid(Negate) == type)
+       {
+         emit(static_cast<const Negate*>(node)->arg.get(), height);
+         nodes.push_back(node);
+         append(NEG, nodes.size() - 1U);
+       }
+#define COMPILE_BINARY(x, y) \
+      else if (typeid(x) == type) \
+       { \
+         emit(static_cast<const x*>(node)->lhs.get(), height); \
+         emit(static_cast<const x*>(node)->rhs.get(), height); \
+         --height; \
+         nodes.push_back(node); \
+         append(y, nodes.size() - 1U); \
+       }
+      COMPILE_BINARY(Plus, ADD)
+      COMPILE_BINARY(Minus, SUB)
+      COMPILE_BINARY(Multiply, MUL)
+      COMPILE_BINARY(Divide, DIV)
+      COMPILE_BINARY(Cat, CAT)
+      COMPILE_BINARY(Equals, EQ)
+      COMPILE_BINARY(NotEqual, NE)
+      COMPILE_BINARY(Greater, GT)
+      COMPILE_BINARY(Less, LT)
+      COMPILE_BINARY(GEQ, GE)
+      COMPILE_BINARY(LEQ, LE)
+#undef COMPILE_BINARY
+      else
+       {
+         nodes.push_back(node);
+         append(EVAL, nodes.size() - 1U);
+         ++height;
+       }
+
+      if (height > depth)
+       {
+         depth = height;
+       }
+    }
+
+   Types::Value Compiled::binary(OpCode op, const Expression* node, const Types::Value& lhs, const Types::Value& rhs)
+    {
+      switch (op)
+       {
+      case ADD:
+         return Plus::apply(node->token, lhs, rhs);
+      case SUB:
+         return Minus::apply(node->token, lhs, rhs);
+      case MUL:
+         return Multiply::apply(node->token, lhs, rhs);
+      case DIV:
+         return Divide::apply(node->token, lhs, rhs);
+      case CAT:
+         return Cat::apply(node->token, lhs, rhs);
+      case EQ:
+         return Equals::apply(node->token, lhs, rhs);
+      case NE:
+         return NotEqual::apply(node->token, lhs, rhs);
+      case GT:
+         return Greater::apply(node->token, lhs, rhs);
+      case LT:
+         return Less::apply(node->token, lhs, rhs);
+      case GE:
+         return GEQ::apply(node->token, lhs, rhs);
+      case LE:
+         return LEQ::apply(node->token, lhs, rhs);
+      default:
+         return Types::Value();
+       }
+    }
+
+   std::shared_ptr<Types::ValueType> Compiled::evaluate (CallingContext& context) const
+    {
+      switch (NumberSystem::getCurrentSystem())
+       {
+      case DOUBLE_NUMBER_SYSTEM:
+         return run<double_InlineMath>(context);
+      case LIBDECMATH_NUMBER_SYSTEM:
+         return run<libdecmath_InlineMath>(context);
+      default:
+         return run<NoInlineMath>(context);
+       }
+    }
+
+   template <class Math>
+   std::shared_ptr<Types::ValueType> Compiled::run (CallingContext& context) const
+    {
+         // Most formulas are shallow: don't allocate a stack for them.
+      static const size_t SMALL = 8U;
+      Types::Value local [SMALL];
+      std::vector<Types::Value> large;
+      Types::Value* stack = local;
+      if (depth > SMALL)
+       {
+         large.resize(depth);
+         stack = large.data();
+       }
+
+      size_t top = 0U;
+      for (const Instruction& next : code)
+       {
+         switch (next.op)
+          {
+         case PUSH:
+            stack[top] = constants[next.arg];
+            ++top;
+            break;
+         case LOAD:
+          {
+            const Types::CellRefValue& ref = *references[next.arg];
+            const CellFrame* frame = context.topCell();
+            size_t col = ref.colAbsolute ? static_cast<size_t>(ref.colRef) : Types::CellRefValue::getColumn(frame->col, ref.colRef);
+            size_t row = ref.rowAbsolute ? static_cast<size_t>(ref.rowRef) : Types::CellRefValue::getRow(frame->row, ref.rowRef);
+            stack[top] = Types::Value(context.theSheet->fetchCell(context, col, row, ref.sheet));
+            ++top;
+          }
+            break;
+         case EVAL:
+            stack[top] = nodes[next.arg]->evaluateValue(context);
+            ++top;
+            break;
+         case NEG:
+            if (false == Types::Value::negateWith<Math>(stack[top - 1U], stack[top - 1U]))
+             {
+               stack[top - 1U] = Negate::apply(nodes[next.arg]->token, stack[top - 1U]);
+             }
+            break;
+            // Numbers are done here, with the operation known. Anything else goes to the operator.
+#define RUN_BINARY(x, y) \
+         case x: \
+            if (false == Types::Value::numericWith<Math>(y, stack[top - 2U], stack[top - 1U], stack[top - 2U])) \
+             { \
+               stack[top - 2U] = binary(next.op, nodes[next.arg], stack[top - 2U], stack[top - 1U]); \
+             } \
+            --top; \
+            stack[top] = Types::Value(); \
+            break;
+         RUN_BINARY(ADD, INLINE_ADD)
+         RUN_BINARY(SUB, INLINE_SUBTRACT)
+         RUN_BINARY(MUL, INLINE_MULTIPLY)
+         RUN_BINARY(DIV, INLINE_DIVIDE)
+         RUN_BINARY(EQ, INLINE_EQUAL)
+         RUN_BINARY(NE, INLINE_NOT_EQUAL)
+         RUN_BINARY(GT, INLINE_GREATER)
+         RUN_BINARY(LT, INLINE_LESS)
+         RUN_BINARY(GE, INLINE_GREATER_EQUAL)
+         RUN_BINARY(LE, INLINE_LESS_EQUAL)
+#undef RUN_BINARY
+         default:
+            stack[top - 2U] = binary(next.op, nodes[next.arg], stack[top - 2U], stack[top - 1U]);
+            --top;
+            stack[top] = Types::Value();
+            break;
+          }
+       }
+
+      return stack[0U].box();
+    }
+
+   std::string Compiled::toString(size_t col, size_t row, int level) const
+    {
+      return tree->toString(col, row, level);
+    }
+
+ } // namespace Engine
+
+ } // namespace Forwards
@@ -0,0 +1,297 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2023, Thomas DiModica
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "Forwards/Engine/DependencyGraph.h"
+
+#include <algorithm>
+
+namespace Forwards
+ {
+
+namespace Engine
+ {
+
+   DependencyGraph::DependencyGraph() : sheet(nullptr), updating(false)
+    {
+    }
+
+   size_t DependencyGraph::makeCellId(size_t col, size_t row)
+    {
+      return ((col << 44U) | row);
+    }
+
+   size_t DependencyGraph::getColumn(size_t id)
+    {
+      return id >> 44U;
+    }
+
+   size_t DependencyGraph::getRow(size_t id)
+    {
+      return id & ((static_cast<size_t>(1U) << 44U) - 1U);
+    }
+
+   void DependencyGraph::reset(SpreadSheetHolder* sheet)
+    {
+      this->sheet = sheet;
+      reads.clear();
+      readers.clear();
+      rangeReaders.clear();
+      volatiles.clear();
+      marked.clear();
+      markedColumns.clear();
+      markedRows.clear();
+      updating = false;
+      stale.clear();
+    }
+
+   bool DependencyGraph::isValidFor(SpreadSheetHolder* sheet) const
+    {
+      return (nullptr != sheet) && (this->sheet == sheet);
+    }
+
+   void DependencyGraph::forgetReads(size_t readerCol, size_t readerRow)
+    {
+      size_t reader = makeCellId(readerCol, readerRow);
+      volatiles.erase(reader);
+
+      auto needle = reads.find(reader);
+      if (reads.end() == needle)
+       {
+         return;
+       }
+
+      for (size_t cell : needle->second.cells)
+       {
+         auto found = readers.find(cell);
+         if (readers.end() != found)
+          {
+            found->second.erase(reader);
+            if (true == found->second.empty())
+             {
+               readers.erase(found);
+             }
+          }
+       }
+
+      for (const RangeRead& range : needle->second.ranges)
+       {
+         for (size_t col = range.col1; col <= range.col2; ++col)
+          {
+            auto found = rangeReaders.find(col);
+            if (rangeReaders.end() != found)
+             {
+               found->second.erase(std::remove_if(found->second.begin(), found->second.end(),
+                  [reader](const RangeReader& arg) { return reader == arg.reader; }), found->second.end());
+               if (true == found->second.empty())
+                {
+                  rangeReaders.erase(found);
+                }
+             }
+          }
+       }
+
+      reads.erase(needle);
+    }
+
+   void DependencyGraph::addCell(size_t readerCol, size_t readerRow, size_t col, size_t row)
+    {
+      size_t reader = makeCellId(readerCol, readerRow);
+      Reads& current = reads[reader];
+
+         // Reading the elements of a range we already know about is common: don't record them twice.
+      for (const RangeRead& range : current.ranges)
+       {
+         if ((range.col1 <= col) && (col <= range.col2) && (range.row1 <= row) && (row <= range.row2))
+          {
+            return;
+          }
+       }
+
+      size_t cell = makeCellId(col, row);
+      if (true == readers[cell].insert(reader).second)
+       {
+         current.cells.push_back(cell);
+       }
+    }
+
+   void DependencyGraph::addRange(size_t readerCol, size_t readerRow, size_t col1, size_t row1, size_t col2, size_t row2)
+    {
+      size_t reader = makeCellId(readerCol, readerRow);
+      Reads& current = reads[reader];
+
+      RangeRead range (std::min(col1, col2), std::min(row1, row2), std::max(col1, col2), std::max(row1, row2));
+      for (const RangeRead& old : current.ranges)
+       {
+         if ((old.col1 == range.col1) && (old.row1 == range.row1) && (old.col2 == range.col2) && (old.row2 == range.row2))
+          {
+            return;
+          }
+       }
+
+      current.ranges.push_back(range);
+      for (size_t col = range.col1; col <= range.col2; ++col)
+       {
+         rangeReaders[col].emplace_back(range.row1, range.row2, reader);
+       }
+    }
+
+   void DependencyGraph::addVolatile(size_t readerCol, size_t readerRow)
+    {
+      volatiles.insert(makeCellId(readerCol, readerRow));
+    }
+
+   bool DependencyGraph::hasVolatile() const
+    {
+      return false == volatiles.empty();
+    }
+
+   void DependencyGraph::markCell(size_t col, size_t row)
+    {
+      marked.insert(makeCellId(col, row));
+    }
+
+   void DependencyGraph::markColumn(size_t col)
+    {
+      markedColumns.insert(col);
+    }
+
+   void DependencyGraph::markRow(size_t row)
+    {
+      markedRows.insert(row);
+    }
+
+   void DependencyGraph::addReaders(size_t id, std::vector<size_t>& work)
+    {
+      auto needle = readers.find(id);
+      if (readers.end() != needle)
+       {
+         work.insert(work.end(), needle->second.begin(), needle->second.end());
+       }
+
+      auto found = rangeReaders.find(getColumn(id));
+      if (rangeReaders.end() != found)
+       {
+         size_t row = getRow(id);
+         for (const RangeReader& range : found->second)
+          {
+            if ((range.row1 <= row) && (row <= range.row2))
+             {
+               work.push_back(range.reader);
+             }
+          }
+       }
+    }
+
+   std::vector<size_t> DependencyGraph::beginUpdate()
+    {
+      std::vector<size_t> work (marked.begin(), marked.end());
+
+         // A cleared column or row: every cell we know about in it changed.
+      if ((false == markedColumns.empty()) || (false == markedRows.empty()))
+       {
+         for (const auto& cell : reads)
+          {
+            if ((markedColumns.end() != markedColumns.find(getColumn(cell.first))) || (markedRows.end() != markedRows.find(getRow(cell.first))))
+             {
+               work.push_back(cell.first);
+             }
+          }
+         for (const auto& cell : readers)
+          {
+            if ((markedColumns.end() != markedColumns.find(getColumn(cell.first))) || (markedRows.end() != markedRows.find(getRow(cell.first))))
+             {
+               work.push_back(cell.first);
+             }
+          }
+         for (const auto& column : rangeReaders)
+          {
+            bool wholeColumn = markedColumns.end() != markedColumns.find(column.first);
+            for (const RangeReader& range : column.second)
+             {
+               if (true == wholeColumn)
+                {
+                  work.push_back(range.reader);
+                }
+               else
+                {
+                  auto row = markedRows.lower_bound(range.row1);
+                  if ((markedRows.end() != row) && (*row <= range.row2))
+                   {
+                     work.push_back(range.reader);
+                   }
+                }
+             }
+          }
+       }
+
+      marked.clear();
+      markedColumns.clear();
+      markedRows.clear();
+
+      stale.clear();
+      while (false == work.empty())
+       {
+         size_t id = work.back();
+         work.pop_back();
+         if (true == stale.insert(id).second)
+          {
+            addReaders(id, work);
+          }
+       }
+
+      updating = true;
+      return std::vector<size_t>(stale.begin(), stale.end());
+    }
+
+   bool DependencyGraph::isStale(size_t col, size_t row) const
+    {
+      return (false == updating) || (stale.end() != stale.find(makeCellId(col, row)));
+    }
+
+   void DependencyGraph::finishUpdate()
+    {
+      updating = false;
+      stale.clear();
+    }
+
+   const DependencyGraph::Reads* DependencyGraph::getReads(size_t id) const
+    {
+      auto needle = reads.find(id);
+      if (reads.end() == needle)
+       {
+         return nullptr;
+       }
+      return &needle->second;
+    }
+
+ } // namespace Engine
+
+ } // namespace Forwards
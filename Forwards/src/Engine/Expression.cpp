@@ -83,6 +83,11 @@ namespace Engine
     {
     }
 
+   Types::Value Expression::evaluateValue (CallingContext& context) const
+    {
+      return Types::Value(evaluate(context));
+    }
+
    std::string Expression::constructMessage(const std::string& e) const
     {
       return constructMessage(e, token);
@@ -150,34 +155,7 @@ namespace Engine
          row = Types::CellRefValue::getRow(context.topCell()->row, value->rowRef);
        }
 
-      AutoCell cell (context.theSheet, context.theSheet->getCellAt(col, row, value->sheet));
-         // If no cell, Nil.
-      if (nullptr == cell.cell)
-       {
-         return std::make_shared<Types::NilValue>();
-       }
-
-         // If we are currently evaluating this cell, stop.
-         // If we got this from another sheet, then there is nothing to compute.
-      if ((true == cell.cell->inEvaluation) || (false == value->sheet.empty()))
-       {
-         std::shared_ptr<Types::ValueType> result = cell.cell->previousValue;
-         if (nullptr == result.get())
-          {
-            result = std::make_shared<Types::NilValue>();
-          }
-         cell.cell->recursed = true;
-         return result;
-       }
-
-         // Guess we need to do work.
-      std::shared_ptr<Types::ValueType> result;
-      result = context.theSheet->computeCell(context, col, row, true);
-      if (nullptr == result.get())
-       {
-         result = std::make_shared<Types::NilValue>();
-       }
-      return result;
+      return context.theSheet->fetchCell(context, col, row, value->sheet);
     }
 
 
@@ -191,8 +169,28 @@ namespace Engine
 
    std::shared_ptr<Types::ValueType> Plus::evaluate (CallingContext& context) const
     {
-      std::shared_ptr<Types::ValueType> LHS = lhs->evaluate(context);
-      std::shared_ptr<Types::ValueType> RHS = rhs->evaluate(context);
+      return evaluateValue(context).box();
+    }
+
+   Types::Value Plus::evaluateValue (CallingContext& context) const
+    {
+      Types::Value LHS = lhs->evaluateValue(context);
+      Types::Value RHS = rhs->evaluateValue(context);
+      return apply(token, LHS, RHS);
+    }
+
+   Types::Value Plus::apply (const Input::Token& token, const Types::Value& LHS, const Types::Value& RHS)
+    {
+      Types::Value result;
+      if (false == Types::Value::numeric(INLINE_ADD, LHS, RHS, result))
+       {
+         result = Types::Value(apply(token, LHS.box(), RHS.box()));
+       }
+      return result;
+    }
+
+   std::shared_ptr<Types::ValueType> Plus::apply (const Input::Token& token, const std::shared_ptr<Types::ValueType>& LHS, const std::shared_ptr<Types::ValueType>& RHS)
+    {
       std::shared_ptr<Types::ValueType> result;
       switch (LHS->getType())
        {
@@ -208,7 +206,7 @@ namespace Engine
          case Types::STRING:
          case Types::CELL_REF:
          case Types::CELL_RANGE:
-            constructMessage("Error adding " + LHS->getTypeName() + " to " + RHS->getTypeName());
+            constructMessage("Error adding " + LHS->getTypeName() + " to " + RHS->getTypeName(), token);
           }
          break;
       case Types::NIL:
@@ -223,13 +221,13 @@ namespace Engine
          case Types::STRING:
          case Types::CELL_REF:
          case Types::CELL_RANGE:
-            constructMessage("Error adding " + LHS->getTypeName() + " to " + RHS->getTypeName());
+            constructMessage("Error adding " + LHS->getTypeName() + " to " + RHS->getTypeName(), token);
           }
          break;
       case Types::STRING:
       case Types::CELL_REF:
       case Types::CELL_RANGE:
-         constructMessage("Error adding " + LHS->getTypeName() + " to " + RHS->getTypeName());
+         constructMessage("Error adding " + LHS->getTypeName() + " to " + RHS->getTypeName(), token);
        }
       return result;
     }
@@ -243,8 +241,28 @@ namespace Engine
 
    std::shared_ptr<Types::ValueType> Minus::evaluate (CallingContext& context) const
     {
-      std::shared_ptr<Types::ValueType> LHS = lhs->evaluate(context);
-      std::shared_ptr<Types::ValueType> RHS = rhs->evaluate(context);
+      return evaluateValue(context).box();
+    }
+
+   Types::Value Minus::evaluateValue (CallingContext& context) const
+    {
+      Types::Value LHS = lhs->evaluateValue(context);
+      Types::Value RHS = rhs->evaluateValue(context);
+      return apply(token, LHS, RHS);
+    }
+
+   Types::Value Minus::apply (const Input::Token& token, const Types::Value& LHS, const Types::Value& RHS)
+    {
+      Types::Value result;
+      if (false == Types::Value::numeric(INLINE_SUBTRACT, LHS, RHS, result))
+       {
+         result = Types::Value(apply(token, LHS.box(), RHS.box()));
+       }
+      return result;
+    }
+
+   std::shared_ptr<Types::ValueType> Minus::apply (const Input::Token& token, const std::shared_ptr<Types::ValueType>& LHS, const std::shared_ptr<Types::ValueType>& RHS)
+    {
       std::shared_ptr<Types::ValueType> result;
       switch (LHS->getType())
        {
@@ -260,7 +278,7 @@ namespace Engine
          case Types::STRING:
          case Types::CELL_REF:
          case Types::CELL_RANGE:
-            constructMessage("Error subtracting " + RHS->getTypeName() + " from " + LHS->getTypeName());
+            constructMessage("Error subtracting " + RHS->getTypeName() + " from " + LHS->getTypeName(), token);
           }
          break;
       case Types::NIL:
@@ -275,13 +293,13 @@ namespace Engine
          case Types::STRING:
          case Types::CELL_REF:
          case Types::CELL_RANGE:
-            constructMessage("Error subtracting " + RHS->getTypeName() + " from " + LHS->getTypeName());
+            constructMessage("Error subtracting " + RHS->getTypeName() + " from " + LHS->getTypeName(), token);
           }
          break;
       case Types::STRING:
       case Types::CELL_REF:
       case Types::CELL_RANGE:
-         constructMessage("Error subtracting " + RHS->getTypeName() + " from " + LHS->getTypeName());
+         constructMessage("Error subtracting " + RHS->getTypeName() + " from " + LHS->getTypeName(), token);
        }
       return result;
     }
@@ -295,8 +313,28 @@ namespace Engine
 
    std::shared_ptr<Types::ValueType> Multiply::evaluate (CallingContext& context) const
     {
-      std::shared_ptr<Types::ValueType> LHS = lhs->evaluate(context);
-      std::shared_ptr<Types::ValueType> RHS = rhs->evaluate(context);
+      return evaluateValue(context).box();
+    }
+
+   Types::Value Multiply::evaluateValue (CallingContext& context) const
+    {
+      Types::Value LHS = lhs->evaluateValue(context);
+      Types::Value RHS = rhs->evaluateValue(context);
+      return apply(token, LHS, RHS);
+    }
+
+   Types::Value Multiply::apply (const Input::Token& token, const Types::Value& LHS, const Types::Value& RHS)
+    {
+      Types::Value result;
+      if (false == Types::Value::numeric(INLINE_MULTIPLY, LHS, RHS, result))
+       {
+         result = Types::Value(apply(token, LHS.box(), RHS.box()));
+       }
+      return result;
+    }
+
+   std::shared_ptr<Types::ValueType> Multiply::apply (const Input::Token& token, const std::shared_ptr<Types::ValueType>& LHS, const std::shared_ptr<Types::ValueType>& RHS)
+    {
       std::shared_ptr<Types::ValueType> result;
       switch (LHS->getType())
        {
@@ -312,7 +350,7 @@ namespace Engine
          case Types::STRING:
          case Types::CELL_REF:
          case Types::CELL_RANGE:
-            constructMessage("Error multiplying " + LHS->getTypeName() + " by " + RHS->getTypeName());
+            constructMessage("Error multiplying " + LHS->getTypeName() + " by " + RHS->getTypeName(), token);
           }
          break;
       case Types::NIL:
@@ -327,13 +365,13 @@ namespace Engine
          case Types::STRING:
          case Types::CELL_REF:
          case Types::CELL_RANGE:
-            constructMessage("Error multiplying " + LHS->getTypeName() + " by " + RHS->getTypeName());
+            constructMessage("Error multiplying " + LHS->getTypeName() + " by " + RHS->getTypeName(), token);
           }
          break;
       case Types::STRING:
       case Types::CELL_REF:
       case Types::CELL_RANGE:
-         constructMessage("Error multiplying " + LHS->getTypeName() + " by " + RHS->getTypeName());
+         constructMessage("Error multiplying " + LHS->getTypeName() + " by " + RHS->getTypeName(), token);
        }
       return result;
     }
@@ -347,8 +385,28 @@ namespace Engine
 
    std::shared_ptr<Types::ValueType> Divide::evaluate (CallingContext& context) const
     {
-      std::shared_ptr<Types::ValueType> LHS = lhs->evaluate(context);
-      std::shared_ptr<Types::ValueType> RHS = rhs->evaluate(context);
+      return evaluateValue(context).box();
+    }
+
+   Types::Value Divide::evaluateValue (CallingContext& context) const
+    {
+      Types::Value LHS = lhs->evaluateValue(context);
+      Types::Value RHS = rhs->evaluateValue(context);
+      return apply(token, LHS, RHS);
+    }
+
+   Types::Value Divide::apply (const Input::Token& token, const Types::Value& LHS, const Types::Value& RHS)
+    {
+      Types::Value result;
+      if (false == Types::Value::numeric(INLINE_DIVIDE, LHS, RHS, result))
+       {
+         result = Types::Value(apply(token, LHS.box(), RHS.box()));
+       }
+      return result;
+    }
+
+   std::shared_ptr<Types::ValueType> Divide::apply (const Input::Token& token, const std::shared_ptr<Types::ValueType>& LHS, const std::shared_ptr<Types::ValueType>& RHS)
+    {
       std::shared_ptr<Types::ValueType> result;
       switch (LHS->getType())
        {
@@ -364,7 +422,7 @@ namespace Engine
          case Types::STRING:
          case Types::CELL_REF:
          case Types::CELL_RANGE:
-            constructMessage("Error dividing " + LHS->getTypeName() + " by " + RHS->getTypeName());
+            constructMessage("Error dividing " + LHS->getTypeName() + " by " + RHS->getTypeName(), token);
           }
          break;
       case Types::NIL:
@@ -379,13 +437,13 @@ namespace Engine
          case Types::STRING:
          case Types::CELL_REF:
          case Types::CELL_RANGE:
-            constructMessage("Error dividing " + LHS->getTypeName() + " by " + RHS->getTypeName());
+            constructMessage("Error dividing " + LHS->getTypeName() + " by " + RHS->getTypeName(), token);
           }
          break;
       case Types::STRING:
       case Types::CELL_REF:
       case Types::CELL_RANGE:
-         constructMessage("Error dividing " + LHS->getTypeName() + " by " + RHS->getTypeName());
+         constructMessage("Error dividing " + LHS->getTypeName() + " by " + RHS->getTypeName(), token);
        }
       return result;
     }
@@ -399,8 +457,23 @@ namespace Engine
 
    std::shared_ptr<Types::ValueType> Cat::evaluate (CallingContext& context) const
     {
-      std::shared_ptr<Types::ValueType> LHS = lhs->evaluate(context);
-      std::shared_ptr<Types::ValueType> RHS = rhs->evaluate(context);
+      return evaluateValue(context).box();
+    }
+
+   Types::Value Cat::evaluateValue (CallingContext& context) const
+    {
+      Types::Value LHS = lhs->evaluateValue(context);
+      Types::Value RHS = rhs->evaluateValue(context);
+      return apply(token, LHS, RHS);
+    }
+
+   Types::Value Cat::apply (const Input::Token& token, const Types::Value& LHS, const Types::Value& RHS)
+    {
+      return Types::Value(apply(token, LHS.box(), RHS.box()));
+    }
+
+   std::shared_ptr<Types::ValueType> Cat::apply (const Input::Token& token, const std::shared_ptr<Types::ValueType>& LHS, const std::shared_ptr<Types::ValueType>& RHS)
+    {
       std::shared_ptr<Types::ValueType> result;
       switch (LHS->getType())
        {
@@ -419,7 +492,7 @@ namespace Engine
             break;
          case Types::CELL_REF:
          case Types::CELL_RANGE:
-            constructMessage("Error catenating " + LHS->getTypeName() + " with " + RHS->getTypeName());
+            constructMessage("Error catenating " + LHS->getTypeName() + " with " + RHS->getTypeName(), token);
           }
          break;
       case Types::STRING:
@@ -436,7 +509,7 @@ namespace Engine
             break;
          case Types::CELL_REF:
          case Types::CELL_RANGE:
-            constructMessage("Error catenating " + LHS->getTypeName() + " with " + RHS->getTypeName());
+            constructMessage("Error catenating " + LHS->getTypeName() + " with " + RHS->getTypeName(), token);
           }
          break;
       case Types::NIL:
@@ -453,12 +526,12 @@ namespace Engine
             break;
          case Types::CELL_REF:
          case Types::CELL_RANGE:
-            constructMessage("Error catenating " + LHS->getTypeName() + " with " + RHS->getTypeName());
+            constructMessage("Error catenating " + LHS->getTypeName() + " with " + RHS->getTypeName(), token);
           }
          break;
       case Types::CELL_REF:
       case Types::CELL_RANGE:
-         constructMessage("Error catenating " + LHS->getTypeName() + " with " + RHS->getTypeName());
+         constructMessage("Error catenating " + LHS->getTypeName() + " with " + RHS->getTypeName(), token);
        }
       return result;
     }
@@ -557,8 +630,28 @@ namespace Engine
 
    std::shared_ptr<Types::ValueType> Equals::evaluate (CallingContext& context) const
     {
-      std::shared_ptr<Types::ValueType> LHS = lhs->evaluate(context);
-      std::shared_ptr<Types::ValueType> RHS = rhs->evaluate(context);
+      return evaluateValue(context).box();
+    }
+
+   Types::Value Equals::evaluateValue (CallingContext& context) const
+    {
+      Types::Value LHS = lhs->evaluateValue(context);
+      Types::Value RHS = rhs->evaluateValue(context);
+      return apply(token, LHS, RHS);
+    }
+
+   Types::Value Equals::apply (const Input::Token& token, const Types::Value& LHS, const Types::Value& RHS)
+    {
+      Types::Value result;
+      if (false == Types::Value::numeric(INLINE_EQUAL, LHS, RHS, result))
+       {
+         result = Types::Value(apply(token, LHS.box(), RHS.box()));
+       }
+      return result;
+    }
+
+   std::shared_ptr<Types::ValueType> Equals::apply (const Input::Token& token, const std::shared_ptr<Types::ValueType>& LHS, const std::shared_ptr<Types::ValueType>& RHS)
+    {
       std::shared_ptr<Types::ValueType> result;
       switch (LHS->getType())
        {
@@ -580,7 +673,7 @@ namespace Engine
          case Types::STRING:
          case Types::CELL_REF:
          case Types::CELL_RANGE:
-            constructMessage("Error comparing " + LHS->getTypeName() + " with " + RHS->getTypeName());
+            constructMessage("Error comparing " + LHS->getTypeName() + " with " + RHS->getTypeName(), token);
           }
          break;
       case Types::STRING:
@@ -601,7 +694,7 @@ namespace Engine
          case Types::FLOAT:
          case Types::CELL_REF:
          case Types::CELL_RANGE:
-            constructMessage("Error comparing " + LHS->getTypeName() + " with " + RHS->getTypeName());
+            constructMessage("Error comparing " + LHS->getTypeName() + " with " + RHS->getTypeName(), token);
           }
          break;
       case Types::NIL:
@@ -624,12 +717,12 @@ namespace Engine
             break;
          case Types::CELL_REF:
          case Types::CELL_RANGE:
-            constructMessage("Error comparing " + LHS->getTypeName() + " with " + RHS->getTypeName());
+            constructMessage("Error comparing " + LHS->getTypeName() + " with " + RHS->getTypeName(), token);
           }
          break;
       case Types::CELL_REF:
       case Types::CELL_RANGE:
-         constructMessage("Error comparing " + LHS->getTypeName() + " with " + RHS->getTypeName());
+         constructMessage("Error comparing " + LHS->getTypeName() + " with " + RHS->getTypeName(), token);
        }
       return result;
     }
@@ -643,8 +736,28 @@ namespace Engine
 
    std::shared_ptr<Types::ValueType> NotEqual::evaluate (CallingContext& context) const
     {
-      std::shared_ptr<Types::ValueType> LHS = lhs->evaluate(context);
-      std::shared_ptr<Types::ValueType> RHS = rhs->evaluate(context);
+      return evaluateValue(context).box();
+    }
+
+   Types::Value NotEqual::evaluateValue (CallingContext& context) const
+    {
+      Types::Value LHS = lhs->evaluateValue(context);
+      Types::Value RHS = rhs->evaluateValue(context);
+      return apply(token, LHS, RHS);
+    }
+
+   Types::Value NotEqual::apply (const Input::Token& token, const Types::Value& LHS, const Types::Value& RHS)
+    {
+      Types::Value result;
+      if (false == Types::Value::numeric(INLINE_NOT_EQUAL, LHS, RHS, result))
+       {
+         result = Types::Value(apply(token, LHS.box(), RHS.box()));
+       }
+      return result;
+    }
+
+   std::shared_ptr<Types::ValueType> NotEqual::apply (const Input::Token& token, const std::shared_ptr<Types::ValueType>& LHS, const std::shared_ptr<Types::ValueType>& RHS)
+    {
       std::shared_ptr<Types::ValueType> result;
       switch (LHS->getType())
        {
@@ -666,7 +779,7 @@ namespace Engine
          case Types::STRING:
          case Types::CELL_REF:
          case Types::CELL_RANGE:
-            constructMessage("Error comparing " + LHS->getTypeName() + " with " + RHS->getTypeName());
+            constructMessage("Error comparing " + LHS->getTypeName() + " with " + RHS->getTypeName(), token);
           }
          break;
       case Types::STRING:
@@ -687,7 +800,7 @@ namespace Engine
          case Types::FLOAT:
          case Types::CELL_REF:
          case Types::CELL_RANGE:
-            constructMessage("Error comparing " + LHS->getTypeName() + " with " + RHS->getTypeName());
+            constructMessage("Error comparing " + LHS->getTypeName() + " with " + RHS->getTypeName(), token);
           }
          break;
       case Types::NIL:
@@ -710,12 +823,12 @@ namespace Engine
             break;
          case Types::CELL_REF:
          case Types::CELL_RANGE:
-            constructMessage("Error comparing " + LHS->getTypeName() + " with " + RHS->getTypeName());
+            constructMessage("Error comparing " + LHS->getTypeName() + " with " + RHS->getTypeName(), token);
           }
          break;
       case Types::CELL_REF:
       case Types::CELL_RANGE:
-         constructMessage("Error comparing " + LHS->getTypeName() + " with " + RHS->getTypeName());
+         constructMessage("Error comparing " + LHS->getTypeName() + " with " + RHS->getTypeName(), token);
        }
       return result;
     }
@@ -729,8 +842,28 @@ namespace Engine
 
    std::shared_ptr<Types::ValueType> Greater::evaluate (CallingContext& context) const
     {
-      std::shared_ptr<Types::ValueType> LHS = lhs->evaluate(context);
-      std::shared_ptr<Types::ValueType> RHS = rhs->evaluate(context);
+      return evaluateValue(context).box();
+    }
+
+   Types::Value Greater::evaluateValue (CallingContext& context) const
+    {
+      Types::Value LHS = lhs->evaluateValue(context);
+      Types::Value RHS = rhs->evaluateValue(context);
+      return apply(token, LHS, RHS);
+    }
+
+   Types::Value Greater::apply (const Input::Token& token, const Types::Value& LHS, const Types::Value& RHS)
+    {
+      Types::Value result;
+      if (false == Types::Value::numeric(INLINE_GREATER, LHS, RHS, result))
+       {
+         result = Types::Value(apply(token, LHS.box(), RHS.box()));
+       }
+      return result;
+    }
+
+   std::shared_ptr<Types::ValueType> Greater::apply (const Input::Token& token, const std::shared_ptr<Types::ValueType>& LHS, const std::shared_ptr<Types::ValueType>& RHS)
+    {
       std::shared_ptr<Types::ValueType> result;
       switch (LHS->getType())
        {
@@ -752,7 +885,7 @@ namespace Engine
          case Types::STRING:
          case Types::CELL_REF:
          case Types::CELL_RANGE:
-            constructMessage("Error comparing " + LHS->getTypeName() + " with " + RHS->getTypeName());
+            constructMessage("Error comparing " + LHS->getTypeName() + " with " + RHS->getTypeName(), token);
           }
          break;
       case Types::STRING:
@@ -773,7 +906,7 @@ namespace Engine
          case Types::FLOAT:
          case Types::CELL_REF:
          case Types::CELL_RANGE:
-            constructMessage("Error comparing " + LHS->getTypeName() + " with " + RHS->getTypeName());
+            constructMessage("Error comparing " + LHS->getTypeName() + " with " + RHS->getTypeName(), token);
           }
          break;
       case Types::NIL:
@@ -791,12 +924,12 @@ namespace Engine
             break;
          case Types::CELL_REF:
          case Types::CELL_RANGE:
-            constructMessage("Error comparing " + LHS->getTypeName() + " with " + RHS->getTypeName());
+            constructMessage("Error comparing " + LHS->getTypeName() + " with " + RHS->getTypeName(), token);
           }
          break;
       case Types::CELL_REF:
       case Types::CELL_RANGE:
-         constructMessage("Error comparing " + LHS->getTypeName() + " with " + RHS->getTypeName());
+         constructMessage("Error comparing " + LHS->getTypeName() + " with " + RHS->getTypeName(), token);
        }
       return result;
     }
@@ -810,8 +943,28 @@ namespace Engine
 
    std::shared_ptr<Types::ValueType> Less::evaluate (CallingContext& context) const
     {
-      std::shared_ptr<Types::ValueType> LHS = lhs->evaluate(context);
-      std::shared_ptr<Types::ValueType> RHS = rhs->evaluate(context);
+      return evaluateValue(context).box();
+    }
+
+   Types::Value Less::evaluateValue (CallingContext& context) const
+    {
+      Types::Value LHS = lhs->evaluateValue(context);
+      Types::Value RHS = rhs->evaluateValue(context);
+      return apply(token, LHS, RHS);
+    }
+
+   Types::Value Less::apply (const Input::Token& token, const Types::Value& LHS, const Types::Value& RHS)
+    {
+      Types::Value result;
+      if (false == Types::Value::numeric(INLINE_LESS, LHS, RHS, result))
+       {
+         result = Types::Value(apply(token, LHS.box(), RHS.box()));
+       }
+      return result;
+    }
+
+   std::shared_ptr<Types::ValueType> Less::apply (const Input::Token& token, const std::shared_ptr<Types::ValueType>& LHS, const std::shared_ptr<Types::ValueType>& RHS)
+    {
       std::shared_ptr<Types::ValueType> result;
       switch (LHS->getType())
        {
@@ -833,7 +986,7 @@ namespace Engine
          case Types::STRING:
          case Types::CELL_REF:
          case Types::CELL_RANGE:
-            constructMessage("Error comparing " + LHS->getTypeName() + " with " + RHS->getTypeName());
+            constructMessage("Error comparing " + LHS->getTypeName() + " with " + RHS->getTypeName(), token);
           }
          break;
       case Types::STRING:
@@ -851,7 +1004,7 @@ namespace Engine
          case Types::FLOAT:
          case Types::CELL_REF:
          case Types::CELL_RANGE:
-            constructMessage("Error comparing " + LHS->getTypeName() + " with " + RHS->getTypeName());
+            constructMessage("Error comparing " + LHS->getTypeName() + " with " + RHS->getTypeName(), token);
           }
          break;
       case Types::NIL:
@@ -874,12 +1027,12 @@ namespace Engine
             break;
          case Types::CELL_REF:
          case Types::CELL_RANGE:
-            constructMessage("Error comparing " + LHS->getTypeName() + " with " + RHS->getTypeName());
+            constructMessage("Error comparing " + LHS->getTypeName() + " with " + RHS->getTypeName(), token);
           }
          break;
       case Types::CELL_REF:
       case Types::CELL_RANGE:
-         constructMessage("Error comparing " + LHS->getTypeName() + " with " + RHS->getTypeName());
+         constructMessage("Error comparing " + LHS->getTypeName() + " with " + RHS->getTypeName(), token);
        }
       return result;
     }
@@ -893,8 +1046,28 @@ namespace Engine
 
    std::shared_ptr<Types::ValueType> GEQ::evaluate (CallingContext& context) const
     {
-      std::shared_ptr<Types::ValueType> LHS = lhs->evaluate(context);
-      std::shared_ptr<Types::ValueType> RHS = rhs->evaluate(context);
+      return evaluateValue(context).box();
+    }
+
+   Types::Value GEQ::evaluateValue (CallingContext& context) const
+    {
+      Types::Value LHS = lhs->evaluateValue(context);
+      Types::Value RHS = rhs->evaluateValue(context);
+      return apply(token, LHS, RHS);
+    }
+
+   Types::Value GEQ::apply (const Input::Token& token, const Types::Value& LHS, const Types::Value& RHS)
+    {
+      Types::Value result;
+      if (false == Types::Value::numeric(INLINE_GREATER_EQUAL, LHS, RHS, result))
+       {
+         result = Types::Value(apply(token, LHS.box(), RHS.box()));
+       }
+      return result;
+    }
+
+   std::shared_ptr<Types::ValueType> GEQ::apply (const Input::Token& token, const std::shared_ptr<Types::ValueType>& LHS, const std::shared_ptr<Types::ValueType>& RHS)
+    {
       std::shared_ptr<Types::ValueType> result;
       switch (LHS->getType())
        {
@@ -916,7 +1089,7 @@ namespace Engine
          case Types::STRING:
          case Types::CELL_REF:
          case Types::CELL_RANGE:
-            constructMessage("Error comparing " + LHS->getTypeName() + " with " + RHS->getTypeName());
+            constructMessage("Error comparing " + LHS->getTypeName() + " with " + RHS->getTypeName(), token);
           }
          break;
       case Types::STRING:
@@ -934,7 +1107,7 @@ namespace Engine
          case Types::FLOAT:
          case Types::CELL_REF:
          case Types::CELL_RANGE:
-            constructMessage("Error comparing " + LHS->getTypeName() + " with " + RHS->getTypeName());
+            constructMessage("Error comparing " + LHS->getTypeName() + " with " + RHS->getTypeName(), token);
           }
          break;
       case Types::NIL:
@@ -957,12 +1130,12 @@ namespace Engine
             break;
          case Types::CELL_REF:
          case Types::CELL_RANGE:
-            constructMessage("Error comparing " + LHS->getTypeName() + " with " + RHS->getTypeName());
+            constructMessage("Error comparing " + LHS->getTypeName() + " with " + RHS->getTypeName(), token);
           }
          break;
       case Types::CELL_REF:
       case Types::CELL_RANGE:
-         constructMessage("Error comparing " + LHS->getTypeName() + " with " + RHS->getTypeName());
+         constructMessage("Error comparing " + LHS->getTypeName() + " with " + RHS->getTypeName(), token);
        }
       return result;
     }
@@ -976,8 +1149,28 @@ namespace Engine
 
    std::shared_ptr<Types::ValueType> LEQ::evaluate (CallingContext& context) const
     {
-      std::shared_ptr<Types::ValueType> LHS = lhs->evaluate(context);
-      std::shared_ptr<Types::ValueType> RHS = rhs->evaluate(context);
+      return evaluateValue(context).box();
+    }
+
+   Types::Value LEQ::evaluateValue (CallingContext& context) const
+    {
+      Types::Value LHS = lhs->evaluateValue(context);
+      Types::Value RHS = rhs->evaluateValue(context);
+      return apply(token, LHS, RHS);
+    }
+
+   Types::Value LEQ::apply (const Input::Token& token, const Types::Value& LHS, const Types::Value& RHS)
+    {
+      Types::Value result;
+      if (false == Types::Value::numeric(INLINE_LESS_EQUAL, LHS, RHS, result))
+       {
+         result = Types::Value(apply(token, LHS.box(), RHS.box()));
+       }
+      return result;
+    }
+
+   std::shared_ptr<Types::ValueType> LEQ::apply (const Input::Token& token, const std::shared_ptr<Types::ValueType>& LHS, const std::shared_ptr<Types::ValueType>& RHS)
+    {
       std::shared_ptr<Types::ValueType> result;
       switch (LHS->getType())
        {
@@ -999,7 +1192,7 @@ namespace Engine
          case Types::STRING:
          case Types::CELL_REF:
          case Types::CELL_RANGE:
-            constructMessage("Error comparing " + LHS->getTypeName() + " with " + RHS->getTypeName());
+            constructMessage("Error comparing " + LHS->getTypeName() + " with " + RHS->getTypeName(), token);
           }
          break;
       case Types::STRING:
@@ -1020,7 +1213,7 @@ namespace Engine
          case Types::FLOAT:
          case Types::CELL_REF:
          case Types::CELL_RANGE:
-            constructMessage("Error comparing " + LHS->getTypeName() + " with " + RHS->getTypeName());
+            constructMessage("Error comparing " + LHS->getTypeName() + " with " + RHS->getTypeName(), token);
           }
          break;
       case Types::NIL:
@@ -1038,12 +1231,12 @@ namespace Engine
             break;
          case Types::CELL_REF:
          case Types::CELL_RANGE:
-            constructMessage("Error comparing " + LHS->getTypeName() + " with " + RHS->getTypeName());
+            constructMessage("Error comparing " + LHS->getTypeName() + " with " + RHS->getTypeName(), token);
           }
          break;
       case Types::CELL_REF:
       case Types::CELL_RANGE:
-         constructMessage("Error comparing " + LHS->getTypeName() + " with " + RHS->getTypeName());
+         constructMessage("Error comparing " + LHS->getTypeName() + " with " + RHS->getTypeName(), token);
        }
       return result;
     }
@@ -1060,7 +1253,26 @@ namespace Engine
 
    std::shared_ptr<Types::ValueType> Negate::evaluate (CallingContext& context) const
     {
-      std::shared_ptr<Types::ValueType> ARG = arg->evaluate(context);
+      return evaluateValue(context).box();
+    }
+
+   Types::Value Negate::evaluateValue (CallingContext& context) const
+    {
+      return apply(token, arg->evaluateValue(context));
+    }
+
+   Types::Value Negate::apply (const Input::Token& token, const Types::Value& ARG)
+    {
+      Types::Value result;
+      if (false == Types::Value::negate(ARG, result))
+       {
+         result = Types::Value(apply(token, ARG.box()));
+       }
+      return result;
+    }
+
+   std::shared_ptr<Types::ValueType> Negate::apply (const Input::Token& token, const std::shared_ptr<Types::ValueType>& ARG)
+    {
       std::shared_ptr<Types::ValueType> result;
       switch (ARG->getType())
        {
@@ -1073,7 +1285,7 @@ namespace Engine
       case Types::STRING:
       case Types::CELL_REF:
       case Types::CELL_RANGE:
-         constructMessage("Error negating " + ARG->getTypeName());
+         constructMessage("Error negating " + ARG->getTypeName(), token);
        }
       return result;
     }
@@ -1217,6 +1429,10 @@ namespace Engine
 
    std::shared_ptr<Types::ValueType> Name::evaluate (CallingContext& context) const
     {
+      if (nullptr != context.theSheet) // What a name means depends on what was evaluated before us.
+       {
+         context.theSheet->readVolatile(context);
+       }
       const auto iter = context.names->find(token.text);
       if (context.names->end() == iter)
        {
@@ -1233,6 +1449,57 @@ namespace Engine
       return "_" + token.text;
     }
 
+
+   Folded::Folded(const std::shared_ptr<Expression>& tree, const std::shared_ptr<Types::ValueType>& value) :
+      Expression(tree->token), tree(tree), value(value), system(&NumberSystem::getCurrentNumberSystem()),
+      precision(NumberSystem::getCurrentNumberSystem().getDefaultPrecision()), mode(NumberSystem::getRoundMode())
+    {
+    }
+
+   std::shared_ptr<Types::ValueType> Folded::evaluate (CallingContext& context) const
+    {
+      const NumberSystem& current = NumberSystem::getCurrentNumberSystem();
+      if ((system == &current) && (precision == current.getDefaultPrecision()) && (mode == NumberSystem::getRoundMode()))
+       {
+         return value;
+       }
+      return tree->evaluate(context);
+    }
+
+   std::string Folded::toString(size_t col, size_t row, int level) const
+    {
+      return tree->toString(col, row, level);
+    }
+
+
+   Shared::Shared(const std::shared_ptr<Expression>& tree) : Expression(tree->token), tree(tree)
+    {
+    }
+
+   std::shared_ptr<Types::ValueType> Shared::evaluate (CallingContext& context) const
+    {
+      CellFrame* frame = context.topCell();
+      if (nullptr == frame)
+       {
+         return tree->evaluate(context);
+       }
+      for (const std::pair<const Expression*, std::shared_ptr<Types::ValueType> >& computed : frame->shared)
+       {
+         if (this == computed.first)
+          {
+            return computed.second;
+          }
+       }
+      std::shared_ptr<Types::ValueType> result = tree->evaluate(context);
+      frame->shared.emplace_back(this, result);
+      return result;
+    }
+
+   std::string Shared::toString(size_t col, size_t row, int level) const
+    {
+      return tree->toString(col, row, level);
+    }
+
  } // namespace Forwards
 
  } // namespace Backwards
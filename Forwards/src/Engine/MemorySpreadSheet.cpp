@@ -140,11 +140,53 @@ namespace Engine
     {
     }
 
+   void MemorySpreadSheet::beginBatch()
+    {
+    }
+
+   void MemorySpreadSheet::endBatch()
+    {
+    }
+
    bool MemorySpreadSheet::isCellPresent(size_t col, size_t row)
     {
       return nullptr != getCellAt(col, row, "");
     }
 
+   std::unique_ptr<CellCursor> MemorySpreadSheet::getPresentCells(bool c_major, bool colsAscending, bool rowsAscending)
+    {
+      std::unique_ptr<VectorCursor> result = std::make_unique<VectorCursor>();
+      for (size_t col = 0U; col < sheet.size(); ++col)
+       {
+         for (size_t row = 0U; row < sheet[col].size(); ++row)
+          {
+            if (nullptr != sheet[col][row].get())
+             {
+               result->cells.emplace_back(col, row);
+             }
+          }
+       }
+
+      result->sort(c_major, colsAscending, rowsAscending);
+      return result;
+    }
+
+   std::unique_ptr<CellCursor> MemorySpreadSheet::getPresentCellsIn(size_t col1, size_t row1, size_t col2, size_t row2)
+    {
+      std::unique_ptr<VectorCursor> result = std::make_unique<VectorCursor>();
+      for (size_t col = col1; (col <= col2) && (col < sheet.size()); ++col)
+       {
+         for (size_t row = row1; (row <= row2) && (row < sheet[col].size()); ++row)
+          {
+            if (nullptr != sheet[col][row].get())
+             {
+               result->cells.emplace_back(col, row);
+             }
+          }
+       }
+      return result;
+    }
+
  } // namespace Engine
 
  } // namespace Forwards
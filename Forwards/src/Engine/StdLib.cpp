@@ -33,10 +33,19 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "Forwards/Engine/Expression.h"
 #include "Forwards/Engine/CallingContext.h"
+#include "Forwards/Engine/SpreadSheet.h"
 
 #include "Forwards/Engine/CellRefEval.h"
+#include "Forwards/Engine/CellRangeExpand.h"
 
+#include "Forwards/Types/FloatValue.h"
+#include "Forwards/Types/CellRangeValue.h"
+
+#include "Backwards/Types/ArrayValue.h"
+#include "Backwards/Types/DictionaryValue.h"
+#include "Backwards/Types/FloatValue.h"
 #include "Backwards/Types/CellRefValue.h"
+#include "Backwards/Types/CellRangeValue.h"
 #include "Backwards/Types/StringValue.h"
 
 #include "Backwards/Engine/StackFrame.h"
@@ -44,6 +53,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "Backwards/Engine/ProgrammingException.h"
 
+#include "NumberSystem.h"
+
+#include <string>
+
 namespace Forwards
  {
 
@@ -68,7 +81,12 @@ namespace Engine
                   throw Backwards::Engine::ProgrammingException("Cell Reference wasn't the right Cell Reference.");
                 }
 
-               text.names->insert(std::make_pair(name, last->value));
+                  // Say so before touching names: a parallel recalc has to stop before anyone does.
+               if (nullptr != text.theSheet)
+                {
+                  text.theSheet->readVolatile(text);
+                }
+               text.names->insert(std::make_pair(name, last->getExpression()));
              }
             else
              {
@@ -87,17 +105,351 @@ namespace Engine
       return first;
     }
 
+   /*
+      The spreadsheet aggregates: SUM, COUNT, MAX, MIN and AVERAGE.
+
+      These were library functions, and they keep the library's semantics: cell references are
+      evaluated, ranges are walked, numbers are kept and everything else is ignored. The library
+      versions called themselves on each range they found, and on each column of a two-dimensional
+      range, and folded in the result. We do the same, so that a sum adds in the same order.
+
+      What we don't do is make a cell reference for every cell in a range and evaluate it:
+      we record reading the range once and fetch only the cells that are present.
+   */
+   class AggregateFold
+    {
+   public:
+      virtual ~AggregateFold() { }
+      virtual void add(const std::shared_ptr<NumberHolder>& number) = 0;
+         // An empty fold of the same kind, for a range.
+      virtual std::unique_ptr<AggregateFold> fresh() const = 0;
+      virtual void merge(const AggregateFold& range) = 0;
+    };
+
+   class SumFold final : public AggregateFold
+    {
+   public:
+      std::shared_ptr<NumberHolder> value;
+
+      SumFold() : value(NumberSystem::getCurrentNumberSystem().fromString("0")) { }
+
+         // The value is made here and isn't handed out until the fold is done, so we can add to it in place.
+      virtual void add(const std::shared_ptr<NumberHolder>& number) override
+       {
+         value->addAssign(*number);
+       }
+
+      virtual std::unique_ptr<AggregateFold> fresh() const override
+       {
+         return std::make_unique<SumFold>();
+       }
+
+      virtual void merge(const AggregateFold& range) override
+       {
+         add(static_cast<const SumFold&>(range).value);
+       }
+    };
+
+   class CountFold final : public AggregateFold
+    {
+   public:
+      size_t value;
+
+      CountFold() : value(0U) { }
+
+      virtual void add(const std::shared_ptr<NumberHolder>&) override
+       {
+         ++value;
+       }
+
+      virtual std::unique_ptr<AggregateFold> fresh() const override
+       {
+         return std::make_unique<CountFold>();
+       }
+
+      virtual void merge(const AggregateFold& range) override
+       {
+         value += static_cast<const CountFold&>(range).value;
+       }
+
+      std::shared_ptr<NumberHolder> getValue() const
+       {
+         return NumberSystem::getCurrentNumberSystem().fromString(std::to_string(value));
+       }
+    };
+
+   class ExtremeFold final : public AggregateFold
+    {
+   public:
+      bool greatest;
+      std::shared_ptr<NumberHolder> value; // Null until we find a number.
+
+      explicit ExtremeFold(bool greatest) : greatest(greatest) { }
+
+         // As the Max and Min functions do it.
+      virtual void add(const std::shared_ptr<NumberHolder>& number) override
+       {
+         if (nullptr == value.get())
+          {
+            value = number;
+          }
+         else if (true == value->shortMinMax())
+          {
+          }
+         else if (true == number->shortMinMax())
+          {
+            value = number;
+          }
+         else if (false == (greatest ? (*value >= *number) : (*value <= *number)))
+          {
+            value = number;
+          }
+       }
+
+      virtual std::unique_ptr<AggregateFold> fresh() const override
+       {
+         return std::make_unique<ExtremeFold>(greatest);
+       }
+
+      virtual void merge(const AggregateFold& range) override
+       {
+         const ExtremeFold& other = static_cast<const ExtremeFold&>(range);
+         if (nullptr != other.value.get())
+          {
+            add(other.value);
+          }
+       }
+
+      std::shared_ptr<Backwards::Types::ValueType> getValue() const
+       {
+         if (nullptr == value.get())
+          {
+            return std::make_shared<Backwards::Types::StringValue>("Empty");
+          }
+         return std::make_shared<Backwards::Types::FloatValue>(value);
+       }
+    };
+
+   class AverageFold final : public AggregateFold
+    {
+   public:
+      SumFold sum;
+      CountFold count;
+
+      virtual void add(const std::shared_ptr<NumberHolder>& number) override
+       {
+         sum.add(number);
+         count.add(number);
+       }
+
+      virtual std::unique_ptr<AggregateFold> fresh() const override
+       {
+         return std::make_unique<AverageFold>();
+       }
+
+      virtual void merge(const AggregateFold& range) override
+       {
+         const AverageFold& other = static_cast<const AverageFold&>(range);
+         sum.merge(other.sum);
+         count.merge(other.count);
+       }
+    };
+
+   static void foldRange(CallingContext& context, AggregateFold& result, const Types::CellRangeValue& range);
+   static void foldItems(CallingContext& context, AggregateFold& result, const Backwards::Types::CellRangeValue& range);
+
+   static void foldCell(CallingContext& context, AggregateFold& result, const std::shared_ptr<Types::ValueType>& value)
+    {
+      switch (value->getType())
+       {
+      case Types::FLOAT:
+         result.add(static_cast<const Types::FloatValue&>(*value).value);
+         break;
+      case Types::CELL_RANGE:
+       {
+         const Types::CellRangeValue& range = static_cast<const Types::CellRangeValue&>(*value);
+         if (true == range.sheet.empty())
+          {
+            context.theSheet->readRange(context, range.col1, range.row1, range.col2, range.row2);
+          }
+         std::unique_ptr<AggregateFold> inner = result.fresh();
+         foldRange(context, *inner, range);
+         result.merge(*inner);
+       }
+         break;
+      case Types::CELL_REF:
+         throw Backwards::Engine::ProgrammingException("CellRefEval::evaluate did not resolve to a Backwards Type.");
+      default:
+         break;
+       }
+    }
+
+      // The read has been recorded: fetch what's there.
+   static void foldRange(CallingContext& context, AggregateFold& result, const Types::CellRangeValue& range)
+    {
+      if ((range.col1 == range.col2) || (range.row1 == range.row2))
+       {
+         context.theSheet->fetchPresentCells(context, range.col1, range.row1, range.col2, range.row2, range.sheet,
+            [&context, &result](size_t, const std::shared_ptr<Types::ValueType>& value) { foldCell(context, result, value); });
+       }
+      else
+       {
+            // Each column is a range of its own, even the empty ones.
+         size_t current = range.col1;
+         std::unique_ptr<AggregateFold> column = result.fresh();
+         context.theSheet->fetchPresentCells(context, range.col1, range.row1, range.col2, range.row2, range.sheet,
+            [&context, &result, &current, &column](size_t col, const std::shared_ptr<Types::ValueType>& value)
+             {
+               for (; current < col; ++current)
+                {
+                  result.merge(*column);
+                  column = result.fresh();
+                }
+               foldCell(context, *column, value);
+             });
+         for (; current < range.col2; ++current)
+          {
+            result.merge(*column);
+            column = result.fresh();
+          }
+         result.merge(*column);
+       }
+    }
+
+   static void foldItem(CallingContext& context, AggregateFold& result, const std::shared_ptr<Backwards::Types::ValueType>& item)
+    {
+      if (typeid(Backwards::Types::FloatValue) == typeid(*item))
+       {
+         result.add(static_cast<const Backwards::Types::FloatValue&>(*item).value);
+       }
+      else if (typeid(Backwards::Types::CellRefValue) == typeid(*item))
+       {
+         const std::shared_ptr<Backwards::Types::CellRefHolder>& ref = static_cast<const Backwards::Types::CellRefValue&>(*item).value;
+         const CellRefEval* eval = dynamic_cast<const CellRefEval*>(ref.get());
+         if (nullptr != eval)
+          {
+               // Stay in Forwards values: there's no need to make a Backwards one.
+            if (nullptr == eval->value.get())
+             {
+               foldCell(context, result, context.theSheet->fetchCell(context, eval->col, eval->row, eval->sheet));
+             }
+            else
+             {
+               foldCell(context, result, eval->value->evaluate(context));
+             }
+          }
+         else
+          {
+            const Backwards::Engine::CellRefEval* other = dynamic_cast<const Backwards::Engine::CellRefEval*>(ref.get());
+            if (nullptr == other)
+             {
+               throw Backwards::Engine::ProgrammingException("CellRefHolder is not a CellRefEval.");
+             }
+            foldItem(context, result, other->evaluate(context));
+          }
+       }
+      else if (typeid(Backwards::Types::CellRangeValue) == typeid(*item))
+       {
+         std::unique_ptr<AggregateFold> inner = result.fresh();
+         foldItems(context, *inner, static_cast<const Backwards::Types::CellRangeValue&>(*item));
+         result.merge(*inner);
+       }
+    }
+
+      // What "for item in range" would have seen.
+   static void foldItems(CallingContext& context, AggregateFold& result, const Backwards::Types::CellRangeValue& range)
+    {
+      const CellRangeExpand* expand = dynamic_cast<const CellRangeExpand*>(range.value.get());
+      if (nullptr != expand)
+       {
+         if (true == expand->value->sheet.empty())
+          {
+            context.theSheet->readRange(context, expand->value->col1, expand->value->row1, expand->value->col2, expand->value->row2);
+          }
+         foldRange(context, result, *expand->value);
+       }
+      else
+       {
+         for (size_t i = 0U; i < range.getSize(); ++i)
+          {
+            foldItem(context, result, range.getIndex(i));
+          }
+       }
+    }
+
+   static void fold(Backwards::Engine::CallingContext& context, AggregateFold& result, const std::shared_ptr<Backwards::Types::ValueType>& arg)
+    {
+      try
+       {
+         CallingContext& text = dynamic_cast<CallingContext&>(context);
+         if (typeid(Backwards::Types::ArrayValue) == typeid(*arg))
+          {
+            for (const auto& item : static_cast<const Backwards::Types::ArrayValue&>(*arg).value)
+             {
+               foldItem(text, result, item);
+             }
+          }
+         else if (typeid(Backwards::Types::CellRangeValue) == typeid(*arg))
+          {
+               foldItems(text, result, static_cast<const Backwards::Types::CellRangeValue&>(*arg));
+          }
+         else if (typeid(Backwards::Types::DictionaryValue) != typeid(*arg)) // A dictionary's items are arrays: there's nothing to count.
+          {
+            throw Backwards::Types::TypedOperationException("Error iterating over non-Collection.");
+          }
+       }
+      catch (const std::bad_cast&)
+       {
+         throw Backwards::Engine::ProgrammingException("Backwards context wasn't a Forwards context.");
+       }
+    }
+
+   STDLIB_UNARY_DECL_WITH_CONTEXT(Sum)
+    {
+      SumFold result;
+      fold(context, result, arg);
+      return std::make_shared<Backwards::Types::FloatValue>(result.value);
+    }
+
+   STDLIB_UNARY_DECL_WITH_CONTEXT(Count)
+    {
+      CountFold result;
+      fold(context, result, arg);
+      return std::make_shared<Backwards::Types::FloatValue>(result.getValue());
+    }
+
+   STDLIB_UNARY_DECL_WITH_CONTEXT(Maximum)
+    {
+      ExtremeFold result (true);
+      fold(context, result, arg);
+      return result.getValue();
+    }
+
+   STDLIB_UNARY_DECL_WITH_CONTEXT(Minimum)
+    {
+      ExtremeFold result (false);
+      fold(context, result, arg);
+      return result.getValue();
+    }
+
+   STDLIB_UNARY_DECL_WITH_CONTEXT(Average)
+    {
+      AverageFold result;
+      fold(context, result, arg);
+      return std::make_shared<Backwards::Types::FloatValue>(*result.sum.value / *result.count.getValue());
+    }
+
    StandardBinaryFunctionWithContext::StandardBinaryFunctionWithContext(BinaryFunctionPointerWithContext function) : Backwards::Engine::Statement(Backwards::Input::Token()), function(function)
     {
     }
 
-   std::shared_ptr<Backwards::Engine::FlowControl> StandardBinaryFunctionWithContext::execute (Backwards::Engine::CallingContext& context) const
+   Backwards::Engine::FlowControl StandardBinaryFunctionWithContext::execute (Backwards::Engine::CallingContext& context) const
     {
       std::shared_ptr<Backwards::Types::ValueType> lhs = context.currentFrame->args[0U];
       std::shared_ptr<Backwards::Types::ValueType> rhs = context.currentFrame->args[1U];
       try
        {
-         return std::make_shared<Backwards::Engine::FlowControl>(token, Backwards::Engine::FlowControl::RETURN, Backwards::Engine::FlowControl::NO_TARGET, function(context, lhs, rhs));
+         return Backwards::Engine::FlowControl(token, Backwards::Engine::FlowControl::RETURN, Backwards::Engine::FlowControl::NO_TARGET, function(context, lhs, rhs));
        }
       catch (const Backwards::Types::TypedOperationException& e)
        {
@@ -40,6 +40,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "Forwards/Engine/Expression.h"
 #include "Forwards/Engine/CallingContext.h"
+#include "Forwards/Engine/SpreadSheet.h"
 
 #include "Backwards/Types/StringValue.h"
 
@@ -56,6 +57,10 @@ namespace Engine
       try
        {
          CallingContext& text = dynamic_cast<CallingContext&>(context);
+         if (nullptr != text.theSheet) // We have no idea what the string will read.
+          {
+            text.theSheet->readVolatile(text);
+          }
          if (typeid(Backwards::Types::StringValue) == typeid(*arg))
           {
             Backwards::Input::StringInput string (static_cast<const Backwards::Types::StringValue&>(*arg).value);
@@ -48,6 +48,13 @@ namespace Parser
     // 1
       Backwards::Parser::ContextBuilder::addFunction("CellEval", std::make_shared<Backwards::Engine::StandardUnaryFunctionWithContext>(Engine::CellEval), 1U, global);
 
+    // 5
+      Backwards::Parser::ContextBuilder::addFunction("SUM", std::make_shared<Backwards::Engine::StandardUnaryFunctionWithContext>(Engine::Sum), 1U, global);
+      Backwards::Parser::ContextBuilder::addFunction("COUNT", std::make_shared<Backwards::Engine::StandardUnaryFunctionWithContext>(Engine::Count), 1U, global);
+      Backwards::Parser::ContextBuilder::addFunction("MAX", std::make_shared<Backwards::Engine::StandardUnaryFunctionWithContext>(Engine::Maximum), 1U, global);
+      Backwards::Parser::ContextBuilder::addFunction("MIN", std::make_shared<Backwards::Engine::StandardUnaryFunctionWithContext>(Engine::Minimum), 1U, global);
+      Backwards::Parser::ContextBuilder::addFunction("AVERAGE", std::make_shared<Backwards::Engine::StandardUnaryFunctionWithContext>(Engine::Average), 1U, global);
+
     // 1
       Backwards::Parser::ContextBuilder::addFunction("Let", std::make_shared<Forwards::Engine::StandardBinaryFunctionWithContext>(Engine::Let), 2U, global);
     }
@@ -0,0 +1,326 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2023, Thomas DiModica
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "Forwards/Parser/Optimizer.h"
+#include "Forwards/Engine/Expression.h"
+
+#include "Backwards/Types/ValueType.h"
+
+#include <set>
+#include <typeinfo>
+#include <vector>
+
+namespace Forwards
+ {
+
+namespace Parser
+ {
+
+      // The aggregates are ours: they only read cells. Anything a library defines could do anything.
+   static const std::set<std::string> PURE_FUNCTIONS { "SUM", "COUNT", "MAX", "MIN", "AVERAGE" };
+
+   static bool isConstant (const Engine::Expression* node)
+    {
+      if (typeid(Engine::Folded) == typeid(*node))
+       {
+         return true;
+       }
+      if (typeid(Engine::Constant) == typeid(*node))
+       {
+         Types::ValueTypes type = static_cast<const Engine::Constant*>(node)->value->getType();
+         return (Types::CELL_REF != type) && (Types::CELL_RANGE != type);
+       }
+      return false;
+    }
+
+   static const std::shared_ptr<Types::ValueType>& valueOf (const Engine::Expression* node)
+    {
+      if (typeid(Engine::Folded) == typeid(*node))
+       {
+         return static_cast<const Engine::Folded*>(node)->value;
+       }
+      return static_cast<const Engine::Constant*>(node)->value;
+    }
+
+      // The subtrees that are evaluated as expressions. Ranges and moved references want their raw references.
+   static void children (Engine::Expression* node, std::vector<std::shared_ptr<Engine::Expression>*>& out)
+    {
+      const std::type_info& type = typeid(*node);
+      if (typeid(Engine::Negate) == type)
+       {
+         out.push_back(&static_cast<Engine::Negate*>(node)->arg);
+       }
+      else if (typeid(Engine::FunctionCall) == type)
+       {
+         for (std::shared_ptr<Engine::Expression>& arg : static_cast<Engine::FunctionCall*>(node)->args)
+          {
+            out.push_back(&arg);
+          }
+       }
+#define BINARY_CHILDREN(x) \
+      else if (typeid(Engine::x) == type) \
+       { \
+         out.push_back(&static_cast<Engine::x*>(node)->lhs); \
+         out.push_back(&static_cast<Engine::x*>(node)->rhs); \
+       }
+      BINARY_CHILDREN(Plus)
+      BINARY_CHILDREN(Minus)
+      BINARY_CHILDREN(Multiply)
+      BINARY_CHILDREN(Divide)
+      BINARY_CHILDREN(Equals)
+      BINARY_CHILDREN(NotEqual)
+      BINARY_CHILDREN(Greater)
+      BINARY_CHILDREN(Less)
+      BINARY_CHILDREN(GEQ)
+      BINARY_CHILDREN(LEQ)
+      BINARY_CHILDREN(Cat)
+#undef BINARY_CHILDREN
+    }
+
+   std::shared_ptr<Engine::Expression> Optimizer::optimize (const std::shared_ptr<Engine::Expression>& tree, size_t col, size_t row)
+    {
+      std::shared_ptr<Engine::Expression> result = fold(tree);
+
+      Optimizer pass (col, row);
+      pass.count(result.get());
+      return pass.share(result);
+    }
+
+   std::shared_ptr<Engine::Expression> Optimizer::fold (const std::shared_ptr<Engine::Expression>& node)
+    {
+      const std::type_info& type = typeid(*node);
+      std::shared_ptr<Types::ValueType> result;
+      try
+       {
+         if (typeid(Engine::Negate) == type)
+          {
+            Engine::Negate* op = static_cast<Engine::Negate*>(node.get());
+            op->arg = fold(op->arg);
+            if (true == isConstant(op->arg.get()))
+             {
+               result = Engine::Negate::apply(op->token, valueOf(op->arg.get()));
+             }
+          }
+         else if (typeid(Engine::FunctionCall) == type)
+          {
+            for (std::shared_ptr<Engine::Expression>& arg : static_cast<Engine::FunctionCall*>(node.get())->args)
+             {
+               arg = fold(arg);
+             }
+          }
+#define FOLD_BINARY(x) \
+         else if (typeid(Engine::x) == type) \
+          { \
+            Engine::x* op = static_cast<Engine::x*>(node.get()); \
+            op->lhs = fold(op->lhs); \
+            op->rhs = fold(op->rhs); \
+            if ((true == isConstant(op->lhs.get())) && (true == isConstant(op->rhs.get()))) \
+             { \
+               result = Engine::x::apply(op->token, valueOf(op->lhs.get()), valueOf(op->rhs.get())); \
+             } \
+          }
+         FOLD_BINARY(Plus)
+         FOLD_BINARY(Minus)
+         FOLD_BINARY(Multiply)
+         FOLD_BINARY(Divide)
+         FOLD_BINARY(Equals)
+         FOLD_BINARY(NotEqual)
+         FOLD_BINARY(Greater)
+         FOLD_BINARY(Less)
+         FOLD_BINARY(GEQ)
+         FOLD_BINARY(LEQ)
+         FOLD_BINARY(Cat)
+#undef FOLD_BINARY
+       }
+      catch (const Backwards::Types::TypedOperationException&)
+       {
+            // Leave the error for evaluation, where it is reported with the cell.
+         result.reset();
+       }
+
+      if (nullptr != result.get())
+       {
+         return std::make_shared<Engine::Folded>(node, result);
+       }
+      return node;
+    }
+
+      // Two subtrees with the same key compute the same thing. An empty key means they might not:
+      // names can change while a cell is evaluated.
+   const std::string& Optimizer::key (const Engine::Expression* node)
+    {
+      const auto found = keys.find(node);
+      if (keys.end() != found)
+       {
+         return found->second;
+       }
+
+      std::string result;
+      const std::type_info& type = typeid(*node);
+      if (typeid(Engine::Constant) == type)
+       {
+         result = static_cast<const Engine::Constant*>(node)->value->getTypeName() + " " + node->toString(col, row, 0);
+       }
+      else if (typeid(Engine::Folded) == type)
+       {
+         result = key(static_cast<const Engine::Folded*>(node)->tree.get());
+       }
+      else if (typeid(Engine::Negate) == type)
+       {
+         const std::string& arg = key(static_cast<const Engine::Negate*>(node)->arg.get());
+         if (false == arg.empty())
+          {
+            result = "(-" + arg + ")";
+          }
+       }
+      else if (typeid(Engine::MakeRange) == type)
+       {
+         const std::string& lhs = key(static_cast<const Engine::MakeRange*>(node)->lhs.get());
+         const std::string& rhs = key(static_cast<const Engine::MakeRange*>(node)->rhs.get());
+         if ((false == lhs.empty()) && (false == rhs.empty()))
+          {
+            result = "(" + lhs + ":" + rhs + ")";
+          }
+       }
+      else if (typeid(Engine::MoveReference) == type)
+       {
+         const std::string& arg = key(static_cast<const Engine::MoveReference*>(node)->arg.get());
+         if (false == arg.empty())
+          {
+            result = "(" + arg + "!" + node->token.text + ")";
+          }
+       }
+      else if (typeid(Engine::FunctionCall) == type)
+       {
+         if (PURE_FUNCTIONS.end() != PURE_FUNCTIONS.find(node->token.text))
+          {
+            result = "@" + node->token.text + "(";
+            for (const std::shared_ptr<Engine::Expression>& arg : static_cast<const Engine::FunctionCall*>(node)->args)
+             {
+               const std::string& next = key(arg.get());
+               if (true == next.empty())
+                {
+                  result.clear();
+                  break;
+                }
+               result += next + ";";
+             }
+            if (false == result.empty())
+             {
+               result += ")";
+             }
+          }
+       }
+#define BINARY_KEY(x) \
+      else if (typeid(Engine::x) == type) \
+       { \
+         const std::string& lhs = key(static_cast<const Engine::x*>(node)->lhs.get()); \
+         const std::string& rhs = key(static_cast<const Engine::x*>(node)->rhs.get()); \
+         if ((false == lhs.empty()) && (false == rhs.empty())) \
+          { \
+            result = "(" + lhs + " " #x " " + rhs + ")"; \
+          } \
+       }
+      BINARY_KEY(Plus)
+      BINARY_KEY(Minus)
+      BINARY_KEY(Multiply)
+      BINARY_KEY(Divide)
+      BINARY_KEY(Equals)
+      BINARY_KEY(NotEqual)
+      BINARY_KEY(Greater)
+      BINARY_KEY(Less)
+      BINARY_KEY(GEQ)
+      BINARY_KEY(LEQ)
+      BINARY_KEY(Cat)
+#undef BINARY_KEY
+
+      return keys.emplace(node, result).first->second;
+    }
+
+      // Constants and references are as cheap to compute as to remember.
+   bool Optimizer::worthSharing (const Engine::Expression* node)
+    {
+      const std::type_info& type = typeid(*node);
+      if ((typeid(Engine::Constant) == type) || (typeid(Engine::Folded) == type) ||
+          (typeid(Engine::MakeRange) == type) || (typeid(Engine::MoveReference) == type))
+       {
+         return false;
+       }
+      return false == key(node).empty();
+    }
+
+   void Optimizer::count (const Engine::Expression* node)
+    {
+         // Don't count what is inside of a repeat: it will be computed with the first one.
+      if ((true == worthSharing(node)) && (++counts[key(node)] > 1U))
+       {
+         return;
+       }
+
+      std::vector<std::shared_ptr<Engine::Expression>*> next;
+      children(const_cast<Engine::Expression*>(node), next);
+      for (std::shared_ptr<Engine::Expression>* child : next)
+       {
+         count(child->get());
+       }
+    }
+
+   std::shared_ptr<Engine::Expression> Optimizer::share (const std::shared_ptr<Engine::Expression>& node)
+    {
+      const bool repeated = (true == worthSharing(node.get())) && (counts[key(node.get())] > 1U);
+      if (true == repeated)
+       {
+         const auto found = made.find(key(node.get()));
+         if (made.end() != found)
+          {
+            return found->second;
+          }
+       }
+
+      std::vector<std::shared_ptr<Engine::Expression>*> next;
+      children(node.get(), next);
+      for (std::shared_ptr<Engine::Expression>* child : next)
+       {
+         *child = share(*child);
+       }
+
+      if (true == repeated)
+       {
+         std::shared_ptr<Engine::Shared> result = std::make_shared<Engine::Shared>(node);
+         made.emplace(key(node.get()), result);
+         return result;
+       }
+      return node;
+    }
+
+ } // namespace Parser
+
+ } // namespace Forwards
@@ -0,0 +1,129 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2023, Thomas DiModica
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "Forwards/Parser/ParseCache.h"
+
+#include "Forwards/Engine/Expression.h"
+#include "Backwards/Input/StringInput.h"
+
+#include "Forwards/Types/CellRefValue.h"
+
+namespace Forwards
+ {
+
+namespace Parser
+ {
+
+   static const size_t DEFAULT_BUDGET = 16384U; // Distinct formulas, not cells.
+
+   template <class T>
+   static void put(std::string& out, T value)
+    {
+      out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+   ParseCache::ParseCache() : trees(), budget(DEFAULT_BUDGET)
+    {
+    }
+
+   std::shared_ptr<Engine::Expression> ParseCache::parse (const std::string& text, const Engine::GetterMap& scope, Backwards::Engine::Logger& logger, size_t col, size_t row)
+    {
+      std::string key = normalize(text, col, row);
+      if (false == key.empty())
+       {
+         auto needle = trees.find(key);
+         if (trees.end() != needle)
+          {
+            return needle->second;
+          }
+       }
+
+      Backwards::Input::StringInput interlinked (text);
+      Input::Lexer lexer (interlinked);
+      std::shared_ptr<Engine::Expression> result = Parser::ParseFullExpression(lexer, scope, logger, col, row);
+
+         // Failures aren't kept: a name that isn't a function now may be once a library loads.
+      if ((nullptr != result.get()) && (false == key.empty()))
+       {
+         if (trees.size() >= budget)
+          {
+            trees.clear();
+          }
+         trees.emplace(key, result);
+       }
+      return result;
+    }
+
+      // Every token's kind, location, and text, except that cell references are replaced by
+      // what the parser will make of them. Locations are kept so that the shared tree reports
+      // errors at the same places that a fresh parse of this text would.
+   std::string ParseCache::normalize (const std::string& text, size_t col, size_t row)
+    {
+      std::string result;
+      Backwards::Input::StringInput interlinked (text);
+      Input::Lexer lexer (interlinked);
+
+      for (;;)
+       {
+         Input::Token token = lexer.getNextToken();
+         if (Input::INVALID == token.lexeme)
+          {
+            return std::string();
+          }
+
+         result += static_cast<char>(token.lexeme);
+         put(result, token.location);
+         if (Input::CELL_REFERENCE == token.lexeme)
+          {
+            std::shared_ptr<Engine::Constant> ref = std::static_pointer_cast<Engine::Constant>(Parser::cellref(token, col, row));
+            const Types::CellRefValue& value = static_cast<const Types::CellRefValue&>(*ref->value);
+            result += static_cast<char>((value.colAbsolute ? 1 : 0) | (value.rowAbsolute ? 2 : 0));
+            put(result, value.colRef);
+            put(result, value.rowRef);
+          }
+         else
+          {
+            put(result, token.text.size());
+            result += token.text;
+          }
+
+         if (Input::END_OF_FILE == token.lexeme)
+          {
+            break;
+          }
+       }
+
+      return result;
+    }
+
+ } // namespace Parser
+
+ } // namespace Forwards
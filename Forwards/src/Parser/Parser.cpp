@@ -30,6 +30,7 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #include "Forwards/Parser/Parser.h"
+#include "Forwards/Parser/Optimizer.h"
 
 #include "Forwards/Engine/Expression.h"
 #include "Backwards/Engine/Logger.h"
@@ -68,6 +69,7 @@ namespace Parser
        {
          result = expression(src, scope, logger, col, row);
          expect(src, Input::END_OF_FILE, "End if Input");
+         result = Optimizer::optimize(result, col, row);
        }
       catch (const ParserException& e)
        {
@@ -37,12 +37,25 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "Forwards/Engine/CallingContext.h"
 #include "Forwards/Engine/Cell.h"
 #include "Forwards/Engine/Expression.h"
+#include "Forwards/Engine/Compiled.h"
 
 #include "Forwards/Parser/Parser.h"
 #include "Forwards/Parser/StringLogger.h"
 
 #include "Forwards/Types/ValueType.h"
 #include "Forwards/Types/StringValue.h"
+#include "Forwards/Types/NilValue.h"
+
+#include "NumberSystem.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
 
 /*
    This is purposely in Parser because it depends on Parser.
@@ -52,10 +65,628 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 namespace Forwards
  {
 
-namespace Engine
- {
+namespace Engine
+ {
+
+   static thread_local size_t currentWorker = 0U; // Which worker of a parallel recalc this thread is.
+
+      // Thrown to stop a parallel recalc that has found something whose result depends on the order.
+   class Abandoned final : public std::exception
+    {
+   public:
+      const char * what() const throw() { return "Recalc abandoned."; }
+    };
+
+      // Every worker logs to the same place.
+   class SharedLogger final : public Backwards::Engine::Logger
+    {
+   public:
+      explicit SharedLogger(Backwards::Engine::Logger* logger) : logger(logger) { }
+
+      void log (const std::string& message) override
+       {
+         std::lock_guard<std::mutex> hold (lock);
+         if (nullptr != logger)
+          {
+            logger->log(message);
+          }
+       }
+      std::string get () override
+       {
+         std::lock_guard<std::mutex> hold (lock);
+         return (nullptr != logger) ? logger->get() : std::string();
+       }
+
+   private:
+      Backwards::Engine::Logger* logger;
+      std::mutex lock;
+    };
+
+   /*
+      A recalc on several threads.
+
+      Every present cell is fetched up front, so that the holder is only used from one thread.
+      Each cell has an owner: no one, the worker computing it, or DONE. A worker claims a cell
+      before computing it. A worker that needs a cell that another is computing waits for it,
+      unless that would close a loop of waiting workers: then it takes the old value, just as
+      recursion does. So a cell that isn't part of a loop gets the same value in any order.
+
+      The order only makes it fast. A cell is ready once everything it read in the last recalc
+      is done; without a last recalc, everything is ready, in the usual order. Each worker takes
+      ready cells from the front of its own queue, and steals from the back of everyone else's.
+   */
+   class SpreadSheet::Recalculation final
+    {
+   public:
+      Recalculation(SpreadSheet& sheet, CallingContext& context, size_t threads);
+      ~Recalculation();
+
+         // Returns false if it was abandoned.
+      bool run();
+         // Compute whatever wasn't started, in order, after run.
+      void finishInOrder(CallingContext& context);
+
+      std::shared_ptr<Types::ValueType> fetch(CallingContext& context, size_t col, size_t row, const std::string& sheetName);
+      void fetchPresent(CallingContext& context, size_t col1, size_t row1, size_t col2, size_t row2, const PresentVisitor& visitor);
+      void readCell(size_t readerCol, size_t readerRow, size_t col1, size_t row1, size_t col2, size_t row2, bool range);
+      void readVolatile();
+
+   private:
+      static const size_t UNOWNED = 0U;
+      static const size_t DONE = ~static_cast<size_t>(0U);
+      static const size_t NOTHING = ~static_cast<size_t>(0U);
+      static const size_t RUN = 16U;
+
+      class Slot final
+       {
+      public:
+         Slot() : cell(nullptr), col(0U), row(0U), owner(UNOWNED), unfinished(0U), threw(false) { }
+
+         Cell* cell;
+         size_t col;
+         size_t row;
+         std::atomic<size_t> owner; // UNOWNED, the worker's index plus one, or DONE.
+         std::atomic<size_t> unfinished; // What it read last time that isn't done yet.
+         std::atomic<bool> threw; // Set before owner is DONE.
+         std::vector<size_t> readers; // The slots that read it last time.
+       };
+
+      class Read final
+       {
+      public:
+         Read(size_t reader, size_t col1, size_t row1, size_t col2, size_t row2, bool range) :
+            reader(reader), col1(col1), row1(row1), col2(col2), row2(row2), range(range) { }
+
+         size_t reader;
+         size_t col1;
+         size_t row1;
+         size_t col2;
+         size_t row2;
+         bool range;
+       };
+
+      class Worker final
+       {
+      public:
+         Worker() : waitingFor(NOTHING) { }
+
+         CallingContext context;
+         std::mutex lock; // Guards ready.
+         std::deque<size_t> ready;
+         size_t waitingFor; // Guarded by waitLock.
+         std::vector<Read> reads; // Handed to the dependency graph once everyone is done.
+         std::vector<Cell*> stashes;
+       };
+
+      SpreadSheet& sheet;
+      CallingContext& context;
+      SharedLogger logger;
+      NumberSystem_Round_Mode roundMode; // Each thread has its own: the workers start with ours.
+      size_t precision;
+
+      std::vector<Slot> slots; // In the usual order.
+      std::unordered_map<size_t, size_t> index; // Cell ID to slot.
+      std::map<size_t, std::vector<std::pair<size_t, size_t> > > columns; // Row and slot, by column: for finding the cells in a range.
+      std::vector<std::unique_ptr<Worker> > workers;
+
+      std::atomic<size_t> idle;
+      std::atomic<bool> finished;
+      std::atomic<bool> abandoned;
+
+      std::mutex idleLock;
+      std::condition_variable workQueued; // Wakes idle workers: there is work, or everything is finished.
+
+      std::mutex waitLock;
+      std::condition_variable cellDone;
+      std::atomic<size_t> waiters;
+
+      std::mutex holderLock; // For reading other sheets.
+
+      void addReader(size_t slot, size_t reader);
+      void work(size_t worker);
+      bool next(size_t worker, size_t& slot);
+      bool hasWork();
+      void queue(Worker& worker, size_t slot);
+      void stop();
+      void abandon();
+      std::shared_ptr<Types::ValueType> compute(CallingContext& context, size_t slot, bool rethrow);
+      std::shared_ptr<Types::ValueType> settle(size_t slot, size_t owner);
+      bool wait(size_t slot);
+      bool wouldDeadlock(size_t slot);
+      void finish(size_t slot, bool stash);
+    };
+
+   SpreadSheet::Recalculation::Recalculation(SpreadSheet& sheet, CallingContext& context, size_t threads) :
+      sheet(sheet), context(context), logger(context.logger), idle(0U), finished(false), abandoned(false), waiters(0U)
+    {
+      roundMode = NumberSystem::getRoundMode();
+      precision = NumberSystem::getCurrentNumberSystem().getDefaultPrecision();
+
+      std::vector<std::pair<size_t, size_t> > positions;
+      std::unique_ptr<CellCursor> cursor = sheet.currentSheet->getPresentCells(sheet.c_major, sheet.colsAscending(), sheet.rowsAscending());
+      size_t col, row;
+      while (true == cursor->next(col, row))
+       {
+         positions.emplace_back(col, row);
+       }
+
+      slots = std::vector<Slot>(positions.size());
+      for (size_t i = 0U; i < positions.size(); ++i)
+       {
+         slots[i].col = positions[i].first;
+         slots[i].row = positions[i].second;
+         slots[i].cell = sheet.currentSheet->getCellAt(slots[i].col, slots[i].row, "");
+         index.emplace(DependencyGraph::makeCellId(slots[i].col, slots[i].row), i);
+         columns[slots[i].col].emplace_back(slots[i].row, i);
+       }
+      for (auto& column : columns)
+       {
+         std::sort(column.second.begin(), column.second.end());
+       }
+
+      if (true == sheet.dependencies.isValidFor(sheet.currentSheet))
+       {
+         for (size_t i = 0U; i < slots.size(); ++i)
+          {
+            const DependencyGraph::Reads* reads = sheet.dependencies.getReads(DependencyGraph::makeCellId(slots[i].col, slots[i].row));
+            if (nullptr == reads)
+             {
+               continue;
+             }
+            for (size_t id : reads->cells)
+             {
+               auto needle = index.find(id);
+               if (index.end() != needle)
+                {
+                  addReader(needle->second, i);
+                }
+             }
+            for (const DependencyGraph::RangeRead& range : reads->ranges)
+             {
+               for (auto column = columns.lower_bound(range.col1); (columns.end() != column) && (column->first <= range.col2); ++column)
+                {
+                  auto cell = std::lower_bound(column->second.begin(), column->second.end(), std::make_pair(range.row1, static_cast<size_t>(0U)));
+                  for (; (column->second.end() != cell) && (cell->first <= range.row2); ++cell)
+                   {
+                     addReader(cell->second, i);
+                   }
+                }
+             }
+          }
+       }
+
+      for (size_t i = 0U; i < threads; ++i)
+       {
+         workers.emplace_back(std::make_unique<Worker>());
+         CallingContext& local = workers.back()->context;
+         local.logger = &logger;
+         local.globalScope = context.globalScope;
+         local.maxDepth = context.maxDepth;
+         if (nullptr != context.topScope())
+          {
+            local.pushScope(context.topScope());
+          }
+         local.generation = context.generation;
+         local.theSheet = &sheet;
+         local.map = context.map;
+         local.names = context.names;
+       }
+
+         // Deal out what is ready in small runs, so that the workers move through the sheet together.
+         // A worker far ahead of the others would compute what it needs itself, as deep as it goes.
+      size_t dealt = 0U;
+      for (size_t i = 0U; i < slots.size(); ++i)
+       {
+         if (0U == slots[i].unfinished)
+          {
+            workers[(dealt / RUN) % threads]->ready.push_back(i);
+            ++dealt;
+          }
+       }
+    }
+
+   SpreadSheet::Recalculation::~Recalculation()
+    {
+      for (Slot& slot : slots)
+       {
+         sheet.currentSheet->returnCell(slot.cell);
+       }
+    }
+
+   void SpreadSheet::Recalculation::addReader(size_t slot, size_t reader)
+    {
+      if (slot != reader)
+       {
+         slots[slot].readers.push_back(reader);
+         ++slots[reader].unfinished;
+       }
+    }
+
+   bool SpreadSheet::Recalculation::run()
+    {
+      std::vector<std::thread> threads;
+      for (size_t i = 1U; i < workers.size(); ++i)
+       {
+         threads.emplace_back(&Recalculation::work, this, i);
+       }
+      work(0U);
+      for (std::thread& thread : threads)
+       {
+         thread.join();
+       }
+
+      if (true == abandoned)
+       {
+         return false;
+       }
+
+      for (const auto& worker : workers)
+       {
+         for (const Read& read : worker->reads)
+          {
+            size_t readerCol = DependencyGraph::getColumn(read.reader);
+            size_t readerRow = DependencyGraph::getRow(read.reader);
+            if (true == read.range)
+             {
+               sheet.dependencies.addRange(readerCol, readerRow, read.col1, read.row1, read.col2, read.row2);
+             }
+            else
+             {
+               sheet.dependencies.addCell(readerCol, readerRow, read.col1, read.row1);
+             }
+          }
+         for (Cell* cell : worker->stashes)
+          {
+            sheet.stashResult(cell, context.generation);
+          }
+       }
+      return true;
+    }
+
+   void SpreadSheet::Recalculation::finishInOrder(CallingContext& context)
+    {
+      for (Slot& slot : slots)
+       {
+         if (DONE != slot.owner)
+          {
+            (void) sheet.computeCell(context, slot.col, slot.row, false);
+          }
+       }
+    }
+
+   void SpreadSheet::Recalculation::work(size_t worker)
+    {
+      currentWorker = worker;
+      NumberSystem::getCurrentNumberSystem().setRoundMode(roundMode);
+      NumberSystem::getCurrentNumberSystem().setDefaultPrecision(precision);
+
+      size_t slot;
+      while (false == finished)
+       {
+         if (true == next(worker, slot))
+          {
+            size_t owner = UNOWNED;
+            if (true == slots[slot].owner.compare_exchange_strong(owner, worker + 1U))
+             {
+               try
+                {
+                  (void) compute(workers[worker]->context, slot, false);
+                }
+               catch (...)
+                {
+                     // Whatever this was, doing it in order will find it again.
+                  abandoned = true;
+                  stop();
+                }
+             }
+            continue;
+          }
+
+            // Out of work. Only busy workers make more, so if everyone is out, then we're done.
+         if (workers.size() == ++idle)
+          {
+            stop();
+          }
+          {
+            std::unique_lock<std::mutex> hold (idleLock);
+            while ((false == finished) && (false == hasWork()))
+             {
+               workQueued.wait(hold);
+             }
+          }
+         --idle;
+       }
+    }
+
+   bool SpreadSheet::Recalculation::next(size_t worker, size_t& slot)
+    {
+      Worker& self = *workers[worker];
+       {
+         std::lock_guard<std::mutex> hold (self.lock);
+         if (false == self.ready.empty())
+          {
+            slot = self.ready.front();
+            self.ready.pop_front();
+            return true;
+          }
+       }
+      for (size_t i = 1U; i < workers.size(); ++i)
+       {
+         Worker& other = *workers[(worker + i) % workers.size()];
+         std::lock_guard<std::mutex> hold (other.lock);
+         if (false == other.ready.empty())
+          {
+            slot = other.ready.back();
+            other.ready.pop_back();
+            return true;
+          }
+       }
+      return false;
+    }
+
+   bool SpreadSheet::Recalculation::hasWork()
+    {
+      for (const auto& worker : workers)
+       {
+         std::lock_guard<std::mutex> hold (worker->lock);
+         if (false == worker->ready.empty())
+          {
+            return true;
+          }
+       }
+      return false;
+    }
+
+   void SpreadSheet::Recalculation::queue(Worker& worker, size_t slot)
+    {
+       {
+         std::lock_guard<std::mutex> hold (worker.lock);
+         worker.ready.push_front(slot);
+       }
+         // An idle worker counts itself before it looks for work, so it either finds this or hears about it.
+      if (0U != idle)
+       {
+         std::lock_guard<std::mutex> hold (idleLock);
+         workQueued.notify_all();
+       }
+    }
+
+   void SpreadSheet::Recalculation::stop()
+    {
+      std::lock_guard<std::mutex> hold (idleLock);
+      finished = true;
+      workQueued.notify_all();
+    }
+
+      // The slot must be claimed.
+   std::shared_ptr<Types::ValueType> SpreadSheet::Recalculation::compute(CallingContext& context, size_t slot, bool rethrow)
+    {
+      std::shared_ptr<Types::ValueType> OUT;
+      std::string message;
+      bool evaluated;
+      try
+       {
+         evaluated = sheet.evaluate(context, slots[slot].cell, slots[slot].col, slots[slot].row, true, OUT, message);
+       }
+      catch (const Abandoned&)
+       {
+         finish(slot, false);
+         throw;
+       }
+      catch (...)
+       {
+            // Whoever reads this later needs to know: see fetch.
+         slots[slot].threw = true;
+         finish(slot, true);
+         if (true == rethrow)
+          {
+            throw;
+          }
+         return OUT;
+       }
+      finish(slot, evaluated);
+      return OUT;
+    }
+
+   void SpreadSheet::Recalculation::finish(size_t slot, bool stash)
+    {
+      Worker& self = *workers[currentWorker];
+      if (true == stash)
+       {
+         self.stashes.push_back(slots[slot].cell);
+       }
+
+      slots[slot].owner = DONE;
+      if (0U != waiters)
+       {
+         std::lock_guard<std::mutex> hold (waitLock);
+         cellDone.notify_all();
+       }
+
+      for (size_t reader : slots[slot].readers)
+       {
+         if (1U == slots[reader].unfinished--)
+          {
+            queue(self, reader);
+          }
+       }
+    }
+
+   std::shared_ptr<Types::ValueType> SpreadSheet::Recalculation::fetch(CallingContext& context, size_t col, size_t row, const std::string& sheetName)
+    {
+      std::shared_ptr<Types::ValueType> result;
+      if (false == sheetName.empty())
+       {
+            // Nothing to compute on another sheet, but its holder isn't ours.
+         std::lock_guard<std::mutex> hold (holderLock);
+         AutoCell cell (&sheet, sheet.getCellAt(col, row, sheetName));
+         if (nullptr != cell.cell)
+          {
+            result = cell.cell->previousValue;
+            cell.cell->recursed = true;
+          }
+       }
+      else
+       {
+         auto needle = index.find(DependencyGraph::makeCellId(col, row));
+         if (index.end() != needle)
+          {
+               // In order, a cell computed before its reader has already failed quietly. A cell computed after
+               // its reader fails into whichever reader gets to it first: we can't know that that is us.
+            CellFrame* reader = context.topCell();
+            bool before = (nullptr == reader) ||
+               (true == sheet.evaluatedBefore(DependencyGraph::makeCellId(col, row), DependencyGraph::makeCellId(reader->col, reader->row)));
+
+            size_t owner = UNOWNED;
+            if (true == slots[needle->second].owner.compare_exchange_strong(owner, currentWorker + 1U))
+             {
+               try
+                {
+                  result = compute(context, needle->second, false == before);
+                }
+               catch (const Abandoned&)
+                {
+                  throw;
+                }
+               catch (...)
+                {
+                  abandon();
+                }
+             }
+            else
+             {
+               result = settle(needle->second, owner);
+               if ((false == before) && (true == slots[needle->second].threw))
+                {
+                  abandon();
+                }
+             }
+          }
+       }
+
+      if (nullptr == result.get())
+       {
+         result = std::make_shared<Types::NilValue>();
+       }
+      return result;
+    }
+
+      // The holder isn't ours to use while the workers run, but we know where every cell is.
+   void SpreadSheet::Recalculation::fetchPresent(CallingContext& context, size_t col1, size_t row1, size_t col2, size_t row2, const PresentVisitor& visitor)
+    {
+      for (auto column = columns.lower_bound(col1); (columns.end() != column) && (column->first <= col2); ++column)
+       {
+         auto cell = std::lower_bound(column->second.begin(), column->second.end(), std::make_pair(row1, static_cast<size_t>(0U)));
+         for (; (column->second.end() != cell) && (cell->first <= row2); ++cell)
+          {
+            visitor(column->first, fetch(context, column->first, cell->first, ""));
+          }
+       }
+    }
+
+   std::shared_ptr<Types::ValueType> SpreadSheet::Recalculation::settle(size_t slot, size_t owner)
+    {
+      Cell* cell = slots[slot].cell;
+      if (currentWorker + 1U == owner)
+       {
+            // We are currently evaluating this cell.
+         cell->recursed = true;
+       }
+      else if (DONE != owner)
+       {
+         (void) wait(slot);
+       }
+      return cell->previousValue;
+    }
+
+      // Returns false if the wait would never end: we are (indirectly) what it is waiting for.
+   bool SpreadSheet::Recalculation::wait(size_t slot)
+    {
+      Worker& self = *workers[currentWorker];
+      std::unique_lock<std::mutex> hold (waitLock);
+      ++waiters;
+      self.waitingFor = slot;
+
+      bool result = true;
+      while (DONE != slots[slot].owner)
+       {
+         if (true == wouldDeadlock(slot))
+          {
+               // It's a loop: treat it like one.
+            slots[slot].cell->recursed = true;
+            result = false;
+            break;
+          }
+         cellDone.wait(hold);
+       }
+
+      self.waitingFor = NOTHING;
+      --waiters;
+      return result;
+    }
+
+      // Follow who is waiting for whom: waitLock must be held.
+   bool SpreadSheet::Recalculation::wouldDeadlock(size_t slot)
+    {
+      size_t owner = slots[slot].owner;
+      for (size_t steps = 0U; steps < workers.size(); ++steps)
+       {
+         if ((UNOWNED == owner) || (DONE == owner))
+          {
+            return false;
+          }
+         if (currentWorker + 1U == owner)
+          {
+            return true;
+          }
+         size_t waitingFor = workers[owner - 1U]->waitingFor;
+         if (NOTHING == waitingFor)
+          {
+            return false;
+          }
+         owner = slots[waitingFor].owner;
+       }
+      return false;
+    }
+
+   void SpreadSheet::Recalculation::readCell(size_t readerCol, size_t readerRow, size_t col1, size_t row1, size_t col2, size_t row2, bool range)
+    {
+      workers[currentWorker]->reads.emplace_back(DependencyGraph::makeCellId(readerCol, readerRow), col1, row1, col2, row2, range);
+    }
+
+   void SpreadSheet::Recalculation::readVolatile()
+    {
+      abandon();
+    }
+
+   void SpreadSheet::Recalculation::abandon()
+    {
+      abandoned = true;
+      stop();
+      throw Abandoned();
+    }
 
-   SpreadSheet::SpreadSheet() : currentSheet(nullptr), c_major(true), top_down(true), left_right(true)
+   SpreadSheet::SpreadSheet() : currentSheet(nullptr), c_major(true), top_down(true), left_right(true), threads(1U), compiled(false), running(nullptr)
     {
     }
 
@@ -87,6 +718,7 @@ namespace Engine
    void SpreadSheet::initCellAt(size_t col, size_t row)
     {
       currentSheet->initCellAt(col, row);
+      dependencies.markCell(col, row);
     }
 
    void SpreadSheet::returnCell(Cell* cell)
@@ -97,16 +729,19 @@ namespace Engine
    void SpreadSheet::clearCellAt(size_t col, size_t row)
     {
       currentSheet->clearCellAt(col, row);
+      dependencies.markCell(col, row);
     }
 
    void SpreadSheet::clearColumn(size_t col)
     {
       currentSheet->clearColumn(col);
+      dependencies.markColumn(col);
     }
 
    void SpreadSheet::clearRow(size_t row)
     {
       currentSheet->clearRow(row);
+      dependencies.markRow(row);
     }
 
    void SpreadSheet::makeEvergreen(Cell* cell)
@@ -117,6 +752,10 @@ namespace Engine
    void SpreadSheet::commitCell(Cell* cell)
     {
       currentSheet->commitCell(cell);
+      if (nullptr != cell)
+       {
+         dependencies.markCell(cell->col, cell->row);
+       }
     }
 
    void SpreadSheet::dispose(Cell* cell)
@@ -140,74 +779,31 @@ namespace Engine
        {
          return result;
        }
-      CellFrame newFrame (cell.cell, col, row);
 
          // If we have already evaluated this cell this generation, stop.
-      if ((context.generation == cell.cell->previousGeneration) && (nullptr != cell.cell->value.get()))
+      if ((true == isCurrent(context, cell.cell, col, row)) && (nullptr != cell.cell->value.get()))
        {
          OUT = cell.cell->previousValue;
          return result;
        }
-
-         // If this is a LABEL, then set the value.
-      std::shared_ptr<Expression> value = cell.cell->value;
-      if ((LABEL == cell.cell->type) && (nullptr == value.get()))
-       {
-         value = std::make_shared<Constant>(Input::Token(), std::make_shared<Types::StringValue>(cell.cell->currentInput));
-       }
-         // Else, this is a VALUE, and we need to parse it.
-      if (nullptr == value.get())
-       {
-         Backwards::Input::StringInput interlinked (cell.cell->currentInput);
-         Input::Lexer lexer (interlinked);
-         Backwards::Engine::Logger* temp = context.logger;
-         Parser::StringLogger newLogger;
-         context.logger = &newLogger;
-         value = Parser::Parser::ParseFullExpression(lexer, *context.map, *context.logger, col, row);
-         context.logger = temp;
-         if (newLogger.logs.size() > 0U)
-          {
-            result = newLogger.logs[0U];
-          }
-       }
-
-         // If the parse failed, leave. Result will have the first parser message.
-      if (nullptr == value.get())
-       {
-         return result;
-       }
-
-         // If this is a regular update, update the cell. Eww....
       if (false == context.inUserInput)
        {
-         cell.cell->currentInput = "";
-         cell.cell->value = value;
+         dependencies.forgetReads(col, row);
        }
 
       try
        {
-         context.pushCell(&newFrame);
-            // Evaluate the new cell.
-         context.topCell()->cell->inEvaluation = true;
-         context.topCell()->cell->recursed = false;
-         OUT = value->evaluate(context);
-         context.topCell()->cell->inEvaluation = false;
-         context.topCell()->cell->previousGeneration = context.generation;
-         context.topCell()->cell->previousValue = OUT;
-         context.popCell();
+         if (false == evaluate(context, cell.cell, col, row, true, OUT, result))
+          {
+            return result; // Result will have the first parser message.
+          }
        }
       catch (const std::exception& e)
        {
          result = e.what();
-         context.topCell()->cell->inEvaluation = false;
-         context.topCell()->cell->previousGeneration = context.generation;
-         context.topCell()->cell->previousValue = OUT;
-         context.popCell();
        }
       catch (...)
        {
-         context.topCell()->cell->inEvaluation = false;
-         context.popCell();
        }
 
       stashResult(cell.cell, context.generation);
@@ -230,43 +826,77 @@ namespace Engine
        {
          return OUT;
        }
-      CellFrame newFrame (cell.cell, col, row);
 
          // If we have already evaluated this cell this generation, stop.
-      if (context.generation == cell.cell->previousGeneration)
+      if (true == isCurrent(context, cell.cell, col, row))
        {
          return cell.cell->previousValue;
        }
+      if (false == context.inUserInput)
+       {
+         dependencies.forgetReads(col, row);
+       }
+
+      std::string message;
+      try
+       {
+         if (true == evaluate(context, cell.cell, col, row, rethrow, OUT, message))
+          {
+            stashResult(cell.cell, context.generation);
+          }
+       }
+      catch (...)
+       {
+            // The cell was computed this generation, even though it failed: the holder may not keep our copy.
+         stashResult(cell.cell, context.generation);
+         throw;
+       }
+
+      return OUT;
+    }
+
+      // Returns false if the cell couldn't be parsed, with the first parser message in message.
+   bool SpreadSheet::evaluate(CallingContext& context, Cell* cell, size_t col, size_t row, bool rethrow, std::shared_ptr<Types::ValueType>& OUT, std::string& message)
+    {
+      CellFrame newFrame (cell, col, row);
 
          // If this is a LABEL, then set the value.
-      std::shared_ptr<Expression> value = cell.cell->value;
-      if ((LABEL == cell.cell->type) && (nullptr == value.get()))
+      std::shared_ptr<Expression> value = cell->value;
+      if ((LABEL == cell->type) && (nullptr == value.get()))
        {
-         value = std::make_shared<Constant>(Input::Token(), std::make_shared<Types::StringValue>(cell.cell->currentInput));
+         value = std::make_shared<Constant>(Input::Token(), std::make_shared<Types::StringValue>(cell->currentInput));
        }
          // Else, this is a VALUE, and we need to parse it.
       if (nullptr == value.get())
        {
-         Backwards::Input::StringInput interlinked (cell.cell->currentInput);
+         Backwards::Input::StringInput interlinked (cell->currentInput);
          Input::Lexer lexer (interlinked);
          Backwards::Engine::Logger* temp = context.logger;
          Parser::StringLogger newLogger;
          context.logger = &newLogger;
          value = Parser::Parser::ParseFullExpression(lexer, *context.map, *context.logger, col, row);
          context.logger = temp;
+         if (newLogger.logs.size() > 0U)
+          {
+            message = newLogger.logs[0U];
+          }
        }
 
-         // If the parse failed, leave. Result will have the first parser message.
+         // If the parse failed, leave.
       if (nullptr == value.get())
        {
-         return OUT;
+         return false;
        }
 
          // If this is a regular update, update the cell. Eww....
       if (false == context.inUserInput)
        {
-         cell.cell->currentInput = "";
-         cell.cell->value = value;
+         if (true == compiled)
+          {
+            value = Compiled::compile(value);
+          }
+         cell->currentInput = "";
+         cell->value = value;
        }
 
       try
@@ -293,9 +923,90 @@ namespace Engine
           }
        }
 
-      stashResult(cell.cell, context.generation);
+      return true;
+    }
 
-      return OUT;
+   std::shared_ptr<Types::ValueType> SpreadSheet::fetchCell(CallingContext& context, size_t col, size_t row, const std::string& sheet)
+    {
+      if (true == sheet.empty())
+       {
+         readCell(context, col, row);
+       }
+      return fetchReadCell(context, col, row, sheet);
+    }
+
+   void SpreadSheet::fetchPresentCells(CallingContext& context, size_t col1, size_t row1, size_t col2, size_t row2, const std::string& sheet, const PresentVisitor& visitor)
+    {
+      if (false == sheet.empty())
+       {
+            // Other sheets are found by name through ours: there's no asking them what's present.
+         for (size_t col = col1; col <= col2; ++col)
+          {
+            for (size_t row = row1; row <= row2; ++row)
+             {
+               visitor(col, fetchReadCell(context, col, row, sheet));
+             }
+          }
+         return;
+       }
+
+      if (nullptr != running)
+       {
+         running->fetchPresent(context, col1, row1, col2, row2, visitor);
+         return;
+       }
+
+         // Computing a cell may write to the holder, so don't hold its cursor open while we do.
+      std::vector<std::pair<size_t, size_t> > positions;
+      std::unique_ptr<CellCursor> cursor = currentSheet->getPresentCellsIn(col1, row1, col2, row2);
+      size_t col, row;
+      while (true == cursor->next(col, row))
+       {
+         positions.emplace_back(col, row);
+       }
+      cursor.reset();
+
+      for (const auto& position : positions)
+       {
+         visitor(position.first, fetchReadCell(context, position.first, position.second, ""));
+       }
+    }
+
+   std::shared_ptr<Types::ValueType> SpreadSheet::fetchReadCell(CallingContext& context, size_t col, size_t row, const std::string& sheet)
+    {
+      if (nullptr != running)
+       {
+         return running->fetch(context, col, row, sheet);
+       }
+
+      AutoCell cell (this, getCellAt(col, row, sheet));
+         // If no cell, Nil.
+      if (nullptr == cell.cell)
+       {
+         return std::make_shared<Types::NilValue>();
+       }
+
+         // If we are currently evaluating this cell, stop.
+         // If we got this from another sheet, then there is nothing to compute.
+      if ((true == cell.cell->inEvaluation) || (false == sheet.empty()))
+       {
+         std::shared_ptr<Types::ValueType> result = cell.cell->previousValue;
+         if (nullptr == result.get())
+          {
+            result = std::make_shared<Types::NilValue>();
+          }
+         cell.cell->recursed = true;
+         return result;
+       }
+
+         // Guess we need to do work.
+      std::shared_ptr<Types::ValueType> result;
+      result = computeCell(context, col, row, true);
+      if (nullptr == result.get())
+       {
+         result = std::make_shared<Types::NilValue>();
+       }
+      return result;
     }
 
 
@@ -304,105 +1015,206 @@ namespace Engine
       context.inUserInput = false;
       ++context.generation;
       context.names->clear();
-      if (c_major) // Going in column-major order
+      AutoBatch batch (currentSheet);
+
+      if ((threads < 2U) || (false == recalcInParallel(context)))
        {
-         if (left_right) // Going from left-to-right
+         dependencies.reset(currentSheet);
+
+            // Only visit the cells that are there: a sparse sheet may have a great many empty coordinates.
+         std::unique_ptr<CellCursor> cursor = currentSheet->getPresentCells(c_major, colsAscending(), rowsAscending());
+         size_t col, row;
+         while (true == cursor->next(col, row))
           {
-            if (top_down) // Going from top-to-bottom
-             {
-               for (size_t col = 0U; col < getMaxColumn(); ++col)
-                {
-                  for (size_t row = 0U; row < getMaxRowForColumn(col); ++row)
-                   {
-                     (void) computeCell(context, col, row, false);
-                   }
-                }
-             }
-            else // Going from bottom-to-top
-             {
-               for (size_t col = 0U; col < getMaxColumn(); ++col)
-                {
-                  for (size_t row = getMaxRowForColumn(col) - 1U; row != (static_cast<size_t>(0U) - 1U); --row)
-                   {
-                     (void) computeCell(context, col, row, false);
-                   }
-                }
-             }
+            (void) computeCell(context, col, row, false);
           }
-         else // Going from right-to-left
+       }
+      ++context.generation;
+    }
+
+   bool SpreadSheet::recalcInParallel(CallingContext& context)
+    {
+         // The debugger steps through one cell at a time.
+      if (nullptr != context.debugger)
+       {
+         return false;
+       }
+         // Names make the result depend on the order: if we know they're used, don't bother.
+      if ((true == dependencies.isValidFor(currentSheet)) && (true == dependencies.hasVolatile()))
+       {
+         return false;
+       }
+
+      Recalculation work (*this, context, threads);
+      dependencies.reset(currentSheet);
+
+      running = &work;
+      bool result = work.run();
+      running = nullptr;
+
+      if (false == result)
+       {
+            // Someone used a name. Throw it all away and do it in order.
+         ++context.generation;
+         context.names->clear();
+         return false;
+       }
+
+      work.finishInOrder(context);
+      return true;
+    }
+
+   void SpreadSheet::update(CallingContext& context)
+    {
+         // If we don't know what depends on what, we have to do everything.
+      if ((false == dependencies.isValidFor(currentSheet)) || (true == dependencies.hasVolatile()))
+       {
+         recalc(context);
+         return;
+       }
+
+      std::vector<size_t> dirty = dependencies.beginUpdate();
+      std::sort(dirty.begin(), dirty.end(), [this](size_t lhs, size_t rhs) { return evaluatedBefore(lhs, rhs); });
+
+         // Forget everything up front: a cell may be computed before we get to it, and cleared cells won't be computed.
+      for (size_t id : dirty)
+       {
+         dependencies.forgetReads(DependencyGraph::getColumn(id), DependencyGraph::getRow(id));
+       }
+
+      context.inUserInput = false;
+      ++context.generation;
+       {
+         AutoBatch batch (currentSheet);
+         for (size_t id : dirty)
           {
-            if (top_down) // Going from top-to-bottom
-             {
-               for (size_t col = getMaxColumn() - 1U; col != (static_cast<size_t>(0U) - 1U); --col)
-                {
-                  for (size_t row = 0U; row < getMaxRowForColumn(col); ++row)
-                   {
-                     (void) computeCell(context, col, row, false);
-                   }
-                }
-             }
-            else // Going from bottom-to-top
-             {
-               for (size_t col = getMaxColumn() - 1U; col != (static_cast<size_t>(0U) - 1U); --col)
-                {
-                  for (size_t row = getMaxRowForColumn(col) - 1U; row != (static_cast<size_t>(0U) - 1U); --row)
-                   {
-                     (void) computeCell(context, col, row, false);
-                   }
-                }
-             }
+            (void) computeCell(context, DependencyGraph::getColumn(id), DependencyGraph::getRow(id), false);
           }
        }
-      else // Going in row major order
+      dependencies.finishUpdate();
+      ++context.generation;
+
+         // Someone just started using names: the result depends on the order of everything.
+      if (true == dependencies.hasVolatile())
+       {
+         recalc(context);
+       }
+    }
+
+   void SpreadSheet::readCell(CallingContext& context, size_t col, size_t row)
+    {
+      CellFrame* top = context.topCell();
+      if ((false == context.inUserInput) && (nullptr != top) && (nullptr != top->cell))
        {
-         if (top_down) // Going from top-to-bottom
+         if (nullptr != running)
           {
-            if (left_right) // Going from left-to-right
-             {
-               for (size_t row = 0U; row < getMaxRow(); ++row)
-                {
-                  for (size_t col = 0U; col < getMaxColumn(); ++col)
-                   {
-                     (void) computeCell(context, col, row, false);
-                   }
-                }
-             }
-            else // Going from right-to-left
-             {
-               for (size_t row = getMaxRow() - 1U; row != (static_cast<size_t>(0U) - 1U); --row)
-                {
-                  for (size_t col = 0U; col < getMaxColumn(); ++col)
-                   {
-                     (void) computeCell(context, col, row, false);
-                   }
-                }
-             }
+            running->readCell(top->col, top->row, col, row, col, row, false);
           }
-         else // Going from bottom-to-top
+         else
           {
-            if (left_right) // Going from left-to-right
-             {
-               for (size_t row = 0U; row < getMaxRow(); ++row)
-                {
-                  for (size_t col = getMaxColumn() - 1U; col != (static_cast<size_t>(0U) - 1U); --col)
-                   {
-                     (void) computeCell(context, col, row, false);
-                   }
-                }
-             }
-            else // Going from right-to-left
-             {
-               for (size_t row = getMaxRow() - 1U; row != (static_cast<size_t>(0U) - 1U); --row)
-                {
-                  for (size_t col = getMaxColumn() - 1U; col != (static_cast<size_t>(0U) - 1U); --col)
-                   {
-                     (void) computeCell(context, col, row, false);
-                   }
-                }
-             }
+            dependencies.addCell(top->col, top->row, col, row);
           }
        }
-      ++context.generation;
+    }
+
+   void SpreadSheet::readRange(CallingContext& context, size_t col1, size_t row1, size_t col2, size_t row2)
+    {
+      CellFrame* top = context.topCell();
+      if ((false == context.inUserInput) && (nullptr != top) && (nullptr != top->cell))
+       {
+         if (nullptr != running)
+          {
+            running->readCell(top->col, top->row, col1, row1, col2, row2, true);
+          }
+         else
+          {
+            dependencies.addRange(top->col, top->row, col1, row1, col2, row2);
+          }
+       }
+    }
+
+   void SpreadSheet::readVolatile(CallingContext& context)
+    {
+      CellFrame* top = context.topCell();
+      if ((false == context.inUserInput) && (nullptr != top) && (nullptr != top->cell))
+       {
+         if (nullptr != running)
+          {
+            running->readVolatile();
+          }
+         dependencies.addVolatile(top->col, top->row);
+       }
+    }
+
+   bool SpreadSheet::isCurrent(CallingContext& context, Cell* cell, size_t col, size_t row)
+    {
+      if (context.generation == cell->previousGeneration)
+       {
+         return true;
+       }
+         // During an update, anything that didn't change is as good as computed.
+      return (false == dependencies.isStale(col, row)) && (nullptr != cell->previousValue.get());
+    }
+
+      // This must agree with the order of the cursor in recalc.
+   bool SpreadSheet::evaluatedBefore(size_t lhs, size_t rhs) const
+    {
+      size_t lcol = DependencyGraph::getColumn(lhs);
+      size_t lrow = DependencyGraph::getRow(lhs);
+      size_t rcol = DependencyGraph::getColumn(rhs);
+      size_t rrow = DependencyGraph::getRow(rhs);
+
+      if (c_major)
+       {
+         if (lcol != rcol)
+          {
+            return colsAscending() ? (lcol < rcol) : (lcol > rcol);
+          }
+         return rowsAscending() ? (lrow < rrow) : (lrow > rrow);
+       }
+
+      if (lrow != rrow)
+       {
+         return rowsAscending() ? (lrow < rrow) : (lrow > rrow);
+       }
+      return colsAscending() ? (lcol < rcol) : (lcol > rcol);
+    }
+
+      // In row-major order, left_right and top_down have historically been swapped.
+   bool SpreadSheet::colsAscending() const
+    {
+      return c_major ? left_right : top_down;
+    }
+
+   bool SpreadSheet::rowsAscending() const
+    {
+      return c_major ? top_down : left_right;
+    }
+
+   bool VectorCursor::next(size_t& col, size_t& row)
+    {
+      if (index >= cells.size())
+       {
+         return false;
+       }
+      col = cells[index].first;
+      row = cells[index].second;
+      ++index;
+      return true;
+    }
+
+   void VectorCursor::sort(bool c_major, bool colsAscending, bool rowsAscending)
+    {
+      std::sort(cells.begin(), cells.end(), [=](const std::pair<size_t, size_t>& lhs, const std::pair<size_t, size_t>& rhs)
+       {
+         bool cols = colsAscending ? (lhs.first < rhs.first) : (lhs.first > rhs.first);
+         bool rows = rowsAscending ? (lhs.second < rhs.second) : (lhs.second > rhs.second);
+         if (c_major)
+          {
+            return (lhs.first != rhs.first) ? cols : rows;
+          }
+         return (lhs.second != rhs.second) ? rows : cols;
+       });
     }
 
    AutoCell::AutoCell(SpreadSheet* sheet, Cell* cell) : sheet(sheet), cell(cell)
@@ -414,6 +1226,16 @@ namespace Engine
       sheet->returnCell(cell);
     }
 
+   AutoBatch::AutoBatch(SpreadSheetHolder* sheet) : sheet(sheet)
+    {
+      sheet->beginBatch();
+    }
+
+   AutoBatch::~AutoBatch()
+    {
+      sheet->endBatch();
+    }
+
  } // namespace Engine
 
  } // namespace Forwards
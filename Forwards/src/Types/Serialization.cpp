@@ -0,0 +1,192 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2023, Thomas DiModica
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "Forwards/Types/Serialization.h"
+#include "Forwards/Types/FloatValue.h"
+#include "Forwards/Types/StringValue.h"
+#include "Forwards/Types/NilValue.h"
+#include "Forwards/Types/CellRefValue.h"
+#include "Forwards/Types/CellRangeValue.h"
+
+#include "NumberSystem.h"
+
+#include <cstring>
+
+namespace Forwards
+ {
+
+namespace Types
+ {
+
+   template <class T>
+   static void put(std::string& out, T value)
+    {
+      out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+   template <class T>
+   static bool get(const std::string& in, size_t& offset, T& value)
+    {
+      if (in.size() - offset < sizeof(value))
+       {
+         return false;
+       }
+      std::memcpy(&value, in.data() + offset, sizeof(value));
+      offset += sizeof(value);
+      return true;
+    }
+
+   static void putString(std::string& out, const std::string& value)
+    {
+      put(out, static_cast<uint32_t>(value.size()));
+      out.append(value);
+    }
+
+   static bool getString(const std::string& in, size_t& offset, std::string& value)
+    {
+      uint32_t length;
+      if ((false == get(in, offset, length)) || (in.size() - offset < length))
+       {
+         return false;
+       }
+      value.assign(in, offset, length);
+      offset += length;
+      return true;
+    }
+
+   std::string serialize(const ValueType& value)
+    {
+      std::string result;
+      result += static_cast<char>(value.getType());
+      switch (value.getType())
+       {
+      case FLOAT:
+         put(result, static_cast<uint8_t>(NumberSystem::getCurrentNumberSystem().getSystem()));
+         static_cast<const FloatValue&>(value).value->serialize(result);
+         break;
+      case STRING:
+         putString(result, static_cast<const StringValue&>(value).value);
+         break;
+      case NIL:
+         break;
+      case CELL_REF:
+       {
+         const CellRefValue& ref = static_cast<const CellRefValue&>(value);
+         put(result, static_cast<uint8_t>((ref.colAbsolute ? 1 : 0) | (ref.rowAbsolute ? 2 : 0)));
+         put(result, ref.colRef);
+         put(result, ref.rowRef);
+         putString(result, ref.sheet);
+       }
+         break;
+      case CELL_RANGE:
+       {
+         const CellRangeValue& range = static_cast<const CellRangeValue&>(value);
+         put(result, range.col1);
+         put(result, range.row1);
+         put(result, range.col2);
+         put(result, range.row2);
+         putString(result, range.sheet);
+       }
+         break;
+       }
+      return result;
+    }
+
+   std::shared_ptr<ValueType> deserialize(const std::string& src)
+    {
+      size_t offset = 1U;
+      if (true == src.empty())
+       {
+         return nullptr;
+       }
+      switch (static_cast<ValueTypes>(src[0]))
+       {
+      case FLOAT:
+       {
+         uint8_t system;
+         if ((false == get(src, offset, system)) ||
+            (static_cast<uint8_t>(NumberSystem::getCurrentNumberSystem().getSystem()) != system))
+          {
+            return nullptr;
+          }
+         std::shared_ptr<NumberHolder> number =
+            NumberSystem::getCurrentNumberSystem().deserialize(src.data() + offset, src.size() - offset);
+         if (nullptr == number.get())
+          {
+            return nullptr;
+          }
+         return std::make_shared<FloatValue>(number);
+       }
+      case STRING:
+       {
+         std::string value;
+         if ((false == getString(src, offset, value)) || (src.size() != offset))
+          {
+            return nullptr;
+          }
+         return std::make_shared<StringValue>(value);
+       }
+      case NIL:
+         if (src.size() != offset)
+          {
+            return nullptr;
+          }
+         return std::make_shared<NilValue>();
+      case CELL_REF:
+       {
+         uint8_t flags;
+         int64_t colRef, rowRef;
+         std::string sheet;
+         if ((false == get(src, offset, flags)) || (false == get(src, offset, colRef)) ||
+            (false == get(src, offset, rowRef)) || (false == getString(src, offset, sheet)) || (src.size() != offset))
+          {
+            return nullptr;
+          }
+         return std::make_shared<CellRefValue>(0 != (flags & 1), colRef, 0 != (flags & 2), rowRef, sheet);
+       }
+      case CELL_RANGE:
+       {
+         size_t col1, row1, col2, row2;
+         std::string sheet;
+         if ((false == get(src, offset, col1)) || (false == get(src, offset, row1)) || (false == get(src, offset, col2)) ||
+            (false == get(src, offset, row2)) || (false == getString(src, offset, sheet)) || (src.size() != offset))
+          {
+            return nullptr;
+          }
+         return std::make_shared<CellRangeValue>(col1, row1, col2, row2, sheet);
+       }
+       }
+      return nullptr;
+    }
+
+ } // namespace Types
+
+ } // namespace Forwards
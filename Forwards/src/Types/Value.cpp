@@ -0,0 +1,185 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2023, Thomas DiModica
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "Forwards/Types/Value.h"
+#include "Forwards/Types/FloatValue.h"
+#include "Forwards/Types/NilValue.h"
+
+namespace Forwards
+ {
+
+namespace Types
+ {
+
+   Value::Value(const std::shared_ptr<ValueType>& src) : rep(BOXED), bits(0U), boxed(src)
+    {
+      switch (src->getType())
+       {
+      case FLOAT:
+         rep = HOLDER;
+         holder = static_cast<const FloatValue&>(*src).value;
+         break;
+      case NIL:
+         rep = EMPTY;
+         break;
+      default:
+         break;
+       }
+    }
+
+   Value Value::fromHolder(const std::shared_ptr<NumberHolder>& holder)
+    {
+      Value result;
+      result.rep = HOLDER;
+      result.holder = holder;
+      return result;
+    }
+
+   Value Value::fromBool(bool truth)
+    {
+      const NumberSystem& system = NumberSystem::getCurrentNumberSystem();
+      return fromHolder(truth ? system.FLOAT_ONE : system.FLOAT_ZERO);
+    }
+
+   ValueTypes Value::getType() const
+    {
+      switch (rep)
+       {
+      case EMPTY:
+         return NIL;
+      case INLINE:
+      case HOLDER:
+         return FLOAT;
+      default:
+         return boxed->getType();
+       }
+    }
+
+   std::shared_ptr<ValueType> Value::box() const
+    {
+      if (nullptr != boxed.get())
+       {
+         return boxed;
+       }
+      switch (rep)
+       {
+      case EMPTY:
+         return std::make_shared<NilValue>();
+      case INLINE:
+         return std::make_shared<FloatValue>(NumberSystem::getCurrentNumberSystem().fromInline(bits));
+      default:
+         return std::make_shared<FloatValue>(holder);
+       }
+    }
+
+   bool Value::numeric(NumberSystem_Inline_Op op, const Value& lhs, const Value& rhs, Value& result)
+    {
+      switch (NumberSystem::getCurrentSystem())
+       {
+      case DOUBLE_NUMBER_SYSTEM:
+         return numericWith<double_InlineMath>(op, lhs, rhs, result);
+      case LIBDECMATH_NUMBER_SYSTEM:
+         return numericWith<libdecmath_InlineMath>(op, lhs, rhs, result);
+      default:
+         return numericWith<NoInlineMath>(op, lhs, rhs, result);
+       }
+    }
+
+   bool Value::negate(const Value& arg, Value& result)
+    {
+      switch (NumberSystem::getCurrentSystem())
+       {
+      case DOUBLE_NUMBER_SYSTEM:
+         return negateWith<double_InlineMath>(arg, result);
+      case LIBDECMATH_NUMBER_SYSTEM:
+         return negateWith<libdecmath_InlineMath>(arg, result);
+      default:
+         return negateWith<NoInlineMath>(arg, result);
+       }
+    }
+
+   bool Value::numericHolders(NumberSystem_Inline_Op op, const Value& lhs, const Value& rhs, Value& result)
+    {
+      if ((HOLDER != lhs.rep) || (HOLDER != rhs.rep))
+       {
+         return false;
+       }
+      const NumberHolder& LHS = *lhs.holder;
+      const NumberHolder& RHS = *rhs.holder;
+      switch (op)
+       {
+      case INLINE_ADD:
+         result = fromHolder(LHS + RHS);
+         break;
+      case INLINE_SUBTRACT:
+         result = fromHolder(LHS - RHS);
+         break;
+      case INLINE_MULTIPLY:
+         result = fromHolder(LHS * RHS);
+         break;
+      case INLINE_DIVIDE:
+         result = fromHolder(LHS / RHS);
+         break;
+      case INLINE_EQUAL:
+         result = fromBool(LHS == RHS);
+         break;
+      case INLINE_NOT_EQUAL:
+         result = fromBool(LHS != RHS);
+         break;
+      case INLINE_GREATER:
+         result = fromBool(LHS > RHS);
+         break;
+      case INLINE_LESS:
+         result = fromBool(LHS < RHS);
+         break;
+      case INLINE_GREATER_EQUAL:
+         result = fromBool(LHS >= RHS);
+         break;
+      case INLINE_LESS_EQUAL:
+         result = fromBool(LHS <= RHS);
+         break;
+       }
+      return true;
+    }
+
+   bool Value::negateHolder(const Value& arg, Value& result)
+    {
+      if (HOLDER == arg.rep)
+       {
+         result = fromHolder(-*arg.holder);
+         return true;
+       }
+      return false;
+    }
+
+ } // namespace Types
+
+ } // namespace Forwards
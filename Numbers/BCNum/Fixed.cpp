@@ -33,6 +33,7 @@ SUCH DAMAGE.
 */
 
 #include <cstdlib>
+#include <cstring>
 #include <string>
 #include "Fixed.hpp"
 
@@ -40,9 +41,9 @@ namespace BigInt
  {
 
 
-   unsigned long Fixed::defPrec = 0;
+   thread_local unsigned long Fixed::defPrec = 0;
 
-   Fixed_Round_Mode Fixed::mode = ROUND_TIES_EVEN;
+   thread_local Fixed_Round_Mode Fixed::mode = ROUND_TIES_EVEN;
 
 
    Fixed::Fixed (const std::string & from)
@@ -412,6 +413,24 @@ namespace BigInt
     }
 
 
+   void Fixed::toBytes (std::string& result) const
+    {
+      result.append(reinterpret_cast<const char*>(&Digits), sizeof(Digits));
+      result += static_cast<char>((infinity ? 1 : 0) | (nan ? 2 : 0));
+      Data.toBytes(result);
+    }
+
+   bool Fixed::fromBytes (const char* src, size_t length)
+    {
+      if (length < sizeof(Digits) + 2U) return false;
+
+      std::memcpy(&Digits, src, sizeof(Digits));
+      infinity = (0 != (src[sizeof(Digits)] & 1));
+      nan = (0 != (src[sizeof(Digits)] & 2));
+      return Data.fromBytes(src + sizeof(Digits) + 1U, length - sizeof(Digits) - 1U);
+    }
+
+
    void Fixed::fromString (const char* src)
     {
       const char* iter = src, *base;
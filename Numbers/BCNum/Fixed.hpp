@@ -52,8 +52,9 @@ namespace BigInt
     {
 
       private:
-         static unsigned long defPrec;
-         static Fixed_Round_Mode mode;
+            // These are per thread.
+         static thread_local unsigned long defPrec;
+         static thread_local Fixed_Round_Mode mode;
 
       public:
          static unsigned long getDefaultPrecision (void) { return defPrec; }
@@ -106,6 +107,12 @@ namespace BigInt
             { fromString(src.c_str()); }
          void fromString (const char *);
 
+          /*
+            A native form, for caching: not portable.
+          */
+         void toBytes (std::string&) const;
+         bool fromBytes (const char *, size_t);
+
          friend Fixed operator + (const Fixed &, const Fixed &);
          friend Fixed operator - (const Fixed &, const Fixed &);
          friend Fixed operator * (const Fixed &, const Fixed &);
@@ -282,6 +282,41 @@ namespace BigInt
 
 
 
+   void Integer::toBytes (std::string& result) const
+    {
+      result += Sign ? '\1' : '\0';
+      if (isZero()) return;
+
+      size_t count = 0U;
+      size_t start = result.length();
+      result.resize(start + mpz_size(Data->Data) * sizeof(mp_limb_t));
+      mpz_export(&result[start], &count, -1, sizeof(mp_limb_t), 0, 0, Data->Data);
+      result.resize(start + count * sizeof(mp_limb_t));
+    }
+
+   bool Integer::fromBytes (const char* src, size_t length)
+    {
+      Sign = false;
+      Data.reset();
+      if (0U == length) return false;
+      if (0U != ((length - 1U) % sizeof(mp_limb_t))) return false;
+      if (1U == length) return true;
+
+      Data = std::make_shared<DataHolder>();
+      mpz_import(Data->Data, (length - 1U) / sizeof(mp_limb_t), -1, sizeof(mp_limb_t), 0, 0, src + 1);
+      if (0 == mpz_sgn(Data->Data))
+       {
+         Data.reset();
+       }
+      else
+       {
+         Sign = ('\0' != src[0]);
+       }
+      return true;
+    }
+
+
+
    std::string Integer::toString () const
     {
       std::string result;
@@ -65,6 +65,13 @@ namespace BigInt
          void fromString (const std::string&);
          void fromString (const char *);
 
+          /*
+            The sign, then the limbs of the magnitude, least significant first.
+            fromBytes returns false, leaving zero, if the limbs don't fill the bytes given.
+          */
+         void toBytes (std::string&) const;
+         bool fromBytes (const char *, size_t);
+
          Integer& negate (void);
          Integer& abs (void);
 
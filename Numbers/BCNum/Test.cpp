@@ -1047,6 +1047,29 @@ TEST(FixedTests, testZeros)
    EXPECT_EQ(0, test.roundToInteger().toInt());
  }
 
+TEST(FixedTests, testBytes)
+ {
+   BigInt::Fixed test ("-123456789012345678901234567890.125");
+   std::string bytes;
+   test.toBytes(bytes);
+
+   BigInt::Fixed back;
+   EXPECT_TRUE(back.fromBytes(bytes.c_str(), bytes.length()));
+   EXPECT_EQ(test.toString(), back.toString());
+
+   BigInt::Fixed zero;
+   bytes.clear();
+   zero.toBytes(bytes);
+   EXPECT_TRUE(back.fromBytes(bytes.c_str(), bytes.length()));
+   EXPECT_EQ("0", back.toString());
+
+      // A partial limb isn't a number.
+   bytes.clear();
+   test.toBytes(bytes);
+   EXPECT_FALSE(back.fromBytes(bytes.c_str(), bytes.length() - 1U));
+   EXPECT_FALSE(back.fromBytes(bytes.c_str(), bytes.length() + 1U));
+ }
+
 TEST(FixedTests, testNewRoundMode)
  {
    BigInt::Fixed a ("1");
@@ -80,6 +80,17 @@ public:
     }
 
 
+   virtual void serialize(std::string& out) const override { value.toBytes(out); }
+   static std::shared_ptr<NumberHolder> deserialize(const char* src, size_t length)
+    {
+      BigInt::Fixed result;
+      if (false == result.fromBytes(src, length))
+       {
+         return std::shared_ptr<NumberHolder>();
+       }
+      return std::make_shared<BCNum_NumberHolder>(result);
+    }
+
    virtual bool isSigned() const override { return value.isSigned(); }
    virtual bool isZero() const override { return value.isZero(); }
    virtual bool isNaN() const override { return value.isNaN(); }
@@ -123,37 +134,37 @@ public:
 
    virtual bool less (const NumberHolder& rhs) const override
     {
-      const BCNum_NumberHolder& RHS = dynamic_cast<const BCNum_NumberHolder&>(rhs);
+      const BCNum_NumberHolder& RHS = NumberHolder_cast<BCNum_NumberHolder>(rhs);
       return value < RHS.value;
     }
 
    virtual bool less_equal (const NumberHolder& rhs) const override
     {
-      const BCNum_NumberHolder& RHS = dynamic_cast<const BCNum_NumberHolder&>(rhs);
+      const BCNum_NumberHolder& RHS = NumberHolder_cast<BCNum_NumberHolder>(rhs);
       return value <= RHS.value;
     }
 
    virtual bool greater (const NumberHolder& rhs) const override
     {
-      const BCNum_NumberHolder& RHS = dynamic_cast<const BCNum_NumberHolder&>(rhs);
+      const BCNum_NumberHolder& RHS = NumberHolder_cast<BCNum_NumberHolder>(rhs);
       return value > RHS.value;
     }
 
    virtual bool greater_equal (const NumberHolder& rhs) const override
     {
-      const BCNum_NumberHolder& RHS = dynamic_cast<const BCNum_NumberHolder&>(rhs);
+      const BCNum_NumberHolder& RHS = NumberHolder_cast<BCNum_NumberHolder>(rhs);
       return value >= RHS.value;
     }
 
    virtual bool equal (const NumberHolder& rhs) const override
     {
-      const BCNum_NumberHolder& RHS = dynamic_cast<const BCNum_NumberHolder&>(rhs);
+      const BCNum_NumberHolder& RHS = NumberHolder_cast<BCNum_NumberHolder>(rhs);
       return value == RHS.value;
     }
 
    virtual bool not_equal_to (const NumberHolder& rhs) const override
     {
-      const BCNum_NumberHolder& RHS = dynamic_cast<const BCNum_NumberHolder&>(rhs);
+      const BCNum_NumberHolder& RHS = NumberHolder_cast<BCNum_NumberHolder>(rhs);
       return value != RHS.value;
     }
 
@@ -161,28 +172,59 @@ public:
 
    virtual std::shared_ptr<NumberHolder> add (const NumberHolder& rhs) const override
     {
-      const BCNum_NumberHolder& RHS = dynamic_cast<const BCNum_NumberHolder&>(rhs);
+      const BCNum_NumberHolder& RHS = NumberHolder_cast<BCNum_NumberHolder>(rhs);
       return std::make_shared<BCNum_NumberHolder>(value + RHS.value);
     }
 
    virtual std::shared_ptr<NumberHolder> subtract (const NumberHolder& rhs) const override
     {
-      const BCNum_NumberHolder& RHS = dynamic_cast<const BCNum_NumberHolder&>(rhs);
+      const BCNum_NumberHolder& RHS = NumberHolder_cast<BCNum_NumberHolder>(rhs);
       return std::make_shared<BCNum_NumberHolder>(value - RHS.value);
     }
 
    virtual std::shared_ptr<NumberHolder> multiply (const NumberHolder& rhs) const override
     {
-      const BCNum_NumberHolder& RHS = dynamic_cast<const BCNum_NumberHolder&>(rhs);
+      const BCNum_NumberHolder& RHS = NumberHolder_cast<BCNum_NumberHolder>(rhs);
       return std::make_shared<BCNum_NumberHolder>(value * RHS.value);
     }
 
    virtual std::shared_ptr<NumberHolder> divide (const NumberHolder& rhs) const override
     {
-      const BCNum_NumberHolder& RHS = dynamic_cast<const BCNum_NumberHolder&>(rhs);
+      const BCNum_NumberHolder& RHS = NumberHolder_cast<BCNum_NumberHolder>(rhs);
       return std::make_shared<BCNum_NumberHolder>(value / RHS.value);
     }
 
+   virtual void addAssign (const NumberHolder& rhs) override
+    {
+      const BCNum_NumberHolder& RHS = NumberHolder_cast<BCNum_NumberHolder>(rhs);
+      value = value + RHS.value;
+    }
+
+   virtual void subtractAssign (const NumberHolder& rhs) override
+    {
+      const BCNum_NumberHolder& RHS = NumberHolder_cast<BCNum_NumberHolder>(rhs);
+      value = value - RHS.value;
+    }
+
+   virtual void multiplyAssign (const NumberHolder& rhs) override
+    {
+      const BCNum_NumberHolder& RHS = NumberHolder_cast<BCNum_NumberHolder>(rhs);
+      value = value * RHS.value;
+    }
+
+   virtual void divideAssign (const NumberHolder& rhs) override
+    {
+      const BCNum_NumberHolder& RHS = NumberHolder_cast<BCNum_NumberHolder>(rhs);
+      value = value / RHS.value;
+    }
+
+   virtual void fusedMultiplyAdd (const NumberHolder& lhs, const NumberHolder& rhs) override
+    {
+      const BCNum_NumberHolder& LHS = NumberHolder_cast<BCNum_NumberHolder>(lhs);
+      const BCNum_NumberHolder& RHS = NumberHolder_cast<BCNum_NumberHolder>(rhs);
+      value = value + LHS.value * RHS.value;
+    }
+
  };
 
 
@@ -213,6 +255,16 @@ std::shared_ptr<NumberHolder> BCNum_NumberSystem::fromInt(size_t src) const
    return std::make_shared<BCNum_NumberHolder>(BigInt::Fixed(static_cast<long long>(src), 0U));
  }
 
+NumberSystem_System BCNum_NumberSystem::getSystem() const
+ {
+   return BCNUM_NUMBER_SYSTEM;
+ }
+
+std::shared_ptr<NumberHolder> BCNum_NumberSystem::deserialize(const char* src, size_t length) const
+ {
+   return BCNum_NumberHolder::deserialize(src, length);
+ }
+
 
 void BCNum_NumberSystem::setRoundMode(NumberSystem_Round_Mode mode)
  {
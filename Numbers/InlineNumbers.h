@@ -0,0 +1,183 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2023, Thomas DiModica
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef INLINENUMBERS_H
+#define INLINENUMBERS_H
+
+#include "NumberSystem.h"
+#include "libdecmath/dm_double.h"
+
+#include <cstdint>
+#include <cstring>
+
+   /*
+      The math of the number systems that can work on the bits of a number (see NumberSystem::toInline),
+      written where the compiler can see it. Code that is specialized on the number system takes one of
+      these as a template argument, and gets the arithmetic inlined instead of a virtual call per operation.
+      NoInlineMath is for the other systems: INLINE is false, and its functions are never called.
+   */
+class NoInlineMath final
+ {
+public:
+   static const bool INLINE = false;
+
+   static uint64_t arithmetic(NumberSystem_Inline_Op, uint64_t, uint64_t) { return 0U; }
+   static bool compare(NumberSystem_Inline_Op, uint64_t, uint64_t) { return false; }
+   static uint64_t negate(uint64_t bits) { return bits; }
+   static uint64_t truth(bool) { return 0U; }
+ };
+
+class double_InlineMath final
+ {
+public:
+   static const bool INLINE = true;
+
+   static double get(uint64_t bits)
+    {
+      double result;
+      std::memcpy(&result, &bits, sizeof(result));
+      return result;
+    }
+
+   static uint64_t put(double value)
+    {
+      uint64_t result;
+      std::memcpy(&result, &value, sizeof(result));
+      return result;
+    }
+
+   static uint64_t arithmetic(NumberSystem_Inline_Op op, uint64_t lhs, uint64_t rhs)
+    {
+      switch (op)
+       {
+      case INLINE_ADD:
+         return put(get(lhs) + get(rhs));
+      case INLINE_SUBTRACT:
+         return put(get(lhs) - get(rhs));
+      case INLINE_MULTIPLY:
+         return put(get(lhs) * get(rhs));
+      case INLINE_DIVIDE:
+         return put(get(lhs) / get(rhs));
+      default:
+         return put(0.0);
+       }
+    }
+
+   static bool compare(NumberSystem_Inline_Op op, uint64_t lhs, uint64_t rhs)
+    {
+      switch (op)
+       {
+      case INLINE_EQUAL:
+         return get(lhs) == get(rhs);
+      case INLINE_NOT_EQUAL:
+         return get(lhs) != get(rhs);
+      case INLINE_GREATER:
+         return get(lhs) > get(rhs);
+      case INLINE_LESS:
+         return get(lhs) < get(rhs);
+      case INLINE_GREATER_EQUAL:
+         return get(lhs) >= get(rhs);
+      case INLINE_LESS_EQUAL:
+         return get(lhs) <= get(rhs);
+      default:
+         return false;
+       }
+    }
+
+   static uint64_t negate(uint64_t bits)
+    {
+      return put(-get(bits));
+    }
+
+      // What a comparison gives: one or zero.
+   static uint64_t truth(bool value)
+    {
+      return put(value ? 1.0 : 0.0);
+    }
+ };
+
+class libdecmath_InlineMath final
+ {
+public:
+   static const bool INLINE = true;
+
+   static uint64_t arithmetic(NumberSystem_Inline_Op op, uint64_t lhs, uint64_t rhs)
+    {
+      switch (op)
+       {
+      case INLINE_ADD:
+         return dm_double_add(lhs, rhs);
+      case INLINE_SUBTRACT:
+         return dm_double_sub(lhs, rhs);
+      case INLINE_MULTIPLY:
+         return dm_double_mul(lhs, rhs);
+      case INLINE_DIVIDE:
+         return dm_double_div(lhs, rhs);
+      default:
+         return 0U;
+       }
+    }
+
+   static bool compare(NumberSystem_Inline_Op op, uint64_t lhs, uint64_t rhs)
+    {
+      switch (op)
+       {
+      case INLINE_EQUAL:
+         return 1 == dm_double_isequal(lhs, rhs);
+      case INLINE_NOT_EQUAL:
+         return 1 == dm_double_isunequal(lhs, rhs);
+      case INLINE_GREATER:
+         return 1 == dm_double_isgreater(lhs, rhs);
+      case INLINE_LESS:
+         return 1 == dm_double_isless(lhs, rhs);
+      case INLINE_GREATER_EQUAL:
+         return 1 == dm_double_isgreaterequal(lhs, rhs);
+      case INLINE_LESS_EQUAL:
+         return 1 == dm_double_islessequal(lhs, rhs);
+      default:
+         return false;
+       }
+    }
+
+   static uint64_t negate(uint64_t bits)
+    {
+      return dm_double_neg(bits);
+    }
+
+   static uint64_t truth(bool value)
+    {
+      static const dm_double ONE = dm_double_fromdouble(1.0);
+      static const dm_double ZERO = dm_double_fromdouble(0.0);
+      return value ? ONE : ZERO;
+    }
+ };
+
+#endif /* INLINENUMBERS_H */
@@ -0,0 +1,118 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2023, Thomas DiModica
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+   Compares the two ways to do arithmetic on NumberHolders: the operators, which make a new
+   holder for every result, and the in-place operations, which don't.
+
+   For each number system, it sums a number into an accumulator, and multiplies two numbers
+   and adds them in, both ways, and prints how long each took and the two results.
+   The optional argument is how many times to do each, the default being a million.
+*/
+#include "NumberSystem.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+
+static double milliseconds(const std::function<void(void)>& run)
+ {
+   std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+   run();
+   std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+   return std::chrono::duration<double, std::milli>(end - start).count();
+ }
+
+int main (int argc, char ** argv)
+ {
+   size_t count = 1000000U;
+   if (argc > 1)
+    {
+      count = static_cast<size_t>(std::strtoul(argv[1], nullptr, 10));
+    }
+
+   static const char* const NAMES [] = { "BCNum", "libdecmath", "SlowFloat", "double", "libmpdec", "MPFR" };
+   static const NumberSystem_System SYSTEMS [] = { BCNUM_NUMBER_SYSTEM, LIBDECMATH_NUMBER_SYSTEM, SLOWFLOAT_NUMBER_SYSTEM,
+      DOUBLE_NUMBER_SYSTEM, LIBMPDEC_NUMBER_SYSTEM, MPFR_NUMBER_SYSTEM };
+
+   std::printf("%-12s %12s %12s %12s %12s\n", "", "add", "addAssign", "mul, add", "FMA");
+   for (size_t i = 0U; i < sizeof(SYSTEMS) / sizeof(SYSTEMS[0]); ++i)
+    {
+      NumberSystem::setCurrentNumberSystem(SYSTEMS[i]);
+      const NumberSystem& system = NumberSystem::getCurrentNumberSystem();
+      std::shared_ptr<NumberHolder> lhs = system.fromString("1.25");
+      std::shared_ptr<NumberHolder> rhs = system.fromString("0.5");
+
+      std::shared_ptr<NumberHolder> sum = system.fromString("0");
+      double add = milliseconds([&]()
+       {
+         for (size_t j = 0U; j < count; ++j)
+          {
+            sum = *sum + *lhs;
+          }
+       });
+
+      std::shared_ptr<NumberHolder> sumAssign = system.fromString("0");
+      double addAssign = milliseconds([&]()
+       {
+         for (size_t j = 0U; j < count; ++j)
+          {
+            sumAssign->addAssign(*lhs);
+          }
+       });
+
+      std::shared_ptr<NumberHolder> product = system.fromString("0");
+      double mulAdd = milliseconds([&]()
+       {
+         for (size_t j = 0U; j < count; ++j)
+          {
+            product = *product + *(*lhs * *rhs);
+          }
+       });
+
+      std::shared_ptr<NumberHolder> fused = system.fromString("0");
+      double fma = milliseconds([&]()
+       {
+         for (size_t j = 0U; j < count; ++j)
+          {
+            fused->fusedMultiplyAdd(*lhs, *rhs);
+          }
+       });
+
+      std::printf("%-12s %9.1f ms %9.1f ms %9.1f ms %9.1f ms\n", NAMES[i], add, addAssign, mulAdd, fma);
+      std::printf("%-12s %12s %12s %12s %12s\n", "", sum->toString().c_str(), sumAssign->toString().c_str(),
+         product->toString().c_str(), fused->toString().c_str());
+    }
+
+   return 0;
+ }
@@ -34,6 +34,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <string>
 #include <memory>
+#include <typeinfo>
 
 class NumberHolder
  {
@@ -45,6 +46,7 @@ public:
    virtual double asDouble() const = 0; // This is for indexes, so it can just be an integer.
    virtual std::string toString() const = 0;
    virtual std::string toExprString() const = 0; // In case they are different.
+   virtual void serialize(std::string&) const = 0; // Appends the native form, which only getCurrentNumberSystem().deserialize can read.
 
    virtual bool isSigned() const = 0;
    virtual bool isZero() const = 0;
@@ -74,8 +76,29 @@ public:
    virtual std::shared_ptr<NumberHolder> subtract (const NumberHolder&) const = 0;
    virtual std::shared_ptr<NumberHolder> multiply (const NumberHolder&) const = 0;
    virtual std::shared_ptr<NumberHolder> divide (const NumberHolder&) const = 0;
+
+      // The same, in place, with the same result: for accumulators, which would otherwise make a holder per step.
+      // Holders are shared, so only do this to one nobody else can see, like a new one or a duplicate().
+   virtual void addAssign (const NumberHolder&) = 0;
+   virtual void subtractAssign (const NumberHolder&) = 0;
+   virtual void multiplyAssign (const NumberHolder&) = 0;
+   virtual void divideAssign (const NumberHolder&) = 0;
+      // this += lhs * rhs, rounded once where the number system can do that.
+   virtual void fusedMultiplyAdd (const NumberHolder& lhs, const NumberHolder& rhs) = 0;
  };
 
+   // Every number system's holder is final, so a holder either is exactly that type or isn't one at all.
+   // Comparing the typeid is much cheaper than a dynamic_cast. Anything else still gets the bad_cast.
+template <class T>
+const T& NumberHolder_cast (const NumberHolder& src)
+ {
+   if (typeid(T) == typeid(src))
+    {
+      return static_cast<const T&>(src);
+    }
+   return dynamic_cast<const T&>(src);
+ }
+
 bool operator <  (const NumberHolder&, const NumberHolder&);
 bool operator <= (const NumberHolder&, const NumberHolder&);
 bool operator >  (const NumberHolder&, const NumberHolder&);
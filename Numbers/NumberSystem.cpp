@@ -45,7 +45,8 @@ libmpdec_NumberSystem system4;
 mpfr_NumberSystem system5;
 
 NumberSystem* NumberSystem::currentNumberSystem = nullptr;
-NumberSystem_Round_Mode NumberSystem::currentRoundMode = ROUND_TIES_EVEN;
+NumberSystem_System NumberSystem::currentSystem = BCNUM_NUMBER_SYSTEM;
+thread_local NumberSystem_Round_Mode NumberSystem::currentRoundMode = ROUND_TIES_EVEN;
 
 NumberSystem& NumberSystem::getCurrentNumberSystem()
  {
@@ -54,6 +55,7 @@ NumberSystem& NumberSystem::getCurrentNumberSystem()
 
 void NumberSystem::setCurrentNumberSystem(NumberSystem_System system)
  {
+   currentSystem = system;
    switch (system)
     {
    case BCNUM_NUMBER_SYSTEM:
@@ -97,3 +99,13 @@ NumberSystem_Round_Mode NumberSystem::getRoundMode()
  {
    return currentRoundMode;
  }
+
+bool NumberSystem::toInline(const NumberHolder&, uint64_t&) const
+ {
+   return false;
+ }
+
+std::shared_ptr<NumberHolder> NumberSystem::fromInline(uint64_t) const
+ {
+   return std::shared_ptr<NumberHolder>();
+ }
@@ -34,6 +34,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "NumberHolder.h"
 
+#include <cstdint>
+
 enum NumberSystem_Round_Mode
  {
    ROUND_TIES_EVEN,
@@ -57,15 +59,32 @@ enum NumberSystem_System
    MPFR_NUMBER_SYSTEM
  };
 
+enum NumberSystem_Inline_Op
+ {
+   INLINE_ADD,
+   INLINE_SUBTRACT,
+   INLINE_MULTIPLY,
+   INLINE_DIVIDE,
+   INLINE_EQUAL,
+   INLINE_NOT_EQUAL,
+   INLINE_GREATER,
+   INLINE_LESS,
+   INLINE_GREATER_EQUAL,
+   INLINE_LESS_EQUAL
+ };
+
 class NumberSystem
  {
 private:
    static NumberSystem* currentNumberSystem;
+   static NumberSystem_System currentSystem;
 protected:
-   static NumberSystem_Round_Mode currentRoundMode;
+   static thread_local NumberSystem_Round_Mode currentRoundMode; // Rounding mode and precision are per thread.
 public:
    static NumberSystem& getCurrentNumberSystem();
    static void setCurrentNumberSystem(NumberSystem_System);
+      // The same as getCurrentNumberSystem().getSystem(), for code that picks a specialization: without the virtual call.
+   static NumberSystem_System getCurrentSystem() { return currentSystem; }
 
    NumberSystem(const std::shared_ptr<NumberHolder>&, const std::shared_ptr<NumberHolder>&,
       const std::shared_ptr<NumberHolder>&, const std::shared_ptr<NumberHolder>&);
@@ -81,11 +100,19 @@ public:
 
    virtual std::shared_ptr<NumberHolder> fromInt(size_t) const = 0;
 
+   virtual NumberSystem_System getSystem() const = 0;
+   virtual std::shared_ptr<NumberHolder> deserialize(const char*, size_t) const = 0; // nullptr if it isn't one of ours.
+
    static NumberSystem_Round_Mode getRoundMode();
    virtual void setRoundMode(NumberSystem_Round_Mode) = 0;
 
    virtual size_t getDefaultPrecision() const = 0;
    virtual void setDefaultPrecision(size_t) = 0;
+
+      // Systems whose numbers fit in 64 bits can do math on the bits, without a NumberHolder: see InlineNumbers.h.
+      // The bits only mean something to the system that made them. The rest return false from toInline.
+   virtual bool toInline(const NumberHolder&, uint64_t&) const;
+   virtual std::shared_ptr<NumberHolder> fromInline(uint64_t) const;
  };
 
 #endif /* NUMBERSYSTEM_H */
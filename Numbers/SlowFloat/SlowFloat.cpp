@@ -95,7 +95,7 @@ bool getSign (const SlowFloat& arg)
    // Table of powers of ten up to CUTOFF. (Yes, there is an extra entry, for the -1 case that needs to return 1.)
 const uint64_t makeShift [] = { 1U, 1U, 10U, 100U, 1000U, 10000U, 100000U, 1000000U, 10000000U, 100000000U, 1000000000U };
 
-SlowFloat_Round_Mode mode = ROUND_TIES_EVEN;
+thread_local SlowFloat_Round_Mode mode = ROUND_TIES_EVEN;
 
    // This code is suspiciously familiar....
 // sign - sign of result (true is negative)
@@ -87,7 +87,7 @@ enum SlowFloat_Round_Mode
    ROUND_AWAY
  };
 
-extern SlowFloat_Round_Mode mode;
+extern thread_local SlowFloat_Round_Mode mode; // Each thread rounds its own way.
 
 class SlowFloat final
  {
@@ -35,6 +35,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "SlowFloat/SlowFloat.h"
 
 #include <cmath>
+#include <cstring>
 
 class SlowFloat_NumberHolder final : public NumberHolder
  {
@@ -83,6 +84,24 @@ public:
     }
 
 
+   virtual void serialize(std::string& out) const override
+    {
+      out.append(reinterpret_cast<const char*>(&value.significand), sizeof(value.significand));
+      out.append(reinterpret_cast<const char*>(&value.exponent), sizeof(value.exponent));
+    }
+   static std::shared_ptr<NumberHolder> deserialize(const char* src, size_t length)
+    {
+      uint32_t significand;
+      int16_t exponent;
+      if ((sizeof(significand) + sizeof(exponent)) != length)
+       {
+         return std::shared_ptr<NumberHolder>();
+       }
+      std::memcpy(&significand, src, sizeof(significand));
+      std::memcpy(&exponent, src + sizeof(significand), sizeof(exponent));
+      return std::make_shared<SlowFloat_NumberHolder>(SlowFloat::SlowFloat(significand, exponent));
+    }
+
    virtual bool isSigned() const override { return 0 != ((1U << 31) & value.significand); }
    virtual bool isZero() const override { return (-32768 != value.exponent) && ((0U == value.significand) || (~0U == value.significand)); }
    virtual bool isNaN() const override { return (-32768 == value.exponent) && ((0U != value.significand) && (~0U != value.significand)); }
@@ -125,37 +144,37 @@ public:
 
    virtual bool less (const NumberHolder& rhs) const override
     {
-      const SlowFloat_NumberHolder& RHS = dynamic_cast<const SlowFloat_NumberHolder&>(rhs);
+      const SlowFloat_NumberHolder& RHS = NumberHolder_cast<SlowFloat_NumberHolder>(rhs);
       return value < RHS.value;
     }
 
    virtual bool less_equal (const NumberHolder& rhs) const override
     {
-      const SlowFloat_NumberHolder& RHS = dynamic_cast<const SlowFloat_NumberHolder&>(rhs);
+      const SlowFloat_NumberHolder& RHS = NumberHolder_cast<SlowFloat_NumberHolder>(rhs);
       return value <= RHS.value;
     }
 
    virtual bool greater (const NumberHolder& rhs) const override
     {
-      const SlowFloat_NumberHolder& RHS = dynamic_cast<const SlowFloat_NumberHolder&>(rhs);
+      const SlowFloat_NumberHolder& RHS = NumberHolder_cast<SlowFloat_NumberHolder>(rhs);
       return value > RHS.value;
     }
 
    virtual bool greater_equal (const NumberHolder& rhs) const override
     {
-      const SlowFloat_NumberHolder& RHS = dynamic_cast<const SlowFloat_NumberHolder&>(rhs);
+      const SlowFloat_NumberHolder& RHS = NumberHolder_cast<SlowFloat_NumberHolder>(rhs);
       return value >= RHS.value;
     }
 
    virtual bool equal (const NumberHolder& rhs) const override
     {
-      const SlowFloat_NumberHolder& RHS = dynamic_cast<const SlowFloat_NumberHolder&>(rhs);
+      const SlowFloat_NumberHolder& RHS = NumberHolder_cast<SlowFloat_NumberHolder>(rhs);
       return value == RHS.value;
     }
 
    virtual bool not_equal_to (const NumberHolder& rhs) const override
     {
-      const SlowFloat_NumberHolder& RHS = dynamic_cast<const SlowFloat_NumberHolder&>(rhs);
+      const SlowFloat_NumberHolder& RHS = NumberHolder_cast<SlowFloat_NumberHolder>(rhs);
       return value != RHS.value;
     }
 
@@ -163,28 +182,59 @@ public:
 
    virtual std::shared_ptr<NumberHolder> add (const NumberHolder& rhs) const override
     {
-      const SlowFloat_NumberHolder& RHS = dynamic_cast<const SlowFloat_NumberHolder&>(rhs);
+      const SlowFloat_NumberHolder& RHS = NumberHolder_cast<SlowFloat_NumberHolder>(rhs);
       return std::make_shared<SlowFloat_NumberHolder>(value + RHS.value);
     }
 
    virtual std::shared_ptr<NumberHolder> subtract (const NumberHolder& rhs) const override
     {
-      const SlowFloat_NumberHolder& RHS = dynamic_cast<const SlowFloat_NumberHolder&>(rhs);
+      const SlowFloat_NumberHolder& RHS = NumberHolder_cast<SlowFloat_NumberHolder>(rhs);
       return std::make_shared<SlowFloat_NumberHolder>(value - RHS.value);
     }
 
    virtual std::shared_ptr<NumberHolder> multiply (const NumberHolder& rhs) const override
     {
-      const SlowFloat_NumberHolder& RHS = dynamic_cast<const SlowFloat_NumberHolder&>(rhs);
+      const SlowFloat_NumberHolder& RHS = NumberHolder_cast<SlowFloat_NumberHolder>(rhs);
       return std::make_shared<SlowFloat_NumberHolder>(value * RHS.value);
     }
 
    virtual std::shared_ptr<NumberHolder> divide (const NumberHolder& rhs) const override
     {
-      const SlowFloat_NumberHolder& RHS = dynamic_cast<const SlowFloat_NumberHolder&>(rhs);
+      const SlowFloat_NumberHolder& RHS = NumberHolder_cast<SlowFloat_NumberHolder>(rhs);
       return std::make_shared<SlowFloat_NumberHolder>(value / RHS.value);
     }
 
+   virtual void addAssign (const NumberHolder& rhs) override
+    {
+      const SlowFloat_NumberHolder& RHS = NumberHolder_cast<SlowFloat_NumberHolder>(rhs);
+      value = value + RHS.value;
+    }
+
+   virtual void subtractAssign (const NumberHolder& rhs) override
+    {
+      const SlowFloat_NumberHolder& RHS = NumberHolder_cast<SlowFloat_NumberHolder>(rhs);
+      value = value - RHS.value;
+    }
+
+   virtual void multiplyAssign (const NumberHolder& rhs) override
+    {
+      const SlowFloat_NumberHolder& RHS = NumberHolder_cast<SlowFloat_NumberHolder>(rhs);
+      value = value * RHS.value;
+    }
+
+   virtual void divideAssign (const NumberHolder& rhs) override
+    {
+      const SlowFloat_NumberHolder& RHS = NumberHolder_cast<SlowFloat_NumberHolder>(rhs);
+      value = value / RHS.value;
+    }
+
+   virtual void fusedMultiplyAdd (const NumberHolder& lhs, const NumberHolder& rhs) override
+    {
+      const SlowFloat_NumberHolder& LHS = NumberHolder_cast<SlowFloat_NumberHolder>(lhs);
+      const SlowFloat_NumberHolder& RHS = NumberHolder_cast<SlowFloat_NumberHolder>(rhs);
+      value = value + LHS.value * RHS.value;
+    }
+
  };
 
 
@@ -215,6 +265,16 @@ std::shared_ptr<NumberHolder> SlowFloat_NumberSystem::fromInt(size_t src) const
    return std::make_shared<SlowFloat_NumberHolder>(SlowFloat::SlowFloat(static_cast<double>(src)));
  }
 
+NumberSystem_System SlowFloat_NumberSystem::getSystem() const
+ {
+   return SLOWFLOAT_NUMBER_SYSTEM;
+ }
+
+std::shared_ptr<NumberHolder> SlowFloat_NumberSystem::deserialize(const char* src, size_t length) const
+ {
+   return SlowFloat_NumberHolder::deserialize(src, length);
+ }
+
 
 void SlowFloat_NumberSystem::setRoundMode(NumberSystem_Round_Mode mode)
  {
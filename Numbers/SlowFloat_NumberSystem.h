@@ -45,6 +45,9 @@ public:
 
    virtual std::shared_ptr<NumberHolder> fromInt(size_t) const override;
 
+   virtual NumberSystem_System getSystem() const override;
+   virtual std::shared_ptr<NumberHolder> deserialize(const char*, size_t) const override;
+
    virtual void setRoundMode(NumberSystem_Round_Mode) override;
 
    virtual size_t getDefaultPrecision() const override;
@@ -33,6 +33,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "NumberHolder.h"
 
 #include <cmath>
+#include <cstring>
+#include <typeinfo>
 #include <cfenv>
 #include <cstdlib>
 #include <sstream>
@@ -43,6 +45,8 @@ class double_NumberHolder final : public NumberHolder
 private:
    double value;
 
+   friend class double_NumberSystem;
+
 public:
    double_NumberHolder() = delete;
    explicit double_NumberHolder(double src) : value(src) { }
@@ -92,6 +96,18 @@ public:
     }
 
 
+   virtual void serialize(std::string& out) const override { out.append(reinterpret_cast<const char*>(&value), sizeof(value)); }
+   static std::shared_ptr<NumberHolder> deserialize(const char* src, size_t length)
+    {
+      if (sizeof(double) != length)
+       {
+         return std::shared_ptr<NumberHolder>();
+       }
+      double result;
+      std::memcpy(&result, src, sizeof(result));
+      return std::make_shared<double_NumberHolder>(result);
+    }
+
    virtual bool isSigned() const override { return std::signbit(value); }
    virtual bool isZero() const override { return FP_ZERO == std::fpclassify(value); }
    virtual bool isNaN() const override { return std::isnan(value); }
@@ -123,37 +139,37 @@ public:
 
    virtual bool less (const NumberHolder& rhs) const override
     {
-      const double_NumberHolder& RHS = dynamic_cast<const double_NumberHolder&>(rhs);
+      const double_NumberHolder& RHS = NumberHolder_cast<double_NumberHolder>(rhs);
       return value < RHS.value;
     }
 
    virtual bool less_equal (const NumberHolder& rhs) const override
     {
-      const double_NumberHolder& RHS = dynamic_cast<const double_NumberHolder&>(rhs);
+      const double_NumberHolder& RHS = NumberHolder_cast<double_NumberHolder>(rhs);
       return value <= RHS.value;
     }
 
    virtual bool greater (const NumberHolder& rhs) const override
     {
-      const double_NumberHolder& RHS = dynamic_cast<const double_NumberHolder&>(rhs);
+      const double_NumberHolder& RHS = NumberHolder_cast<double_NumberHolder>(rhs);
       return value > RHS.value;
     }
 
    virtual bool greater_equal (const NumberHolder& rhs) const override
     {
-      const double_NumberHolder& RHS = dynamic_cast<const double_NumberHolder&>(rhs);
+      const double_NumberHolder& RHS = NumberHolder_cast<double_NumberHolder>(rhs);
       return value >= RHS.value;
     }
 
    virtual bool equal (const NumberHolder& rhs) const override
     {
-      const double_NumberHolder& RHS = dynamic_cast<const double_NumberHolder&>(rhs);
+      const double_NumberHolder& RHS = NumberHolder_cast<double_NumberHolder>(rhs);
       return value == RHS.value;
     }
 
    virtual bool not_equal_to (const NumberHolder& rhs) const override
     {
-      const double_NumberHolder& RHS = dynamic_cast<const double_NumberHolder&>(rhs);
+      const double_NumberHolder& RHS = NumberHolder_cast<double_NumberHolder>(rhs);
       return value != RHS.value;
     }
 
@@ -161,28 +177,59 @@ public:
 
    virtual std::shared_ptr<NumberHolder> add (const NumberHolder& rhs) const override
     {
-      const double_NumberHolder& RHS = dynamic_cast<const double_NumberHolder&>(rhs);
+      const double_NumberHolder& RHS = NumberHolder_cast<double_NumberHolder>(rhs);
       return std::make_shared<double_NumberHolder>(value + RHS.value);
     }
 
    virtual std::shared_ptr<NumberHolder> subtract (const NumberHolder& rhs) const override
     {
-      const double_NumberHolder& RHS = dynamic_cast<const double_NumberHolder&>(rhs);
+      const double_NumberHolder& RHS = NumberHolder_cast<double_NumberHolder>(rhs);
       return std::make_shared<double_NumberHolder>(value - RHS.value);
     }
 
    virtual std::shared_ptr<NumberHolder> multiply (const NumberHolder& rhs) const override
     {
-      const double_NumberHolder& RHS = dynamic_cast<const double_NumberHolder&>(rhs);
+      const double_NumberHolder& RHS = NumberHolder_cast<double_NumberHolder>(rhs);
       return std::make_shared<double_NumberHolder>(value * RHS.value);
     }
 
    virtual std::shared_ptr<NumberHolder> divide (const NumberHolder& rhs) const override
     {
-      const double_NumberHolder& RHS = dynamic_cast<const double_NumberHolder&>(rhs);
+      const double_NumberHolder& RHS = NumberHolder_cast<double_NumberHolder>(rhs);
       return std::make_shared<double_NumberHolder>(value / RHS.value);
     }
 
+   virtual void addAssign (const NumberHolder& rhs) override
+    {
+      const double_NumberHolder& RHS = NumberHolder_cast<double_NumberHolder>(rhs);
+      value += RHS.value;
+    }
+
+   virtual void subtractAssign (const NumberHolder& rhs) override
+    {
+      const double_NumberHolder& RHS = NumberHolder_cast<double_NumberHolder>(rhs);
+      value -= RHS.value;
+    }
+
+   virtual void multiplyAssign (const NumberHolder& rhs) override
+    {
+      const double_NumberHolder& RHS = NumberHolder_cast<double_NumberHolder>(rhs);
+      value *= RHS.value;
+    }
+
+   virtual void divideAssign (const NumberHolder& rhs) override
+    {
+      const double_NumberHolder& RHS = NumberHolder_cast<double_NumberHolder>(rhs);
+      value /= RHS.value;
+    }
+
+   virtual void fusedMultiplyAdd (const NumberHolder& lhs, const NumberHolder& rhs) override
+    {
+      const double_NumberHolder& LHS = NumberHolder_cast<double_NumberHolder>(lhs);
+      const double_NumberHolder& RHS = NumberHolder_cast<double_NumberHolder>(rhs);
+      value = std::fma(LHS.value, RHS.value, value);
+    }
+
  };
 
 
@@ -220,6 +267,16 @@ std::shared_ptr<NumberHolder> double_NumberSystem::fromInt(size_t src) const
    return std::make_shared<double_NumberHolder>(static_cast<double>(src));
  }
 
+NumberSystem_System double_NumberSystem::getSystem() const
+ {
+   return DOUBLE_NUMBER_SYSTEM;
+ }
+
+std::shared_ptr<NumberHolder> double_NumberSystem::deserialize(const char* src, size_t length) const
+ {
+   return double_NumberHolder::deserialize(src, length);
+ }
+
 
 void double_NumberSystem::setRoundMode(NumberSystem_Round_Mode mode)
  {
@@ -263,3 +320,23 @@ size_t double_NumberSystem::getDefaultPrecision() const
 void double_NumberSystem::setDefaultPrecision(size_t)
  {
  }
+
+
+bool double_NumberSystem::toInline(const NumberHolder& src, uint64_t& bits) const
+ {
+      // This is asked of every operand: don't pay for a dynamic_cast.
+   if (typeid(double_NumberHolder) != typeid(src))
+    {
+      return false;
+    }
+   const double_NumberHolder* holder = static_cast<const double_NumberHolder*>(&src);
+   std::memcpy(&bits, &holder->value, sizeof(bits));
+   return true;
+ }
+
+std::shared_ptr<NumberHolder> double_NumberSystem::fromInline(uint64_t bits) const
+ {
+   double result;
+   std::memcpy(&result, &bits, sizeof(result));
+   return std::make_shared<double_NumberHolder>(result);
+ }
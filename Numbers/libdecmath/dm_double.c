@@ -282,7 +282,12 @@ const uint64_t makeShift [] =
    10000000000000000ULL, 10000000000000000ULL // 16
  };
 
-int dm_global_round_mode = DM_FE_TONEAREST;
+   /* Like the floating-point environment, each thread has its own rounding mode. */
+#ifdef _MSC_VER
+__declspec(thread) int dm_global_round_mode = DM_FE_TONEAREST;
+#else
+_Thread_local int dm_global_round_mode = DM_FE_TONEAREST;
+#endif
 
 int dm_fesetround(int round_mode)
  {
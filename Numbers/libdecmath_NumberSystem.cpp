@@ -36,12 +36,16 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "libdecmath/dm_double_pretty.h"
 
 #include <cmath>
+#include <cstring>
+#include <typeinfo>
 
 class libdecmath_NumberHolder final : public NumberHolder
  {
 private:
    dm_double value;
 
+   friend class libdecmath_NumberSystem;
+
 public:
    libdecmath_NumberHolder()= delete;
    explicit libdecmath_NumberHolder(dm_double src) : value(src) { }
@@ -87,6 +91,18 @@ public:
     }
 
 
+   virtual void serialize(std::string& out) const override { out.append(reinterpret_cast<const char*>(&value), sizeof(value)); }
+   static std::shared_ptr<NumberHolder> deserialize(const char* src, size_t length)
+    {
+      if (sizeof(dm_double) != length)
+       {
+         return std::shared_ptr<NumberHolder>();
+       }
+      dm_double result;
+      std::memcpy(&result, src, sizeof(result));
+      return std::make_shared<libdecmath_NumberHolder>(result);
+    }
+
    virtual bool isSigned() const override { return 1 == dm_double_signbit(value); }
    virtual bool isZero() const override { return 1 == dm_double_iszero(value); }
    virtual bool isNaN() const override { return 1 == dm_double_isnan(value); }
@@ -129,37 +145,37 @@ public:
 
    virtual bool less (const NumberHolder& rhs) const override
     {
-      const libdecmath_NumberHolder& RHS = dynamic_cast<const libdecmath_NumberHolder&>(rhs);
+      const libdecmath_NumberHolder& RHS = NumberHolder_cast<libdecmath_NumberHolder>(rhs);
       return 1 == dm_double_isless(value, RHS.value);
     }
 
    virtual bool less_equal (const NumberHolder& rhs) const override
     {
-      const libdecmath_NumberHolder& RHS = dynamic_cast<const libdecmath_NumberHolder&>(rhs);
+      const libdecmath_NumberHolder& RHS = NumberHolder_cast<libdecmath_NumberHolder>(rhs);
       return 1 == dm_double_islessequal(value, RHS.value);
     }
 
    virtual bool greater (const NumberHolder& rhs) const override
     {
-      const libdecmath_NumberHolder& RHS = dynamic_cast<const libdecmath_NumberHolder&>(rhs);
+      const libdecmath_NumberHolder& RHS = NumberHolder_cast<libdecmath_NumberHolder>(rhs);
       return 1 == dm_double_isgreater(value, RHS.value);
     }
 
    virtual bool greater_equal (const NumberHolder& rhs) const override
     {
-      const libdecmath_NumberHolder& RHS = dynamic_cast<const libdecmath_NumberHolder&>(rhs);
+      const libdecmath_NumberHolder& RHS = NumberHolder_cast<libdecmath_NumberHolder>(rhs);
       return 1 == dm_double_isgreaterequal(value, RHS.value);
     }
 
    virtual bool equal (const NumberHolder& rhs) const override
     {
-      const libdecmath_NumberHolder& RHS = dynamic_cast<const libdecmath_NumberHolder&>(rhs);
+      const libdecmath_NumberHolder& RHS = NumberHolder_cast<libdecmath_NumberHolder>(rhs);
       return 1 == dm_double_isequal(value, RHS.value);
     }
 
    virtual bool not_equal_to (const NumberHolder& rhs) const override
     {
-      const libdecmath_NumberHolder& RHS = dynamic_cast<const libdecmath_NumberHolder&>(rhs);
+      const libdecmath_NumberHolder& RHS = NumberHolder_cast<libdecmath_NumberHolder>(rhs);
       return 1 == dm_double_isunequal(value, RHS.value);
     }
 
@@ -167,28 +183,59 @@ public:
 
    virtual std::shared_ptr<NumberHolder> add (const NumberHolder& rhs) const override
     {
-      const libdecmath_NumberHolder& RHS = dynamic_cast<const libdecmath_NumberHolder&>(rhs);
+      const libdecmath_NumberHolder& RHS = NumberHolder_cast<libdecmath_NumberHolder>(rhs);
       return std::make_shared<libdecmath_NumberHolder>(dm_double_add(value, RHS.value));
     }
 
    virtual std::shared_ptr<NumberHolder> subtract (const NumberHolder& rhs) const override
     {
-      const libdecmath_NumberHolder& RHS = dynamic_cast<const libdecmath_NumberHolder&>(rhs);
+      const libdecmath_NumberHolder& RHS = NumberHolder_cast<libdecmath_NumberHolder>(rhs);
       return std::make_shared<libdecmath_NumberHolder>(dm_double_sub(value, RHS.value));
     }
 
    virtual std::shared_ptr<NumberHolder> multiply (const NumberHolder& rhs) const override
     {
-      const libdecmath_NumberHolder& RHS = dynamic_cast<const libdecmath_NumberHolder&>(rhs);
+      const libdecmath_NumberHolder& RHS = NumberHolder_cast<libdecmath_NumberHolder>(rhs);
       return std::make_shared<libdecmath_NumberHolder>(dm_double_mul(value, RHS.value));
     }
 
    virtual std::shared_ptr<NumberHolder> divide (const NumberHolder& rhs) const override
     {
-      const libdecmath_NumberHolder& RHS = dynamic_cast<const libdecmath_NumberHolder&>(rhs);
+      const libdecmath_NumberHolder& RHS = NumberHolder_cast<libdecmath_NumberHolder>(rhs);
       return std::make_shared<libdecmath_NumberHolder>(dm_double_div(value, RHS.value));
     }
 
+   virtual void addAssign (const NumberHolder& rhs) override
+    {
+      const libdecmath_NumberHolder& RHS = NumberHolder_cast<libdecmath_NumberHolder>(rhs);
+      value = dm_double_add(value, RHS.value);
+    }
+
+   virtual void subtractAssign (const NumberHolder& rhs) override
+    {
+      const libdecmath_NumberHolder& RHS = NumberHolder_cast<libdecmath_NumberHolder>(rhs);
+      value = dm_double_sub(value, RHS.value);
+    }
+
+   virtual void multiplyAssign (const NumberHolder& rhs) override
+    {
+      const libdecmath_NumberHolder& RHS = NumberHolder_cast<libdecmath_NumberHolder>(rhs);
+      value = dm_double_mul(value, RHS.value);
+    }
+
+   virtual void divideAssign (const NumberHolder& rhs) override
+    {
+      const libdecmath_NumberHolder& RHS = NumberHolder_cast<libdecmath_NumberHolder>(rhs);
+      value = dm_double_div(value, RHS.value);
+    }
+
+   virtual void fusedMultiplyAdd (const NumberHolder& lhs, const NumberHolder& rhs) override
+    {
+      const libdecmath_NumberHolder& LHS = NumberHolder_cast<libdecmath_NumberHolder>(lhs);
+      const libdecmath_NumberHolder& RHS = NumberHolder_cast<libdecmath_NumberHolder>(rhs);
+      value = dm_double_fma(LHS.value, RHS.value, value);
+    }
+
  };
 
 
@@ -219,6 +266,16 @@ std::shared_ptr<NumberHolder> libdecmath_NumberSystem::fromInt(size_t src) const
    return std::make_shared<libdecmath_NumberHolder>(dm_double_fromdouble(static_cast<double>(src)));
  }
 
+NumberSystem_System libdecmath_NumberSystem::getSystem() const
+ {
+   return LIBDECMATH_NUMBER_SYSTEM;
+ }
+
+std::shared_ptr<NumberHolder> libdecmath_NumberSystem::deserialize(const char* src, size_t length) const
+ {
+   return libdecmath_NumberHolder::deserialize(src, length);
+ }
+
 
 void libdecmath_NumberSystem::setRoundMode(NumberSystem_Round_Mode mode)
  {
@@ -270,3 +327,21 @@ size_t libdecmath_NumberSystem::getDefaultPrecision() const
 void libdecmath_NumberSystem::setDefaultPrecision(size_t)
  {
  }
+
+
+bool libdecmath_NumberSystem::toInline(const NumberHolder& src, uint64_t& bits) const
+ {
+      // This is asked of every operand: don't pay for a dynamic_cast.
+   if (typeid(libdecmath_NumberHolder) != typeid(src))
+    {
+      return false;
+    }
+   const libdecmath_NumberHolder* holder = static_cast<const libdecmath_NumberHolder*>(&src);
+   bits = holder->value;
+   return true;
+ }
+
+std::shared_ptr<NumberHolder> libdecmath_NumberSystem::fromInline(uint64_t bits) const
+ {
+   return std::make_shared<libdecmath_NumberHolder>(bits);
+ }
@@ -45,10 +45,16 @@ public:
 
    virtual std::shared_ptr<NumberHolder> fromInt(size_t) const override;
 
+   virtual NumberSystem_System getSystem() const override;
+   virtual std::shared_ptr<NumberHolder> deserialize(const char*, size_t) const override;
+
    virtual void setRoundMode(NumberSystem_Round_Mode) override;
 
    virtual size_t getDefaultPrecision() const override;
    virtual void setDefaultPrecision(size_t) override;
+
+   virtual bool toInline(const NumberHolder&, uint64_t&) const override;
+   virtual std::shared_ptr<NumberHolder> fromInline(uint64_t) const override;
  };
 
 #endif /* LIBDECMATH_NUMBERSYSTEM_H */
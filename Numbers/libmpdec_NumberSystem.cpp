@@ -34,11 +34,24 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "../external/libmpdec/mpdecimal.h"
 #include <cmath>
+#include <cstring>
 #include <cctype>
 
-static int ROUND_MODE = MPD_ROUND_HALF_EVEN;
-static size_t PRECISION = 34U; // IEEE 754 Quad
-static mpd_context_t CONTEXT;
+   // Each thread has its own rounding mode and precision, and its own context to do work in.
+static thread_local int ROUND_MODE = MPD_ROUND_HALF_EVEN;
+static thread_local size_t PRECISION = 34U; // IEEE 754 Quad
+
+   // Not mpd_init: that also sets libmpdec's global MPD_MINALLOC, which may only be done once (see the constructor).
+static mpd_context_t makeContext()
+ {
+   mpd_context_t result;
+   mpd_defaultcontext(&result);
+   mpd_qsetprec(&result, PRECISION);
+   mpd_qsetround(&result, ROUND_MODE);
+   return result;
+ }
+
+static thread_local mpd_context_t CONTEXT = makeContext();
 
 class libdec_NumberHolder final : public NumberHolder
  {
@@ -128,6 +141,56 @@ public:
     }
 
 
+      // The precision, the sign and kind, the exponent, digits and length, and then the coefficient's words.
+   virtual void serialize(std::string& out) const override
+    {
+      uint8_t flags = value->flags & (MPD_NEG | MPD_SPECIAL);
+      out.append(reinterpret_cast<const char*>(&precision), sizeof(precision));
+      out.append(reinterpret_cast<const char*>(&flags), sizeof(flags));
+      out.append(reinterpret_cast<const char*>(&value->exp), sizeof(value->exp));
+      out.append(reinterpret_cast<const char*>(&value->digits), sizeof(value->digits));
+      out.append(reinterpret_cast<const char*>(&value->len), sizeof(value->len));
+      out.append(reinterpret_cast<const char*>(value->data), value->len * sizeof(mpd_uint_t));
+    }
+   static std::shared_ptr<NumberHolder> deserialize(const char* src, size_t length)
+    {
+      size_t prec;
+      uint8_t flags;
+      mpd_ssize_t exp, digits, len;
+      const size_t header = sizeof(prec) + sizeof(flags) + sizeof(exp) + sizeof(digits) + sizeof(len);
+      if (length < header)
+       {
+         return std::shared_ptr<NumberHolder>();
+       }
+      std::memcpy(&prec, src, sizeof(prec));
+      src += sizeof(prec);
+      std::memcpy(&flags, src, sizeof(flags));
+      src += sizeof(flags);
+      std::memcpy(&exp, src, sizeof(exp));
+      src += sizeof(exp);
+      std::memcpy(&digits, src, sizeof(digits));
+      src += sizeof(digits);
+      std::memcpy(&len, src, sizeof(len));
+      src += sizeof(len);
+      if ((len < 0) || (length != header + len * sizeof(mpd_uint_t)))
+       {
+         return std::shared_ptr<NumberHolder>();
+       }
+
+      std::shared_ptr<libdec_NumberHolder> result = std::make_shared<libdec_NumberHolder>(prec);
+      uint32_t status = 0U;
+      if (0 == mpd_qresize(result->value, (0 == len) ? 1 : len, &status)) // Specials may have no coefficient.
+       {
+         return std::shared_ptr<NumberHolder>();
+       }
+      std::memcpy(result->value->data, src, len * sizeof(mpd_uint_t));
+      result->value->exp = exp;
+      result->value->digits = digits;
+      result->value->len = len;
+      mpd_set_flags(result->value, flags);
+      return result;
+    }
+
    virtual bool isSigned() const override { return 0 != mpd_isnegative(value); }
    virtual bool isZero() const override { return 0 != mpd_iszero(value); }
    virtual bool isNaN() const override { return 0 != mpd_isnan(value); }
@@ -192,7 +255,7 @@ public:
 
    virtual bool less (const NumberHolder& rhs) const override
     {
-      const libdec_NumberHolder& RHS = dynamic_cast<const libdec_NumberHolder&>(rhs);
+      const libdec_NumberHolder& RHS = NumberHolder_cast<libdec_NumberHolder>(rhs);
       if ((0 != mpd_isnan(value)) || (0 != mpd_isnan(RHS.value))) return false;
       uint32_t trash;
       return mpd_qcmp(value, RHS.value, &trash) < 0;
@@ -200,7 +263,7 @@ public:
 
    virtual bool less_equal (const NumberHolder& rhs) const override
     {
-      const libdec_NumberHolder& RHS = dynamic_cast<const libdec_NumberHolder&>(rhs);
+      const libdec_NumberHolder& RHS = NumberHolder_cast<libdec_NumberHolder>(rhs);
       if ((0 != mpd_isnan(value)) || (0 != mpd_isnan(RHS.value))) return false;
       uint32_t trash;
       return mpd_qcmp(value, RHS.value, &trash) <= 0;
@@ -208,7 +271,7 @@ public:
 
    virtual bool greater (const NumberHolder& rhs) const override
     {
-      const libdec_NumberHolder& RHS = dynamic_cast<const libdec_NumberHolder&>(rhs);
+      const libdec_NumberHolder& RHS = NumberHolder_cast<libdec_NumberHolder>(rhs);
       if ((0 != mpd_isnan(value)) || (0 != mpd_isnan(RHS.value))) return false;
       uint32_t trash;
       return mpd_qcmp(value, RHS.value, &trash) > 0;
@@ -216,7 +279,7 @@ public:
 
    virtual bool greater_equal (const NumberHolder& rhs) const override
     {
-      const libdec_NumberHolder& RHS = dynamic_cast<const libdec_NumberHolder&>(rhs);
+      const libdec_NumberHolder& RHS = NumberHolder_cast<libdec_NumberHolder>(rhs);
       if ((0 != mpd_isnan(value)) || (0 != mpd_isnan(RHS.value))) return false;
       uint32_t trash;
       return mpd_qcmp(value, RHS.value, &trash) >= 0;
@@ -224,7 +287,7 @@ public:
 
    virtual bool equal (const NumberHolder& rhs) const override
     {
-      const libdec_NumberHolder& RHS = dynamic_cast<const libdec_NumberHolder&>(rhs);
+      const libdec_NumberHolder& RHS = NumberHolder_cast<libdec_NumberHolder>(rhs);
       if ((0 != mpd_isnan(value)) || (0 != mpd_isnan(RHS.value))) return false;
       uint32_t trash;
       return mpd_qcmp(value, RHS.value, &trash) == 0;
@@ -232,7 +295,7 @@ public:
 
    virtual bool not_equal_to (const NumberHolder& rhs) const override
     {
-      const libdec_NumberHolder& RHS = dynamic_cast<const libdec_NumberHolder&>(rhs);
+      const libdec_NumberHolder& RHS = NumberHolder_cast<libdec_NumberHolder>(rhs);
       if ((0 != mpd_isnan(value)) || (0 != mpd_isnan(RHS.value))) return false;
       uint32_t trash;
       return mpd_qcmp(value, RHS.value, &trash) != 0;
@@ -242,7 +305,7 @@ public:
 
    virtual std::shared_ptr<NumberHolder> add (const NumberHolder& rhs) const override
     {
-      const libdec_NumberHolder& RHS = dynamic_cast<const libdec_NumberHolder&>(rhs);
+      const libdec_NumberHolder& RHS = NumberHolder_cast<libdec_NumberHolder>(rhs);
       size_t prec = std::max(precision, RHS.precision);
       std::shared_ptr<libdec_NumberHolder> temp = std::make_shared<libdec_NumberHolder>(prec);
       uint32_t trash;
@@ -254,7 +317,7 @@ public:
 
    virtual std::shared_ptr<NumberHolder> subtract (const NumberHolder& rhs) const override
     {
-      const libdec_NumberHolder& RHS = dynamic_cast<const libdec_NumberHolder&>(rhs);
+      const libdec_NumberHolder& RHS = NumberHolder_cast<libdec_NumberHolder>(rhs);
       size_t prec = std::max(precision, RHS.precision);
       std::shared_ptr<libdec_NumberHolder> temp = std::make_shared<libdec_NumberHolder>(prec);
       uint32_t trash;
@@ -266,7 +329,7 @@ public:
 
    virtual std::shared_ptr<NumberHolder> multiply (const NumberHolder& rhs) const override
     {
-      const libdec_NumberHolder& RHS = dynamic_cast<const libdec_NumberHolder&>(rhs);
+      const libdec_NumberHolder& RHS = NumberHolder_cast<libdec_NumberHolder>(rhs);
       size_t prec = std::min(precision + RHS.precision, std::max(std::max(precision, RHS.precision), PRECISION));
       std::shared_ptr<libdec_NumberHolder> temp = std::make_shared<libdec_NumberHolder>(prec);
       uint32_t trash;
@@ -278,7 +341,7 @@ public:
 
    virtual std::shared_ptr<NumberHolder> divide (const NumberHolder& rhs) const override
     {
-      const libdec_NumberHolder& RHS = dynamic_cast<const libdec_NumberHolder&>(rhs);
+      const libdec_NumberHolder& RHS = NumberHolder_cast<libdec_NumberHolder>(rhs);
       std::shared_ptr<libdec_NumberHolder> temp = std::make_shared<libdec_NumberHolder>(PRECISION);
       uint32_t trash;
       mpd_qsetprec(&CONTEXT, PRECISION);
@@ -287,6 +350,62 @@ public:
       return temp;
     }
 
+   virtual void addAssign (const NumberHolder& rhs) override
+    {
+      const libdec_NumberHolder& RHS = NumberHolder_cast<libdec_NumberHolder>(rhs);
+      size_t prec = std::max(precision, RHS.precision);
+      uint32_t trash;
+      mpd_qsetprec(&CONTEXT, prec);
+      mpd_qsetround(&CONTEXT, ROUND_MODE);
+      mpd_qadd(value, value, RHS.value, &CONTEXT, &trash);
+      precision = prec;
+    }
+
+   virtual void subtractAssign (const NumberHolder& rhs) override
+    {
+      const libdec_NumberHolder& RHS = NumberHolder_cast<libdec_NumberHolder>(rhs);
+      size_t prec = std::max(precision, RHS.precision);
+      uint32_t trash;
+      mpd_qsetprec(&CONTEXT, prec);
+      mpd_qsetround(&CONTEXT, ROUND_MODE);
+      mpd_qsub(value, value, RHS.value, &CONTEXT, &trash);
+      precision = prec;
+    }
+
+   virtual void multiplyAssign (const NumberHolder& rhs) override
+    {
+      const libdec_NumberHolder& RHS = NumberHolder_cast<libdec_NumberHolder>(rhs);
+      size_t prec = std::min(precision + RHS.precision, std::max(std::max(precision, RHS.precision), PRECISION));
+      uint32_t trash;
+      mpd_qsetprec(&CONTEXT, prec);
+      mpd_qsetround(&CONTEXT, ROUND_MODE);
+      mpd_qmul(value, value, RHS.value, &CONTEXT, &trash);
+      precision = prec;
+    }
+
+   virtual void divideAssign (const NumberHolder& rhs) override
+    {
+      const libdec_NumberHolder& RHS = NumberHolder_cast<libdec_NumberHolder>(rhs);
+      uint32_t trash;
+      mpd_qsetprec(&CONTEXT, PRECISION);
+      mpd_qsetround(&CONTEXT, ROUND_MODE);
+      mpd_qdiv(value, value, RHS.value, &CONTEXT, &trash);
+      precision = PRECISION;
+    }
+
+   virtual void fusedMultiplyAdd (const NumberHolder& lhs, const NumberHolder& rhs) override
+    {
+      const libdec_NumberHolder& LHS = NumberHolder_cast<libdec_NumberHolder>(lhs);
+      const libdec_NumberHolder& RHS = NumberHolder_cast<libdec_NumberHolder>(rhs);
+         // At the precision that multiply then add would give.
+      size_t prec = std::max(precision, std::min(LHS.precision + RHS.precision, std::max(std::max(LHS.precision, RHS.precision), PRECISION)));
+      uint32_t trash;
+      mpd_qsetprec(&CONTEXT, prec);
+      mpd_qsetround(&CONTEXT, ROUND_MODE);
+      mpd_qfma(value, LHS.value, RHS.value, value, &CONTEXT, &trash);
+      precision = prec;
+    }
+
  };
 
 
@@ -296,8 +415,12 @@ libmpdec_NumberSystem::libmpdec_NumberSystem() : NumberSystem(
    std::shared_ptr<libdec_NumberHolder>(),
    std::shared_ptr<libdec_NumberHolder>())
  {
-   mpd_init(&CONTEXT, PRECISION);
-   mpd_qsetround(&CONTEXT, ROUND_MODE);
+      // What mpd_init would choose for the default precision. This runs once, before there are other threads.
+   mpd_ssize_t minalloc = 2 * ((PRECISION + MPD_RDIGITS - 1) / MPD_RDIGITS);
+   if (minalloc < MPD_MINALLOC_MIN) minalloc = MPD_MINALLOC_MIN;
+   if (minalloc > MPD_MINALLOC_MAX) minalloc = MPD_MINALLOC_MAX;
+   mpd_setminalloc(minalloc);
+
    FLOAT_ZERO = std::make_shared<libdec_NumberHolder>("0.0");
    FLOAT_ONE = std::make_shared<libdec_NumberHolder>("1.0");
    FLOAT_NAN = std::make_shared<libdec_NumberHolder>("NAN");
@@ -323,6 +446,16 @@ std::shared_ptr<NumberHolder> libmpdec_NumberSystem::fromInt(size_t src) const
    return std::make_shared<libdec_NumberHolder>(std::to_string(src).c_str());
  }
 
+NumberSystem_System libmpdec_NumberSystem::getSystem() const
+ {
+   return LIBMPDEC_NUMBER_SYSTEM;
+ }
+
+std::shared_ptr<NumberHolder> libmpdec_NumberSystem::deserialize(const char* src, size_t length) const
+ {
+   return libdec_NumberHolder::deserialize(src, length);
+ }
+
 
 void libmpdec_NumberSystem::setRoundMode(NumberSystem_Round_Mode mode)
  {
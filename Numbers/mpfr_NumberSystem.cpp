@@ -34,10 +34,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <mpfr.h>
 #include <cmath>
+#include <cstring>
 #include <cctype>
 
-static mpfr_rnd_t ROUND_MODE = MPFR_RNDN;
-static size_t PRECISION = 34U; // IEEE 754 Quad
+   // Each thread has its own rounding mode and precision.
+static thread_local mpfr_rnd_t ROUND_MODE = MPFR_RNDN;
+static thread_local size_t PRECISION = 34U; // IEEE 754 Quad
 static const double digits2bits = 3.321928094887362347870319429489;
 
 static size_t bitComp(size_t digits)
@@ -51,6 +53,27 @@ private:
    mpfr_t value;
    size_t precision;
 
+      // The result of an operation has as many bits as a new holder of its precision would.
+      // That's usually what we already have: then we can do it in place.
+   template <class Operation>
+   void inPlace(size_t prec, Operation op)
+    {
+      mpfr_prec_t bits = static_cast<mpfr_prec_t>(bitComp(prec));
+      if (bits == mpfr_get_prec(value))
+       {
+         op(value, value);
+       }
+      else
+       {
+         mpfr_t temp;
+         mpfr_init2(temp, bits);
+         op(temp, value);
+         mpfr_swap(value, temp);
+         mpfr_clear(temp);
+       }
+      precision = prec;
+    }
+
 public:
    mpfr_NumberHolder() = delete;
    mpfr_NumberHolder(mpfr_srcptr src, size_t precision) : precision(precision)
@@ -165,6 +188,52 @@ public:
     }
 
 
+      // The precision (decimal and binary), the sign, the exponent, and then the limbs.
+   virtual void serialize(std::string& out) const override
+    {
+      out.append(reinterpret_cast<const char*>(&precision), sizeof(precision));
+      out.append(reinterpret_cast<const char*>(&value->_mpfr_prec), sizeof(value->_mpfr_prec));
+      out.append(reinterpret_cast<const char*>(&value->_mpfr_sign), sizeof(value->_mpfr_sign));
+      out.append(reinterpret_cast<const char*>(&value->_mpfr_exp), sizeof(value->_mpfr_exp));
+      out.append(reinterpret_cast<const char*>(value->_mpfr_d), limbs(value->_mpfr_prec) * sizeof(mp_limb_t));
+    }
+   static size_t limbs(mpfr_prec_t prec)
+    {
+      return (prec + GMP_NUMB_BITS - 1) / GMP_NUMB_BITS;
+    }
+   static std::shared_ptr<NumberHolder> deserialize(const char* src, size_t length)
+    {
+      size_t prec;
+      mpfr_prec_t bits;
+      mpfr_sign_t sign;
+      mpfr_exp_t exp;
+      const size_t header = sizeof(prec) + sizeof(bits) + sizeof(sign) + sizeof(exp);
+      if (length < header)
+       {
+         return std::shared_ptr<NumberHolder>();
+       }
+      std::memcpy(&prec, src, sizeof(prec));
+      src += sizeof(prec);
+      std::memcpy(&bits, src, sizeof(bits));
+      src += sizeof(bits);
+      std::memcpy(&sign, src, sizeof(sign));
+      src += sizeof(sign);
+      std::memcpy(&exp, src, sizeof(exp));
+      src += sizeof(exp);
+      if ((bits < 1) || (length != header + limbs(bits) * sizeof(mp_limb_t)))
+       {
+         return std::shared_ptr<NumberHolder>();
+       }
+
+      std::shared_ptr<mpfr_NumberHolder> result = std::make_shared<mpfr_NumberHolder>(prec);
+      mpfr_clear(result->value);
+      mpfr_init2(result->value, bits);
+      result->value->_mpfr_sign = sign;
+      result->value->_mpfr_exp = exp;
+      std::memcpy(result->value->_mpfr_d, src, limbs(bits) * sizeof(mp_limb_t));
+      return result;
+    }
+
    virtual bool isSigned() const override { return 0 != mpfr_signbit(value); }
    virtual bool isZero() const override { return 0 != mpfr_zero_p(value); }
    virtual bool isNaN() const override { return 0 != mpfr_nan_p(value); }
@@ -215,37 +284,37 @@ public:
 
    virtual bool less (const NumberHolder& rhs) const override
     {
-      const mpfr_NumberHolder& RHS = dynamic_cast<const mpfr_NumberHolder&>(rhs);
+      const mpfr_NumberHolder& RHS = NumberHolder_cast<mpfr_NumberHolder>(rhs);
       return 0 != mpfr_less_p(value, RHS.value);
     }
 
    virtual bool less_equal (const NumberHolder& rhs) const override
     {
-      const mpfr_NumberHolder& RHS = dynamic_cast<const mpfr_NumberHolder&>(rhs);
+      const mpfr_NumberHolder& RHS = NumberHolder_cast<mpfr_NumberHolder>(rhs);
       return 0 != mpfr_lessequal_p(value, RHS.value);
     }
 
    virtual bool greater (const NumberHolder& rhs) const override
     {
-      const mpfr_NumberHolder& RHS = dynamic_cast<const mpfr_NumberHolder&>(rhs);
+      const mpfr_NumberHolder& RHS = NumberHolder_cast<mpfr_NumberHolder>(rhs);
       return 0 != mpfr_greater_p(value, RHS.value);
     }
 
    virtual bool greater_equal (const NumberHolder& rhs) const override
     {
-      const mpfr_NumberHolder& RHS = dynamic_cast<const mpfr_NumberHolder&>(rhs);
+      const mpfr_NumberHolder& RHS = NumberHolder_cast<mpfr_NumberHolder>(rhs);
       return 0 != mpfr_greaterequal_p(value, RHS.value);
     }
 
    virtual bool equal (const NumberHolder& rhs) const override
     {
-      const mpfr_NumberHolder& RHS = dynamic_cast<const mpfr_NumberHolder&>(rhs);
+      const mpfr_NumberHolder& RHS = NumberHolder_cast<mpfr_NumberHolder>(rhs);
       return 0 != mpfr_equal_p(value, RHS.value);
     }
 
    virtual bool not_equal_to (const NumberHolder& rhs) const override
     {
-      const mpfr_NumberHolder& RHS = dynamic_cast<const mpfr_NumberHolder&>(rhs);
+      const mpfr_NumberHolder& RHS = NumberHolder_cast<mpfr_NumberHolder>(rhs);
       return 0 == mpfr_equal_p(value, RHS.value);
     }
 
@@ -253,7 +322,7 @@ public:
 
    virtual std::shared_ptr<NumberHolder> add (const NumberHolder& rhs) const override
     {
-      const mpfr_NumberHolder& RHS = dynamic_cast<const mpfr_NumberHolder&>(rhs);
+      const mpfr_NumberHolder& RHS = NumberHolder_cast<mpfr_NumberHolder>(rhs);
       size_t prec = std::max(precision, RHS.precision);
       std::shared_ptr<mpfr_NumberHolder> temp = std::make_shared<mpfr_NumberHolder>(prec);
       mpfr_add(temp->value, value, RHS.value, ROUND_MODE);
@@ -262,7 +331,7 @@ public:
 
    virtual std::shared_ptr<NumberHolder> subtract (const NumberHolder& rhs) const override
     {
-      const mpfr_NumberHolder& RHS = dynamic_cast<const mpfr_NumberHolder&>(rhs);
+      const mpfr_NumberHolder& RHS = NumberHolder_cast<mpfr_NumberHolder>(rhs);
       size_t prec = std::max(precision, RHS.precision);
       std::shared_ptr<mpfr_NumberHolder> temp = std::make_shared<mpfr_NumberHolder>(prec);
       mpfr_sub(temp->value, value, RHS.value, ROUND_MODE);
@@ -271,7 +340,7 @@ public:
 
    virtual std::shared_ptr<NumberHolder> multiply (const NumberHolder& rhs) const override
     {
-      const mpfr_NumberHolder& RHS = dynamic_cast<const mpfr_NumberHolder&>(rhs);
+      const mpfr_NumberHolder& RHS = NumberHolder_cast<mpfr_NumberHolder>(rhs);
       size_t prec = std::min(precision + RHS.precision, std::max(std::max(precision, RHS.precision), PRECISION));
       std::shared_ptr<mpfr_NumberHolder> temp = std::make_shared<mpfr_NumberHolder>(prec);
       mpfr_mul(temp->value, value, RHS.value, ROUND_MODE);
@@ -280,12 +349,46 @@ public:
 
    virtual std::shared_ptr<NumberHolder> divide (const NumberHolder& rhs) const override
     {
-      const mpfr_NumberHolder& RHS = dynamic_cast<const mpfr_NumberHolder&>(rhs);
+      const mpfr_NumberHolder& RHS = NumberHolder_cast<mpfr_NumberHolder>(rhs);
       std::shared_ptr<mpfr_NumberHolder> temp = std::make_shared<mpfr_NumberHolder>(PRECISION);
       mpfr_div(temp->value, value, RHS.value, ROUND_MODE);
       return temp;
     }
 
+   virtual void addAssign (const NumberHolder& rhs) override
+    {
+      const mpfr_NumberHolder& RHS = NumberHolder_cast<mpfr_NumberHolder>(rhs);
+      inPlace(std::max(precision, RHS.precision), [&RHS](mpfr_ptr result, mpfr_srcptr src) { mpfr_add(result, src, RHS.value, ROUND_MODE); });
+    }
+
+   virtual void subtractAssign (const NumberHolder& rhs) override
+    {
+      const mpfr_NumberHolder& RHS = NumberHolder_cast<mpfr_NumberHolder>(rhs);
+      inPlace(std::max(precision, RHS.precision), [&RHS](mpfr_ptr result, mpfr_srcptr src) { mpfr_sub(result, src, RHS.value, ROUND_MODE); });
+    }
+
+   virtual void multiplyAssign (const NumberHolder& rhs) override
+    {
+      const mpfr_NumberHolder& RHS = NumberHolder_cast<mpfr_NumberHolder>(rhs);
+      inPlace(std::min(precision + RHS.precision, std::max(std::max(precision, RHS.precision), PRECISION)),
+         [&RHS](mpfr_ptr result, mpfr_srcptr src) { mpfr_mul(result, src, RHS.value, ROUND_MODE); });
+    }
+
+   virtual void divideAssign (const NumberHolder& rhs) override
+    {
+      const mpfr_NumberHolder& RHS = NumberHolder_cast<mpfr_NumberHolder>(rhs);
+      inPlace(PRECISION, [&RHS](mpfr_ptr result, mpfr_srcptr src) { mpfr_div(result, src, RHS.value, ROUND_MODE); });
+    }
+
+   virtual void fusedMultiplyAdd (const NumberHolder& lhs, const NumberHolder& rhs) override
+    {
+      const mpfr_NumberHolder& LHS = NumberHolder_cast<mpfr_NumberHolder>(lhs);
+      const mpfr_NumberHolder& RHS = NumberHolder_cast<mpfr_NumberHolder>(rhs);
+         // At the precision that multiply then add would give.
+      inPlace(std::max(precision, std::min(LHS.precision + RHS.precision, std::max(std::max(LHS.precision, RHS.precision), PRECISION))),
+         [&LHS, &RHS](mpfr_ptr result, mpfr_srcptr src) { mpfr_fma(result, LHS.value, RHS.value, src, ROUND_MODE); });
+    }
+
  };
 
 
@@ -316,6 +419,16 @@ std::shared_ptr<NumberHolder> mpfr_NumberSystem::fromInt(size_t src) const
    return std::make_shared<mpfr_NumberHolder>(static_cast<double>(src));
  }
 
+NumberSystem_System mpfr_NumberSystem::getSystem() const
+ {
+   return MPFR_NUMBER_SYSTEM;
+ }
+
+std::shared_ptr<NumberHolder> mpfr_NumberSystem::deserialize(const char* src, size_t length) const
+ {
+   return mpfr_NumberHolder::deserialize(src, length);
+ }
+
 
 void mpfr_NumberSystem::setRoundMode(NumberSystem_Round_Mode mode)
  {
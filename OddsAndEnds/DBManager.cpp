@@ -33,6 +33,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <memory>
 #include <map>
 #include <list>
+#include <set>
 #include <string>
 
 #include <sqlite3.h>
@@ -45,9 +46,21 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 class DBManagerImpl
  {
 public:
-   DBManagerImpl() : workingSpreadSheet(nullptr), workingGS(nullptr) { }
+   DBManagerImpl() : workingSpreadSheet(nullptr), workingGS(nullptr), hits(0U), prepares(0U), steps(0U) { }
    ~DBManagerImpl()
     {
+         // The sheets may still reference the statements, but they had better not use them.
+      for (auto& db : statements)
+       {
+         for (auto& messi : db.second)
+          {
+            sqlite3_finalize(messi.second);
+          }
+       }
+      for (auto messi : temporaries)
+       {
+         sqlite3_finalize(messi);
+       }
       for (auto db : dbs)
        {
          sqlite3_close(db);
@@ -61,6 +74,14 @@ public:
    std::string sheetName;
    Forwards::Engine::SpreadSheetHolder* workingSpreadSheet;
    WidthGetterSetter* workingGS;
+
+   std::map<sqlite3*, std::map<std::string, sqlite3_stmt*> > statements;
+   std::map<sqlite3_stmt*, bool> busy;
+   std::set<sqlite3_stmt*> temporaries; // Prepared because the cached one was in use (reentrancy).
+
+   size_t hits;
+   size_t prepares;
+   size_t steps;
  };
 
 
@@ -131,3 +152,79 @@ void DBManager::attach(const std::string& sheetName, std::unique_ptr<Forwards::E
       impl->workingGS = impl->getterSetters[sheetName].get();
     }
  }
+
+void* DBManager::prepare(void* handel, const std::string& query)
+ {
+   sqlite3* db = reinterpret_cast<sqlite3*>(handel);
+   std::map<std::string, sqlite3_stmt*>& cache = impl->statements[db];
+
+   sqlite3_stmt *messi = nullptr;
+   std::map<std::string, sqlite3_stmt*>::iterator iter = cache.find(query);
+   if (cache.end() != iter)
+    {
+      if (false == impl->busy[iter->second])
+       {
+         ++impl->hits;
+         impl->busy[iter->second] = true;
+         return iter->second;
+       }
+
+         // Someone further up the stack is using it: give them a private one.
+      ++impl->prepares;
+      if (SQLITE_OK != sqlite3_prepare_v2(db, query.c_str(), query.length() + 1U, &messi, nullptr))
+       {
+         sqlite3_finalize(messi);
+         return nullptr;
+       }
+      impl->temporaries.insert(messi);
+      return messi;
+    }
+
+   ++impl->prepares;
+   if (SQLITE_OK != sqlite3_prepare_v2(db, query.c_str(), query.length() + 1U, &messi, nullptr))
+    {
+      sqlite3_finalize(messi);
+      return nullptr;
+    }
+   cache.insert(std::make_pair(query, messi));
+   impl->busy[messi] = true;
+   return messi;
+ }
+
+int DBManager::step(void* statement)
+ {
+   ++impl->steps;
+   return sqlite3_step(reinterpret_cast<sqlite3_stmt*>(statement));
+ }
+
+void DBManager::release(void* statement)
+ {
+   sqlite3_stmt *messi = reinterpret_cast<sqlite3_stmt*>(statement);
+   if (nullptr == messi)
+    {
+      return;
+    }
+
+   std::set<sqlite3_stmt*>::iterator iter = impl->temporaries.find(messi);
+   if (impl->temporaries.end() != iter)
+    {
+      impl->temporaries.erase(iter);
+      sqlite3_finalize(messi);
+      return;
+    }
+
+   sqlite3_reset(messi);
+   sqlite3_clear_bindings(messi);
+   impl->busy[messi] = false;
+ }
+
+std::string DBManager::getStatistics() const
+ {
+   size_t cached = 0U;
+   for (const auto& db : impl->statements)
+    {
+      cached += db.second.size();
+    }
+   return "Statements cached: " + std::to_string(cached) + ", hits: " + std::to_string(impl->hits) +
+      ", prepares: " + std::to_string(impl->prepares) + ", steps: " + std::to_string(impl->steps);
+ }
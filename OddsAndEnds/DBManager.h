@@ -65,6 +65,14 @@ public:
 
    void attachDB(void*);
    void attach(const std::string&, std::unique_ptr<Forwards::Engine::SpreadSheetHolder>&&, std::unique_ptr<WidthGetterSetter>&&);
+
+      // Prepared statements are cached per connection: prepare returns a statement ready for binding (or nullptr on error),
+      // and release makes it available for the next prepare of the same query. Don't finalize these.
+   void* prepare(void* handel, const std::string& query);
+   int step(void* statement);
+   void release(void* statement);
+
+   std::string getStatistics() const;
  };
 
 #endif /* DBMANAGER_H */
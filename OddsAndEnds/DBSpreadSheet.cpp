@@ -34,89 +34,136 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "DBManager.h"
 
-#include "Backwards/Input/StringInput.h"
-
 #include "Forwards/Engine/CallingContext.h"
 #include "Forwards/Engine/Expression.h"
 
-#include "Forwards/Parser/Parser.h"
+#include "Forwards/Parser/ParseCache.h"
 #include "Forwards/Parser/StringLogger.h"
 
 #include "Forwards/Types/ValueType.h"
+#include "Forwards/Types/Serialization.h"
 
 #include <sqlite3.h>
+#include <iterator>
+#include <vector>
+
+static const size_t STASH_BATCH = 1024U; // How many results we hold before writing them out.
+static const size_t DEFAULT_CACHE_BUDGET = 65536U;
+
+DBSpreadSheet::DBSpreadSheet(void *db, void *td, DBManager* mgr) : db(db), td(td), mgr(mgr), cacheGeneration(0U), cacheBudget(DEFAULT_CACHE_BUDGET), batchDepth(0U), resident(false)
+ {
+ }
+
+size_t makeCellId(size_t col, size_t row)
+ {
+   return ((col << 44U) | row);
+ }
 
-DBSpreadSheet::DBSpreadSheet(void *db, void *td, DBManager* mgr) : db(db), td(td), mgr(mgr)
+static std::string columnBytes(sqlite3_stmt* messi, int column)
  {
+   const char* bytes = reinterpret_cast<const char*>(sqlite3_column_blob(messi, column));
+   if (nullptr == bytes)
+    {
+      return std::string();
+    }
+   return std::string(bytes, sqlite3_column_bytes(messi, column));
  }
 
 size_t DBSpreadSheet::getMaxColumn()
  {
-   sqlite3_stmt *messi;
-   int errorCode = sqlite3_prepare_v2(reinterpret_cast<sqlite3*>(db), "SELECT MAX(col) FROM sheet;", 28U, &messi, nullptr);
+   sqlite3_stmt *messi = reinterpret_cast<sqlite3_stmt*>(mgr->prepare(db, "SELECT MAX(col) FROM sheet;"));
 
-   if (SQLITE_OK != errorCode)
+   if (nullptr == messi)
     {
       return 0U;
     }
 
    int col = 0U;
-   if (SQLITE_ROW == sqlite3_step(messi))
+   if (SQLITE_ROW == mgr->step(messi))
     {
       col = sqlite3_column_int(messi, 0);
     }
 
-   sqlite3_finalize(messi);
+   mgr->release(messi);
    return col + 1U;
  }
 
 size_t DBSpreadSheet::getMaxRow()
  {
-   sqlite3_stmt *messi;
-   int errorCode = sqlite3_prepare_v2(reinterpret_cast<sqlite3*>(db), "SELECT MAX(row) FROM sheet;", 28U, &messi, nullptr);
+   sqlite3_stmt *messi = reinterpret_cast<sqlite3_stmt*>(mgr->prepare(db, "SELECT MAX(row) FROM sheet;"));
 
-   if (SQLITE_OK != errorCode)
+   if (nullptr == messi)
     {
       return 0U;
     }
 
    int row = 0U;
-   if (SQLITE_ROW == sqlite3_step(messi))
+   if (SQLITE_ROW == mgr->step(messi))
     {
       row = sqlite3_column_int(messi, 0);
     }
 
-   sqlite3_finalize(messi);
+   mgr->release(messi);
    return row + 1U;
  }
 
 size_t DBSpreadSheet::getMaxRowForColumn(size_t col)
  {
-   sqlite3_stmt *messi;
-   int errorCode = sqlite3_prepare_v2(reinterpret_cast<sqlite3*>(db), "SELECT MAX(row) FROM sheet WHERE col = :col;", 45U, &messi, nullptr);
+   sqlite3_stmt *messi = reinterpret_cast<sqlite3_stmt*>(mgr->prepare(db, "SELECT MAX(row) FROM sheet WHERE col = :col;"));
 
-   if (SQLITE_OK != errorCode)
+   if (nullptr == messi)
     {
       return 0U;
     }
 
    int row = 0U;
    sqlite3_bind_int(messi, 1, col);
-   if (SQLITE_ROW == sqlite3_step(messi))
+   if (SQLITE_ROW == mgr->step(messi))
     {
       row = sqlite3_column_int(messi, 0);
     }
 
-   sqlite3_finalize(messi);
+   mgr->release(messi);
    return row + 1U;
  }
 
+static Forwards::Engine::Cell* makeCell(size_t col, size_t row, int type, const std::string& text)
+ {
+   Forwards::Engine::Cell* cell = new Forwards::Engine::Cell(col, row);
+   if (1 == type)
+    {
+      cell->type = Forwards::Engine::LABEL;
+    }
+   else if (2 == type)
+    {
+      cell->type = Forwards::Engine::VALUE;
+    }
+   cell->currentInput = text;
+   return cell;
+ }
+
+   // Recreate the stashed result of the last run.
+   // Results that can't be decoded (say, the number system changed) are recomputed.
+void DBSpreadSheet::loadPrevious(Forwards::Engine::Cell* cell, const std::string& bytes)
+ {
+   cell->previousValue = Forwards::Types::deserialize(bytes);
+ }
+
+void DBSpreadSheet::parseInput(Forwards::Engine::Cell* cell)
+ {
+   Forwards::Parser::StringLogger newLogger;
+   cell->value = parsed.parse(cell->currentInput, *mgr->context->map, newLogger, cell->col, cell->row);
+   if (nullptr != cell->value.get())
+    {
+      cell->currentInput = "";
+    }
+ }
+
 Forwards::Engine::Cell* DBSpreadSheet::getCellAtRaw(size_t col, size_t row)
  {
-   sqlite3_stmt *messi;
-   int errorCode = sqlite3_prepare_v2(reinterpret_cast<sqlite3*>(db), "SELECT * FROM sheet WHERE col = :col AND row = :row;", 53U, &messi, nullptr);
+   sqlite3_stmt *messi = reinterpret_cast<sqlite3_stmt*>(mgr->prepare(db, "SELECT * FROM sheet WHERE col = :col AND row = :row;"));
 
-   if (SQLITE_OK != errorCode)
+   if (nullptr == messi)
     {
       return nullptr;
     }
@@ -124,88 +171,117 @@ Forwards::Engine::Cell* DBSpreadSheet::getCellAtRaw(size_t col, size_t row)
    Forwards::Engine::Cell* cell = nullptr;
    sqlite3_bind_int64(messi, 1, col);
    sqlite3_bind_int64(messi, 2, row);
-   if (SQLITE_ROW == sqlite3_step(messi))
+   if (SQLITE_ROW == mgr->step(messi))
     {
-      int type;
-      std::string text;
-
-      type = sqlite3_column_int(messi, 2);
-      text = reinterpret_cast<const char*>(sqlite3_column_text(messi, 3));
-
-      cell = new Forwards::Engine::Cell(col, row);
-      if (1 == type)
-       {
-         cell->type = Forwards::Engine::LABEL;
-       }
-      else if (2 == type)
-       {
-         cell->type = Forwards::Engine::VALUE;
-       }
-      cell->currentInput = text;
+      cell = makeCell(col, row, sqlite3_column_int(messi, 2), reinterpret_cast<const char*>(sqlite3_column_text(messi, 3)));
     }
 
-   sqlite3_finalize(messi);
+   mgr->release(messi);
 
    if (nullptr != cell)
     {
-      errorCode = sqlite3_prepare_v2(reinterpret_cast<sqlite3*>(td), "SELECT * FROM sheet WHERE col = :col AND row = :row;", 53U, &messi, nullptr);
-      if (SQLITE_OK == errorCode)
+      bool found = false;
+      std::string text;
+
+      auto stashed = pending.find(makeCellId(col, row));
+      if (pending.end() != stashed)
+       {
+         found = true;
+         cell->previousGeneration = stashed->second.first;
+         text = stashed->second.second;
+       }
+      else
        {
-         sqlite3_bind_int64(messi, 1, col);
-         sqlite3_bind_int64(messi, 2, row);
-         if (SQLITE_ROW == sqlite3_step(messi))
+         messi = reinterpret_cast<sqlite3_stmt*>(mgr->prepare(td, "SELECT * FROM sheet WHERE col = :col AND row = :row;"));
+         if (nullptr != messi)
           {
-            size_t generation;
-            std::string text;
-
-            generation = sqlite3_column_int64(messi, 2);
-            text = reinterpret_cast<const char*>(sqlite3_column_text(messi, 3));
-
-            cell->previousGeneration = generation;
+            sqlite3_bind_int64(messi, 1, col);
+            sqlite3_bind_int64(messi, 2, row);
+            if (SQLITE_ROW == mgr->step(messi))
              {
-               Backwards::Input::StringInput interlinked (text);
-               Forwards::Input::Lexer lexer (interlinked);
-               Forwards::Parser::StringLogger newLogger;
-               std::shared_ptr<Forwards::Engine::Expression> value = Forwards::Parser::Parser::ParseFullExpression(lexer, *mgr->context->map, newLogger, col, row);
-               if (nullptr != value.get()) // Should never happen
-                {
-                  Forwards::Engine::CellFrame newFrame (cell, col, row);
-                  try
-                   {
-                     mgr->context->pushCell(&newFrame);
-                     cell->previousValue = value->evaluate(*mgr->context);
-                     mgr->context->popCell();
-                   }
-                  catch (...)
-                   {
-                     mgr->context->popCell();
-                   }
-                }
+               found = true;
+               cell->previousGeneration = sqlite3_column_int64(messi, 2);
+               text = columnBytes(messi, 3);
              }
+
+            mgr->release(messi);
           }
+       }
 
-         sqlite3_finalize(messi);
+      if (true == found)
+       {
+         loadPrevious(cell, text);
        }
     }
 
    if ((nullptr != cell) && (nullptr != cell->previousValue.get()))
     {
-      Backwards::Input::StringInput interlinked (cell->currentInput);
-      Forwards::Input::Lexer lexer (interlinked);
-      Forwards::Parser::StringLogger newLogger;
-      cell->value = Forwards::Parser::Parser::ParseFullExpression(lexer, *mgr->context->map, newLogger, col, row);
-      if (nullptr != cell->value.get())
-       {
-         cell->currentInput = "";
-       }
+      parseInput(cell);
     }
 
    return cell;
  }
 
-size_t makeCellId(size_t col, size_t row)
+void DBSpreadSheet::preload()
  {
-   return ((col << 44U) | row);
+   sqlite3_stmt *messi = reinterpret_cast<sqlite3_stmt*>(mgr->prepare(db, "SELECT col, row, type, content FROM sheet;"));
+
+   if (nullptr == messi)
+    {
+      return;
+    }
+
+   while (SQLITE_ROW == mgr->step(messi))
+    {
+      size_t col = sqlite3_column_int64(messi, 0);
+      size_t row = sqlite3_column_int64(messi, 1);
+      size_t id = makeCellId(col, row);
+      auto needle = cellCache.find(id);
+      if ((cellCache.end() != needle) && (cacheGeneration != needle->second.generation))
+       {
+         forget(needle);
+         needle = cellCache.end();
+       }
+      if (cellCache.end() == needle)
+       {
+         CachedCell& entry = cellCache[id];
+         entry.cell.reset(makeCell(col, row, sqlite3_column_int(messi, 2), reinterpret_cast<const char*>(sqlite3_column_text(messi, 3))));
+         entry.refs = 0U;
+         entry.generation = cacheGeneration;
+         entry.aged = false;
+       }
+      else
+       {
+         pin(needle->second); // Resident cells are never evicted.
+       }
+    }
+   mgr->release(messi);
+   resident = true;
+   cellAge.clear();
+
+   messi = reinterpret_cast<sqlite3_stmt*>(mgr->prepare(td, "SELECT col, row, generation, content FROM sheet;"));
+   if (nullptr != messi)
+    {
+      while (SQLITE_ROW == mgr->step(messi))
+       {
+         auto needle = cellCache.find(makeCellId(sqlite3_column_int64(messi, 0), sqlite3_column_int64(messi, 1)));
+         if (cellCache.end() != needle)
+          {
+            needle->second.cell->previousGeneration = sqlite3_column_int64(messi, 2);
+            loadPrevious(needle->second.cell.get(), columnBytes(messi, 3));
+          }
+       }
+      mgr->release(messi);
+    }
+
+   for (const auto& entry : cellCache)
+    {
+      Forwards::Engine::Cell* cell = entry.second.cell.get();
+      if ((nullptr == cell->value.get()) && ((Forwards::Engine::VALUE == cell->type) || (nullptr != cell->previousValue.get())))
+       {
+         parseInput(cell);
+       }
+    }
  }
 
 Forwards::Engine::Cell* DBSpreadSheet::getCellAt(size_t col, size_t row, const std::string& sheet)
@@ -224,15 +300,29 @@ Forwards::Engine::Cell* DBSpreadSheet::getCellAt(size_t col, size_t row, const s
    auto needle = cellCache.find(id);
    if (cellCache.end() != needle)
     {
-      ++refs[needle->second.get()];
-      return needle->second.get();
+      if ((true == resident) || (cacheGeneration == needle->second.generation))
+       {
+         pin(needle->second);
+         ++needle->second.refs;
+         return needle->second.cell.get();
+       }
+      forget(needle);
+    }
+
+   if (true == resident)
+    {
+      return nullptr;
     }
 
    Forwards::Engine::Cell* cell = getCellAtRaw(col, row);
    if (nullptr != cell)
     {
-      cellCache[id] = std::unique_ptr<Forwards::Engine::Cell>(cell);
-      refs[cell] = 1U;
+      CachedCell& entry = cellCache[id];
+      entry.cell.reset(cell);
+      entry.refs = 1U;
+      entry.generation = cacheGeneration;
+      entry.aged = false;
+      evict();
     }
 
    return cell;
@@ -242,14 +332,23 @@ void DBSpreadSheet::returnCell(Forwards::Engine::Cell* cell)
  {
    if (nullptr != cell)
     {
-      auto needle = refs.find(cell);
-      if (refs.end() != needle)
+      auto needle = cellCache.find(makeCellId(cell->col, cell->row));
+      if ((cellCache.end() != needle) && (cell == needle->second.cell.get()))
        {
-         --needle->second;
-         if ((0U == needle->second) && (false == cell->evergreen))
+         if (0U != needle->second.refs)
           {
-            cellCache.erase(makeCellId(cell->col, cell->row));
-            refs.erase(cell);
+            --needle->second.refs;
+          }
+         retire(needle);
+         return;
+       }
+
+      auto orphan = orphans.find(cell);
+      if (orphans.end() != orphan)
+       {
+         if (0U == --orphan->second.refs)
+          {
+            orphans.erase(orphan); // It was cleared while in use, so it goes now.
           }
        }
       else
@@ -259,81 +358,298 @@ void DBSpreadSheet::returnCell(Forwards::Engine::Cell* cell)
     }
  }
 
+void DBSpreadSheet::pin(CachedCell& entry)
+ {
+   if (true == entry.aged)
+    {
+      cellAge.erase(entry.age);
+      entry.aged = false;
+    }
+ }
+
+   // If no one is using this cell, it may be evicted.
+void DBSpreadSheet::retire(CellCache::iterator iter)
+ {
+   CachedCell& entry = iter->second;
+   if ((0U != entry.refs) || (true == entry.cell->evergreen) || (true == resident) || (true == entry.aged))
+    {
+      return;
+    }
+   cellAge.push_front(iter->first);
+   entry.age = cellAge.begin();
+   entry.aged = true;
+   evict();
+ }
+
+   // Take a cell out of the cache. If someone is using it, it goes when they return it.
+void DBSpreadSheet::forget(CellCache::iterator iter)
+ {
+   pin(iter->second);
+   if (0U != iter->second.refs)
+    {
+      Forwards::Engine::Cell* cell = iter->second.cell.get();
+      orphans[cell] = std::move(iter->second);
+    }
+   cellCache.erase(iter);
+ }
+
+void DBSpreadSheet::evict()
+ {
+   while ((cellCache.size() > cacheBudget) && (false == cellAge.empty()))
+    {
+      cellCache.erase(cellAge.back());
+      cellAge.pop_back();
+    }
+ }
+
+void DBSpreadSheet::setCacheBudget(size_t cells)
+ {
+   cacheBudget = cells;
+   evict();
+ }
+
 void DBSpreadSheet::initCellAt(size_t col, size_t row)
  {
-   sqlite3_stmt *messi;
-   int errorCode = sqlite3_prepare_v2(reinterpret_cast<sqlite3*>(db), "INSERT OR REPLACE INTO sheet VALUES (:col, :row, :type, :content);", 67U, &messi, nullptr);
+   sqlite3_stmt *messi = reinterpret_cast<sqlite3_stmt*>(mgr->prepare(db, "INSERT OR REPLACE INTO sheet VALUES (:col, :row, :type, :content);"));
 
-   if (SQLITE_OK == errorCode)
+   if (nullptr != messi)
     {
       sqlite3_bind_int64(messi, 1, col);
       sqlite3_bind_int64(messi, 2, row);
       sqlite3_bind_int(messi, 3, 0);
       sqlite3_bind_text(messi, 4, "", -1, nullptr);
-      sqlite3_step(messi);
-      sqlite3_finalize(messi);
+      mgr->step(messi);
+      mgr->release(messi);
+    }
+
+   size_t id = makeCellId(col, row);
+   auto needle = cellCache.find(id);
+   if (cellCache.end() != needle)
+    {
+      forget(needle);
+    }
+   if (true == resident)
+    {
+      CachedCell& entry = cellCache[id];
+      entry.cell = std::make_unique<Forwards::Engine::Cell>(col, row);
+      entry.refs = 0U;
+      entry.generation = cacheGeneration;
+      entry.aged = false;
     }
  }
 
 bool DBSpreadSheet::isCellPresent(size_t col, size_t row)
  {
+   auto needle = cellCache.find(makeCellId(col, row));
+   if ((cellCache.end() != needle) && ((true == resident) || (cacheGeneration == needle->second.generation)))
+    {
+      return true;
+    }
+   if (true == resident)
+    {
+      return false;
+    }
+
    Forwards::Engine::Cell* cell = getCellAtRaw(col, row);
    bool result = nullptr != cell;
    delete cell;
    return result;
  }
 
+   // Holds its statement until it is done: the manager will hand out another if someone needs the same query.
+class DBCursor final : public Forwards::Engine::CellCursor
+ {
+public:
+   DBManager *mgr;
+   void *messi; // Type-pun the statement.
+
+   DBCursor(DBManager* mgr, void* messi) : mgr(mgr), messi(messi) { }
+   ~DBCursor()
+    {
+      if (nullptr != messi)
+       {
+         mgr->release(messi);
+       }
+    }
+
+   virtual bool next(size_t& col, size_t& row) override
+    {
+      if (nullptr == messi)
+       {
+         return false;
+       }
+      if (SQLITE_ROW != mgr->step(messi))
+       {
+         mgr->release(messi);
+         messi = nullptr;
+         return false;
+       }
+      col = sqlite3_column_int64(reinterpret_cast<sqlite3_stmt*>(messi), 0);
+      row = sqlite3_column_int64(reinterpret_cast<sqlite3_stmt*>(messi), 1);
+      return true;
+    }
+ };
+
+std::unique_ptr<Forwards::Engine::CellCursor> DBSpreadSheet::getPresentCells(bool c_major, bool colsAscending, bool rowsAscending)
+ {
+   if (true == resident)
+    {
+      std::unique_ptr<Forwards::Engine::VectorCursor> result = std::make_unique<Forwards::Engine::VectorCursor>();
+      for (const auto& entry : cellCache)
+       {
+         result->cells.emplace_back(entry.second.cell->col, entry.second.cell->row);
+       }
+      result->sort(c_major, colsAscending, rowsAscending);
+      return result;
+    }
+
+   std::string cols = colsAscending ? "col ASC" : "col DESC";
+   std::string rows = rowsAscending ? "row ASC" : "row DESC";
+   std::string query = "SELECT col, row FROM sheet ORDER BY " + (c_major ? (cols + ", " + rows) : (rows + ", " + cols)) + ";";
+   return std::make_unique<DBCursor>(mgr, mgr->prepare(db, query));
+ }
+
+std::unique_ptr<Forwards::Engine::CellCursor> DBSpreadSheet::getPresentCellsIn(size_t col1, size_t row1, size_t col2, size_t row2)
+ {
+   if (true == resident)
+    {
+      std::unique_ptr<Forwards::Engine::VectorCursor> result = std::make_unique<Forwards::Engine::VectorCursor>();
+         // Look up each position if the range is smaller than the sheet, else scan the sheet.
+      size_t cols = col2 - col1 + 1U;
+      size_t rows = row2 - row1 + 1U;
+      if ((cols <= cellCache.size()) && (rows <= cellCache.size() / cols))
+       {
+         for (size_t col = col1; col <= col2; ++col)
+          {
+            for (size_t row = row1; row <= row2; ++row)
+             {
+               if (cellCache.end() != cellCache.find(makeCellId(col, row)))
+                {
+                  result->cells.emplace_back(col, row);
+                }
+             }
+          }
+       }
+      else
+       {
+         for (const auto& entry : cellCache)
+          {
+            const Forwards::Engine::Cell* cell = entry.second.cell.get();
+            if ((cell->col >= col1) && (cell->col <= col2) && (cell->row >= row1) && (cell->row <= row2))
+             {
+               result->cells.emplace_back(cell->col, cell->row);
+             }
+          }
+         result->sort(true, true, true);
+       }
+      return result;
+    }
+
+   sqlite3_stmt *messi = reinterpret_cast<sqlite3_stmt*>(mgr->prepare(db, "SELECT col, row FROM sheet WHERE col BETWEEN :col1 AND :col2 AND row BETWEEN :row1 AND :row2 ORDER BY col ASC, row ASC;"));
+   if (nullptr != messi)
+    {
+      sqlite3_bind_int64(messi, 1, col1);
+      sqlite3_bind_int64(messi, 2, col2);
+      sqlite3_bind_int64(messi, 3, row1);
+      sqlite3_bind_int64(messi, 4, row2);
+    }
+   return std::make_unique<DBCursor>(mgr, messi);
+ }
+
 void DBSpreadSheet::clearCellAt(size_t col, size_t row)
  {
-   sqlite3_stmt *messi;
-   int errorCode = sqlite3_prepare_v2(reinterpret_cast<sqlite3*>(db), "DELETE FROM sheet WHERE col = :col AND row = :row;", 51U, &messi, nullptr);
+   sqlite3_stmt *messi = reinterpret_cast<sqlite3_stmt*>(mgr->prepare(db, "DELETE FROM sheet WHERE col = :col AND row = :row;"));
 
-   if (SQLITE_OK == errorCode)
+   if (nullptr != messi)
     {
       sqlite3_bind_int64(messi, 1, col);
       sqlite3_bind_int64(messi, 2, row);
-      sqlite3_step(messi);
-      sqlite3_finalize(messi);
+      mgr->step(messi);
+      mgr->release(messi);
+    }
+
+   auto needle = cellCache.find(makeCellId(col, row));
+   if (cellCache.end() != needle)
+    {
+      forget(needle);
     }
  }
 
 void DBSpreadSheet::clearColumn(size_t col)
  {
-   sqlite3_stmt *messi;
-   int errorCode = sqlite3_prepare_v2(reinterpret_cast<sqlite3*>(db), "DELETE FROM sheet WHERE col = :col;", 36U, &messi, nullptr);
+   sqlite3_stmt *messi = reinterpret_cast<sqlite3_stmt*>(mgr->prepare(db, "DELETE FROM sheet WHERE col = :col;"));
 
-   if (SQLITE_OK == errorCode)
+   if (nullptr != messi)
     {
       sqlite3_bind_int64(messi, 1, col);
-      sqlite3_step(messi);
-      sqlite3_finalize(messi);
+      mgr->step(messi);
+      mgr->release(messi);
+    }
+
+   if (true == resident)
+    {
+      forgetIf([col](const Forwards::Engine::Cell* cell) { return col == cell->col; });
+    }
+   else
+    {
+      ++cacheGeneration;
     }
  }
 
 void DBSpreadSheet::clearRow(size_t row)
  {
-   sqlite3_stmt *messi;
-   int errorCode = sqlite3_prepare_v2(reinterpret_cast<sqlite3*>(db), "DELETE FROM sheet WHERE row = :row;", 36U, &messi, nullptr);
+   sqlite3_stmt *messi = reinterpret_cast<sqlite3_stmt*>(mgr->prepare(db, "DELETE FROM sheet WHERE row = :row;"));
 
-   if (SQLITE_OK == errorCode)
+   if (nullptr != messi)
     {
       sqlite3_bind_int64(messi, 1, row);
-      sqlite3_step(messi);
-      sqlite3_finalize(messi);
+      mgr->step(messi);
+      mgr->release(messi);
+    }
+
+   if (true == resident)
+    {
+      forgetIf([row](const Forwards::Engine::Cell* cell) { return row == cell->row; });
+    }
+   else
+    {
+      ++cacheGeneration;
+    }
+ }
+
+   // The resident store has to be exact, so look at everything.
+void DBSpreadSheet::forgetIf(const std::function<bool(const Forwards::Engine::Cell*)>& predicate)
+ {
+   std::vector<size_t> doomed;
+   for (const auto& entry : cellCache)
+    {
+      if (true == predicate(entry.second.cell.get()))
+       {
+         doomed.push_back(entry.first);
+       }
+    }
+   for (size_t id : doomed)
+    {
+      forget(cellCache.find(id));
     }
  }
 
 void DBSpreadSheet::makeEvergreen(Forwards::Engine::Cell* cell)
  {
    cell->evergreen = true;
+
+   auto needle = cellCache.find(makeCellId(cell->col, cell->row));
+   if ((cellCache.end() != needle) && (cell == needle->second.cell.get()))
+    {
+      pin(needle->second);
+    }
  }
 
 void DBSpreadSheet::commitCell(Forwards::Engine::Cell* cell)
  {
-   cell->evergreen = false;
+   cell->evergreen = false; // Done editing it: what's in memory is what's written below.
 
-   sqlite3_stmt *messi;
-   int errorCode = sqlite3_prepare_v2(reinterpret_cast<sqlite3*>(db), "INSERT OR REPLACE INTO sheet VALUES (:col, :row, :type, :content);", 67U, &messi, nullptr);
+   sqlite3_stmt *messi = reinterpret_cast<sqlite3_stmt*>(mgr->prepare(db, "INSERT OR REPLACE INTO sheet VALUES (:col, :row, :type, :content);"));
 
    std::string content;
    int type = 0;
@@ -362,39 +678,126 @@ void DBSpreadSheet::commitCell(Forwards::Engine::Cell* cell)
        }
     }
 
-   if (SQLITE_OK == errorCode)
+   if (nullptr != messi)
     {
       sqlite3_bind_int64(messi, 1, cell->col);
       sqlite3_bind_int64(messi, 2, cell->row);
       sqlite3_bind_int(messi, 3, type);
       sqlite3_bind_text(messi, 4, content.c_str(), -1, nullptr);
-      sqlite3_step(messi);
-      sqlite3_finalize(messi);
+      mgr->step(messi);
+      mgr->release(messi);
+    }
+
+   auto needle = cellCache.find(makeCellId(cell->col, cell->row));
+   if ((cellCache.end() != needle) && (cell == needle->second.cell.get()))
+    {
+      retire(needle);
     }
  }
 
+   // The edit was abandoned, so the cell in memory no longer matches the sheet: the next fetch reads it again.
+   // Resident sheets never read cells again, so put a fresh copy of the cell in its place.
 void DBSpreadSheet::dispose(Forwards::Engine::Cell* cell)
  {
    cell->evergreen = false;
+
+   size_t col = cell->col;
+   size_t row = cell->row;
+   size_t id = makeCellId(col, row);
+   auto needle = cellCache.find(id);
+   if ((cellCache.end() != needle) && (cell == needle->second.cell.get()))
+    {
+      forget(needle); // This may delete the cell.
+
+      if (true == resident)
+       {
+         Forwards::Engine::Cell* fresh = getCellAtRaw(col, row);
+         if (nullptr != fresh)
+          {
+            CachedCell& entry = cellCache[id];
+            entry.cell.reset(fresh);
+            entry.refs = 0U;
+            entry.generation = cacheGeneration;
+            entry.aged = false;
+
+            if ((nullptr == fresh->value.get()) && (Forwards::Engine::VALUE == fresh->type))
+             {
+               parseInput(fresh);
+             }
+          }
+       }
+    }
  }
 
 void DBSpreadSheet::stashResult(Forwards::Engine::Cell* cell, size_t generation)
  {
-   sqlite3_stmt *messi;
-   int errorCode = sqlite3_prepare_v2(reinterpret_cast<sqlite3*>(td), "INSERT OR REPLACE INTO sheet VALUES (:col, :row, :generation, :content);", 73U, &messi, nullptr);
-
    std::string content;
    if (nullptr != cell->previousValue.get())
     {
-      content = cell->previousValue->toString(cell->col, cell->row, true);
+      content = Forwards::Types::serialize(*cell->previousValue);
     }
-   if (SQLITE_OK == errorCode)
+   pending[makeCellId(cell->col, cell->row)] = std::make_pair(generation, content);
+
+   if ((0U == batchDepth) || (pending.size() >= STASH_BATCH))
     {
-      sqlite3_bind_int64(messi, 1, cell->col);
-      sqlite3_bind_int64(messi, 2, cell->row);
-      sqlite3_bind_int64(messi, 3, generation);
-      sqlite3_bind_text(messi, 4, content.c_str(), -1, nullptr);
-      sqlite3_step(messi);
-      sqlite3_finalize(messi);
+      flush();
+    }
+ }
+
+void DBSpreadSheet::flush()
+ {
+   sqlite3_stmt *messi = reinterpret_cast<sqlite3_stmt*>(mgr->prepare(td, "INSERT OR REPLACE INTO sheet VALUES (:col, :row, :generation, :content);"));
+
+   if (nullptr != messi)
+    {
+      for (const auto& result : pending)
+       {
+         sqlite3_bind_int64(messi, 1, result.first >> 44U);
+         sqlite3_bind_int64(messi, 2, result.first & ((static_cast<size_t>(1U) << 44U) - 1U));
+         sqlite3_bind_int64(messi, 3, result.second.first);
+         sqlite3_bind_blob(messi, 4, result.second.second.data(), result.second.second.size(), nullptr);
+         mgr->step(messi);
+         sqlite3_reset(messi);
+       }
+      mgr->release(messi);
+    }
+   pending.clear();
+ }
+
+   // One transaction on each database for the whole recalc, instead of one per cell.
+void DBSpreadSheet::beginBatch()
+ {
+   if (0U != batchDepth++)
+    {
+      return;
+    }
+
+   for (void* handel : { db, td })
+    {
+      sqlite3_stmt *messi = reinterpret_cast<sqlite3_stmt*>(mgr->prepare(handel, "BEGIN;"));
+      if (nullptr != messi)
+       {
+         mgr->step(messi);
+         mgr->release(messi);
+       }
+    }
+ }
+
+void DBSpreadSheet::endBatch()
+ {
+   if (0U != --batchDepth)
+    {
+      return;
+    }
+
+   flush();
+   for (void* handel : { db, td })
+    {
+      sqlite3_stmt *messi = reinterpret_cast<sqlite3_stmt*>(mgr->prepare(handel, "COMMIT;"));
+      if (nullptr != messi)
+       {
+         mgr->step(messi);
+         mgr->release(messi);
+       }
     }
  }
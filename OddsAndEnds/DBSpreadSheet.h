@@ -33,9 +33,15 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define DBSPREADSHEET_H
 
 #include <map>
+#include <list>
+#include <unordered_map>
 #include <memory>
+#include <string>
+#include <utility>
+#include <functional>
 
 #include "Forwards/Engine/SpreadSheet.h"
+#include "Forwards/Parser/ParseCache.h"
 
 namespace Forwards
  {
@@ -68,6 +74,8 @@ public:
    Forwards::Engine::Cell* getCellAtRaw(size_t col, size_t row);
    virtual void returnCell(Forwards::Engine::Cell* cell) override;
    virtual bool isCellPresent(size_t col, size_t row) override;
+   virtual std::unique_ptr<Forwards::Engine::CellCursor> getPresentCells(bool c_major, bool colsAscending, bool rowsAscending) override;
+   virtual std::unique_ptr<Forwards::Engine::CellCursor> getPresentCellsIn(size_t col1, size_t row1, size_t col2, size_t row2) override;
 
    virtual void clearCellAt(size_t col, size_t row) override;
    virtual void clearColumn(size_t col) override;
@@ -79,9 +87,52 @@ public:
 
    virtual void stashResult(Forwards::Engine::Cell* cell, size_t generation) override;
 
+   virtual void beginBatch() override;
+   virtual void endBatch() override;
+
+      // Read the whole sheet into memory in one pass. After this, cells are only read from memory; changes still write through.
+   void preload();
+
+      // The most cells to keep in memory that no one is using.
+   void setCacheBudget(size_t cells);
+
 private:
-   std::map<size_t, std::unique_ptr<Forwards::Engine::Cell> > cellCache;
-   std::map<Forwards::Engine::Cell*, size_t> refs;
+      // A cell is pinned while anyone holds it (or it is evergreen). Otherwise it is aged, and may be evicted.
+   class CachedCell
+    {
+   public:
+      std::unique_ptr<Forwards::Engine::Cell> cell;
+      size_t refs;
+      size_t generation;
+      bool aged;
+      std::list<size_t>::iterator age;
+    };
+   typedef std::unordered_map<size_t, CachedCell> CellCache;
+
+   CellCache cellCache;
+   std::list<size_t> cellAge; // Most recently returned first.
+   std::unordered_map<Forwards::Engine::Cell*, CachedCell> orphans; // Cleared while in use.
+   size_t cacheGeneration; // Bumped to throw out everything that's cached without touching it.
+   size_t cacheBudget;
+
+   void pin(CachedCell& entry);
+   void retire(CellCache::iterator iter);
+   void forget(CellCache::iterator iter);
+   void evict();
+   void forgetIf(const std::function<bool(const Forwards::Engine::Cell*)>& predicate);
+
+      // Stashed results (generation and content) that haven't been written yet.
+   std::map<size_t, std::pair<size_t, std::string> > pending;
+   size_t batchDepth;
+
+   void flush();
+
+   bool resident;
+
+   Forwards::Parser::ParseCache parsed; // Shared by every cell with the same relative formula.
+
+   void loadPrevious(Forwards::Engine::Cell* cell, const std::string& bytes);
+   void parseInput(Forwards::Engine::Cell* cell);
  };
 
 #endif /* DBSPREADSHEET_H */
@@ -30,6 +30,8 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #include <vector>
+#include <memory>
+#include <string>
 #include <map>
 #include <set>
 #include <limits>
@@ -37,6 +39,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <algorithm>
 
 #include "GetAndSet.h"
+#include "DBManager.h"
 
 #include <sqlite3.h>
 
@@ -96,22 +99,21 @@ int DBWidthGS::getWidth(size_t col)
       return thing->second;
     }
 
-   sqlite3_stmt *messi;
-   int errorCode = sqlite3_prepare_v2(reinterpret_cast<sqlite3*>(db), "SELECT * FROM widths WHERE col = :col;", 39U, &messi, nullptr);
+   sqlite3_stmt *messi = reinterpret_cast<sqlite3_stmt*>(mgr->prepare(db, "SELECT * FROM widths WHERE col = :col;"));
 
-   if (SQLITE_OK != errorCode)
+   if (nullptr == messi)
     {
       return defWidth;
     }
 
    int width = defWidth;
    sqlite3_bind_int(messi, 1, col);
-   if (SQLITE_ROW == sqlite3_step(messi))
+   if (SQLITE_ROW == mgr->step(messi))
     {
       width = sqlite3_column_int(messi, 1);
     }
 
-   sqlite3_finalize(messi);
+   mgr->release(messi);
 
    cache[col] = width;
    lru[col] = ++access;
@@ -131,15 +133,14 @@ void DBWidthGS::setWidth(size_t col, int width)
  {
    if ((width >= MIN_COLUMN_WIDTH) && (width <= MAX_COLUMN_WIDTH))
     {
-      sqlite3_stmt *messi;
-      int errorCode = sqlite3_prepare_v2(reinterpret_cast<sqlite3*>(db), "INSERT OR REPLACE INTO widths VALUES (:col, :width);", 53U, &messi, nullptr);
+      sqlite3_stmt *messi = reinterpret_cast<sqlite3_stmt*>(mgr->prepare(db, "INSERT OR REPLACE INTO widths VALUES (:col, :width);"));
 
-      if (SQLITE_OK == errorCode)
+      if (nullptr != messi)
        {
          sqlite3_bind_int(messi, 1, col);
          sqlite3_bind_int(messi, 2, width);
-         sqlite3_step(messi);
-         sqlite3_finalize(messi);
+         mgr->step(messi);
+         mgr->release(messi);
        }
 
       auto thing = cache.find(col);
@@ -162,15 +163,14 @@ void DBWidthGS::decWidth(size_t col)
 
 void DBWidthGS::precache()
  {
-   sqlite3_stmt *messi;
-   int errorCode = sqlite3_prepare_v2(reinterpret_cast<sqlite3*>(db), "SELECT * FROM widths;", 22U, &messi, nullptr);
+   sqlite3_stmt *messi = reinterpret_cast<sqlite3_stmt*>(mgr->prepare(db, "SELECT * FROM widths;"));
 
-   if (SQLITE_OK != errorCode)
+   if (nullptr == messi)
     {
       return;
     }
 
-   while (SQLITE_ROW == sqlite3_step(messi))
+   while (SQLITE_ROW == mgr->step(messi))
     {
       int col;
       int width;
@@ -182,5 +182,5 @@ void DBWidthGS::precache()
       lru[col] = access;
     }
 
-   sqlite3_finalize(messi);
+   mgr->release(messi);
  }
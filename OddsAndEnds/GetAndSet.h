@@ -36,6 +36,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define MIN_COLUMN_WIDTH 1
 #define DEF_COLUMN_WIDTH 9
 
+class DBManager;
+
 class WidthGetterSetter
  {
 protected:
@@ -69,11 +71,12 @@ class DBWidthGS final : public WidthGetterSetter
  {
 private:
    void *db; // Don't tell the compiler this is a sqlite3* : DBManager owns this object
+   DBManager *mgr;
    std::map<size_t, size_t> lru;
    std::map<size_t, int> cache;
    size_t access;
 public:
-   DBWidthGS(int defWidth, void *db) : WidthGetterSetter(defWidth), db(db), access(0U) { }
+   DBWidthGS(int defWidth, void *db, DBManager *mgr) : WidthGetterSetter(defWidth), db(db), mgr(mgr), access(0U) { }
 
    virtual int getWidth(size_t col) override;
    virtual void setWidth(size_t col, int width) override;
@@ -46,6 +46,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "Backwards/Engine/Statement.h"
 
 #include "Forwards/Engine/CallingContext.h"
+#include "Forwards/Engine/SpreadSheet.h"
 #include "Forwards/Parser/ContextBuilder.h"
 #include "Forwards/Parser/Parser.h"
 #include "Forwards/Parser/StringLogger.h"
@@ -111,6 +112,7 @@ void LoadLibraries (const std::vector<std::pair<std::string, std::string> >& all
    Forwards::Parser::ContextBuilder::createGlobalScope(*context.globalScope); // Create the global scope before the table.
    Backwards::Parser::GetterSetter gs;
    Backwards::Parser::SymbolTable table (gs, *context.globalScope);
+   table.compile = context.theSheet->compiled;
 
          // We assume that this cannot fail.
     {
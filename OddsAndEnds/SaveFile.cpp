@@ -291,14 +291,14 @@ void LoadFile(const std::string& fileName, DBManager& manager, std::vector<std::
     }
 
    std::unique_ptr<DBSpreadSheet> sheet = std::make_unique<DBSpreadSheet>(reinterpret_cast<void*>(handel), reinterpret_cast<void*>(ohandel), &manager);
-   std::unique_ptr<DBWidthGS> getterSetter = std::make_unique<DBWidthGS>(DEF_COLUMN_WIDTH, reinterpret_cast<void*>(handel));
+   std::unique_ptr<DBWidthGS> getterSetter = std::make_unique<DBWidthGS>(DEF_COLUMN_WIDTH, reinterpret_cast<void*>(handel), &manager);
    getterSetter->precache();
    manager.attachDB(reinterpret_cast<void*>(handel));
    manager.attachDB(reinterpret_cast<void*>(ohandel));
    manager.attach("", std::move(sheet), std::move(getterSetter));
  }
 
-void AttachDB(const std::string& fileName, DBManager& manager)
+void AttachDB(const std::string& fileName, DBManager& manager, size_t pageBudget)
  {
    sqlite3 *handel;
    int errorCode;
@@ -312,7 +312,11 @@ void AttachDB(const std::string& fileName, DBManager& manager)
 
    manager.attachDB(reinterpret_cast<void*>(handel));
     {
-      std::unique_ptr<TableView> sheet = std::make_unique<TableView>("sqlite_schema", reinterpret_cast<void*>(handel));
+      std::unique_ptr<TableView> sheet = std::make_unique<TableView>("sqlite_schema", reinterpret_cast<void*>(handel), &manager);
+      if (0U != pageBudget)
+       {
+         sheet->setPageBudget(pageBudget);
+       }
       std::unique_ptr<MemoryWidthGS> getterSetter = std::make_unique<MemoryWidthGS>(DEF_COLUMN_WIDTH);
       manager.attach("sqlite_schema", std::move(sheet), std::move(getterSetter));
     }
@@ -331,7 +335,11 @@ void AttachDB(const std::string& fileName, DBManager& manager)
       std::string name;
       name = reinterpret_cast<const char*>(sqlite3_column_text(messi, 0));
 
-      std::unique_ptr<TableView> sheet = std::make_unique<TableView>(name, reinterpret_cast<void*>(handel));
+      std::unique_ptr<TableView> sheet = std::make_unique<TableView>(name, reinterpret_cast<void*>(handel), &manager);
+      if (0U != pageBudget)
+       {
+         sheet->setPageBudget(pageBudget);
+       }
       std::unique_ptr<MemoryWidthGS> getterSetter = std::make_unique<MemoryWidthGS>(DEF_COLUMN_WIDTH);
 
       manager.attach(name, std::move(sheet), std::move(getterSetter));
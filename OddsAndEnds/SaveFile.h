@@ -34,6 +34,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 void LoadFile(const std::string& fileName, DBManager& manager, std::vector<std::pair<std::string, std::string> >& allLibs,
    const std::vector<std::pair<std::string, std::string> >& addLibs);
-void AttachDB(const std::string& fileName, DBManager& manager);
+   // The page budget is in bytes for each table, or zero for the default.
+void AttachDB(const std::string& fileName, DBManager& manager, size_t pageBudget);
 
 #endif /* SAVEFILE_H */
@@ -32,102 +32,6 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 extern const char* const STDLIB =
 
-"set MAX to function (x) is "
-   "set result to 'Empty' "
-   "set found to 0 "
-   "for item in x do "
-      "set temp to item "
-      "if IsCellRef(item) then "
-         "set temp to EvalCell(item) "
-      "end "
-      "if IsFloat(temp) then "
-         "if found then "
-            "set result to Max(result; temp) "
-         "else "
-            "set result to temp "
-            "set found to 1 "
-         "end "
-      "elseif IsCellRange(temp) then "
-         "set temp to MAX(temp) "
-         "if !IsString(temp) then "
-            "if found then "
-               "set result to Max(result; temp) "
-            "else "
-               "set result to temp "
-               "set found to 1 "
-            "end "
-         "end "
-      "end "
-   "end "
-   "return result "
-"end "
-
-"set MIN to function (x) is "
-   "set result to 'Empty' "
-   "set found to 0 "
-   "for item in x do "
-      "set temp to item "
-      "if IsCellRef(item) then "
-         "set temp to EvalCell(item) "
-      "end "
-      "if IsFloat(temp) then "
-         "if found then "
-            "set result to Min(result; temp) "
-         "else "
-            "set result to temp "
-            "set found to 1 "
-         "end "
-      "elseif IsCellRange(temp) then "
-         "set temp to MIN(temp) "
-         "if !IsString(temp) then "
-            "if found then "
-               "set result to Min(result; temp) "
-            "else "
-               "set result to temp "
-               "set found to 1 "
-            "end "
-         "end "
-      "end "
-   "end "
-   "return result "
-"end "
-
-"set SUM to function (x) is "
-   "set result to 0 "
-   "for item in x do "
-      "set temp to item "
-      "if IsCellRef(item) then "
-         "set temp to EvalCell(item) "
-      "end "
-      "if IsFloat(temp) then "
-         "set result to result + temp "
-      "elseif IsCellRange(temp) then "
-         "set result to result + SUM(temp) "
-      "end "
-   "end "
-   "return result "
-"end "
-
-"set COUNT to function (x) is "
-   "set result to 0 "
-   "for item in x do "
-      "set temp to item "
-      "if IsCellRef(item) then "
-         "set temp to EvalCell(item) "
-      "end "
-      "if IsFloat(temp) then "
-         "set result to result + 1 "
-      "elseif IsCellRange(temp) then "
-         "set result to result + COUNT(temp) "
-      "end "
-   "end "
-   "return result "
-"end "
-
-"set AVERAGE to function (x) is "
-   "return SUM(x) / COUNT(x) "
-"end "
-
 "set NAN to function (x) is "
    "return NaN() "
 "end "
@@ -30,6 +30,7 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #include "TableView.h"
+#include "DBManager.h"
 #include "Forwards/Engine/Cell.h"
 
 #include "Forwards/Engine/Expression.h"
@@ -40,13 +41,58 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <sqlite3.h>
 #include <limits>
-#include <numeric>
 #include <algorithm>
+#include <cstring>
 
-TableView::TableView(const std::string& sheetName, void *db) : sheetName(sheetName), db(db), rows(~0U), cols(~0U), last(0U)
+static const size_t maxCacheSize = 5000U;
+static const size_t ROWID_CHUNK = 4096U; // How many rowids we read at a time.
+static const size_t PAGE_ROWS = 256U; // How many rows we read at a time, and how many are between rowid or primary key checkpoints.
+static const size_t DEFAULT_PAGE_BUDGET = 64U * 1024U * 1024U;
+
+   // A page stores its values by column: the type of each value, its integer (or the bits of its double),
+   // and where its text ends. This keeps us from holding a Cell (and its friends) for every value we've read.
+class TableView::Page
+ {
+public:
+   class Column
+    {
+   public:
+      std::vector<unsigned char> types;
+      std::vector<int64_t> numbers;
+      std::vector<uint32_t> ends;
+      std::string text;
+    };
+
+   std::vector<Column> data;
+   size_t rows;
+
+   explicit Page(size_t cols) : data(cols), rows(0U) { }
+
+   size_t bytes() const
+    {
+      size_t result = sizeof(Page);
+      for (const Column& column : data)
+       {
+         result += sizeof(Column) + column.types.capacity() + column.numbers.capacity() * sizeof(int64_t) +
+            column.ends.capacity() * sizeof(uint32_t) + column.text.capacity();
+       }
+      return result;
+    }
+ };
+
+TableView::TableView(const std::string& sheetName, void *db, DBManager* mgr) : sheetName(sheetName), db(db), mgr(mgr), rows(~0U), cols(~0U),
+   mode(UNKNOWN), rowidsSeen(0U), rowidsLast(0), rowidsComplete(false), checkpointsComplete(false), pageBytes(0U), pageBudget(DEFAULT_PAGE_BUDGET)
  {
  }
 
+TableView::~TableView()
+ {
+   for (void* value : checkpoints)
+    {
+      sqlite3_value_free(reinterpret_cast<sqlite3_value*>(value));
+    }
+ }
+
 size_t TableView::getMaxColumn()
  {
    if (~0U != cols)
@@ -54,22 +100,21 @@ size_t TableView::getMaxColumn()
       return cols;
     }
 
-   sqlite3_stmt *messi;
    static const std::string query = "SELECT COUNT(name) FROM pragma_table_info(:sheet);";
-   int errorCode = sqlite3_prepare_v2(reinterpret_cast<sqlite3*>(db), query.c_str(), query.length() + 1U, &messi, nullptr);
+   sqlite3_stmt *messi = reinterpret_cast<sqlite3_stmt*>(mgr->prepare(db, query));
 
-   if (SQLITE_OK != errorCode)
+   if (nullptr == messi)
     {
       return 0U;
     }
 
    sqlite3_bind_text(messi, 1, sheetName.c_str(), -1, nullptr);
-   if (SQLITE_ROW == sqlite3_step(messi))
+   if (SQLITE_ROW == mgr->step(messi))
     {
       cols = sqlite3_column_int64(messi, 0);
     }
 
-   sqlite3_finalize(messi);
+   mgr->release(messi);
    return cols;
  }
 
@@ -80,22 +125,21 @@ size_t TableView::getMaxRow()
       return rows;
     }
 
-   sqlite3_stmt *messi;
    std::string query = "SELECT COUNT(*) FROM \"" + sheetName + "\";";
-   int errorCode = sqlite3_prepare_v2(reinterpret_cast<sqlite3*>(db), query.c_str(), query.length() + 1U, &messi, nullptr);
+   sqlite3_stmt *messi = reinterpret_cast<sqlite3_stmt*>(mgr->prepare(db, query));
 
-   if (SQLITE_OK != errorCode)
+   if (nullptr == messi)
     {
       return 0U;
     }
 
    sqlite3_bind_text(messi, 1, sheetName.c_str(), -1, nullptr);
-   if (SQLITE_ROW == sqlite3_step(messi))
+   if (SQLITE_ROW == mgr->step(messi))
     {
       rows = sqlite3_column_int64(messi, 0) + 1U; // for headers
     }
 
-   sqlite3_finalize(messi);
+   mgr->release(messi);
    return rows;
  }
 
@@ -104,7 +148,35 @@ size_t TableView::getMaxRowForColumn(size_t)
    return getMaxRow();
  }
 
-static size_t maxCacheSize = 5000U;
+static std::string quote(const std::string& name)
+ {
+   std::string result = "\"";
+   for (char c : name)
+    {
+      if ('"' == c)
+       {
+         result += '"';
+       }
+      result += c;
+    }
+   return result + "\"";
+ }
+
+   // Either the list of key columns, or the list of parameters to bind them to.
+static std::string joinKeys(const std::vector<std::string>& keys, bool parameters)
+ {
+   std::string result;
+   for (size_t i = 0U; i < keys.size(); ++i)
+    {
+      if (0U != i)
+       {
+         result += ", ";
+       }
+      result += (true == parameters) ? std::string("?") : quote(keys[i]);
+    }
+   return result;
+ }
+
 static size_t makeCellId(size_t col, size_t row)
  {
    return ((col << 44U) | row);
@@ -145,91 +217,346 @@ Forwards::Engine::Cell* TableView::getCellAt(size_t col, size_t row, const std::
    auto needle = cellCache.find(id);
    if (cellCache.end() != needle)
     {
-      lru[needle->second.get()] = ++last;
-      return needle->second.get();
+      cellAge.splice(cellAge.begin(), cellAge, needle->second.second);
+      return needle->second.first.get();
     }
 
-   sqlite3_stmt *messi;
+   findKeys();
+   if (col >= columns.size())
+    {
+      return nullptr;
+    }
 
-   std::string query1 = "SELECT * FROM \"" + sheetName + "\" LIMIT 1 OFFSET :off ;";
-   static const std::string query2 = "SELECT name FROM pragma_table_info(:sheet) LIMIT 1 OFFSET :off ;";
-   int errorCode;
-   if (0U != row)
+   Forwards::Engine::Cell* cell = nullptr;
+   if (0U == row)
     {
-      errorCode = sqlite3_prepare_v2(reinterpret_cast<sqlite3*>(db), query1.c_str(), query1.length() + 1U, &messi, nullptr);
+      cell = makeCellString(columns[col], col, row);
     }
    else
     {
-      errorCode = sqlite3_prepare_v2(reinterpret_cast<sqlite3*>(db), query2.c_str(), query2.length() + 1U, &messi, nullptr);
+      Page* page = getPage((row - 1U) / PAGE_ROWS);
+      size_t index = (row - 1U) % PAGE_ROWS;
+      if ((nullptr == page) || (index >= page->rows))
+       {
+         return nullptr;
+       }
+
+      const Page::Column& column = page->data[col];
+      switch (column.types[index])
+       {
+      case SQLITE_INTEGER:
+         cell = makeCellNumber(std::to_string(column.numbers[index]).c_str(), col, row);
+         break;
+      case SQLITE_FLOAT:
+       {
+            // Format it the way SQLite would have converted it to text.
+         double value;
+         std::memcpy(&value, &column.numbers[index], sizeof(double));
+         char buffer[32];
+         sqlite3_snprintf(sizeof(buffer), buffer, "%!.15g", value);
+         cell = makeCellNumber(buffer, col, row);
+       }
+         break;
+      case SQLITE3_TEXT:
+       {
+         size_t begin = (0U == index) ? 0U : column.ends[index - 1U];
+         cell = makeCellString(column.text.substr(begin, column.ends[index] - begin), col, row);
+       }
+         break;
+      case SQLITE_BLOB:
+      case SQLITE_NULL:
+         break;
+       }
     }
 
-   if (SQLITE_OK != errorCode)
+   if (nullptr != cell)
     {
-      return nullptr;
+      cellAge.push_front(id);
+      cellCache.emplace(id, std::make_pair(std::unique_ptr<Forwards::Engine::Cell>(cell), cellAge.begin()));
+
+      if (cellCache.size() > maxCacheSize)
+       {
+         cellCache.erase(cellAge.back());
+         cellAge.pop_back();
+       }
     }
 
-   if (0U != row)
+   return cell;
+ }
+
+TableView::Page* TableView::getPage(size_t page)
+ {
+   auto needle = pages.find(page);
+   if (pages.end() != needle)
     {
-      sqlite3_bind_int64(messi, 1, row - 1U);
+      pageAge.splice(pageAge.begin(), pageAge, needle->second.second);
+      return needle->second.first.get();
     }
-   else
+
+   std::string select = "SELECT ";
+   for (size_t i = 0U; i < columns.size(); ++i)
+    {
+      if (0U != i)
+       {
+         select += ", ";
+       }
+      select += quote(columns[i]);
+    }
+   select += " FROM " + quote(sheetName);
+
+   sqlite3_stmt *messi = nullptr;
+   switch (mode)
+    {
+   case ROWID:
     {
-      sqlite3_bind_text(messi, 1, sheetName.c_str(), -1, nullptr);
-      sqlite3_bind_int64(messi, 2, col);
+      int64_t rowid;
+      if (true == findRowid(page, rowid))
+       {
+         messi = reinterpret_cast<sqlite3_stmt*>(mgr->prepare(db, select + " WHERE rowid >= :rowid ORDER BY rowid LIMIT " + std::to_string(PAGE_ROWS) + ";"));
+         if (nullptr != messi)
+          {
+            sqlite3_bind_int64(messi, 1, rowid);
+          }
+       }
     }
-   Forwards::Engine::Cell* cell = nullptr;
-   if (SQLITE_ROW == sqlite3_step(messi))
+      break;
+   case PRIMARY_KEY:
+      if (true == findCheckpoint(page))
+       {
+         messi = reinterpret_cast<sqlite3_stmt*>(mgr->prepare(db, select + " WHERE (" + joinKeys(keys, false) + ") >= (" + joinKeys(keys, true) +
+            ") ORDER BY " + joinKeys(keys, false) + " LIMIT " + std::to_string(PAGE_ROWS) + ";"));
+         if (nullptr != messi)
+          {
+            for (size_t i = 0U; i < keys.size(); ++i)
+             {
+               sqlite3_bind_value(messi, i + 1, reinterpret_cast<sqlite3_value*>(checkpoints[page * keys.size() + i]));
+             }
+          }
+       }
+      break;
+   case UNKNOWN:
+   case OFFSET:
+      messi = reinterpret_cast<sqlite3_stmt*>(mgr->prepare(db, select + " LIMIT " + std::to_string(PAGE_ROWS) + " OFFSET :off;"));
+      if (nullptr != messi)
+       {
+         sqlite3_bind_int64(messi, 1, page * PAGE_ROWS);
+       }
+      break;
+    }
+
+   if (nullptr == messi)
+    {
+      return nullptr;
+    }
+
+   std::unique_ptr<Page> result = std::make_unique<Page>(columns.size());
+   for (Page::Column& column : result->data)
+    {
+      column.types.reserve(PAGE_ROWS);
+      column.numbers.reserve(PAGE_ROWS);
+      column.ends.reserve(PAGE_ROWS);
+    }
+   while (SQLITE_ROW == mgr->step(messi))
     {
-      if (0U != row)
+      for (size_t i = 0U; i < columns.size(); ++i)
        {
-         switch (sqlite3_column_type(messi, col))
+         Page::Column& column = result->data[i];
+         int type = sqlite3_column_type(messi, i);
+         int64_t number = 0;
+         switch (type)
           {
          case SQLITE_INTEGER:
+            number = sqlite3_column_int64(messi, i);
+            break;
          case SQLITE_FLOAT:
           {
-            const char * temp = reinterpret_cast<const char*>(sqlite3_column_text(messi, col));
-            cell = makeCellNumber(temp, col, row);
+            double value = sqlite3_column_double(messi, i);
+            std::memcpy(&number, &value, sizeof(double));
           }
             break;
          case SQLITE3_TEXT:
           {
-            std::string text = reinterpret_cast<const char*>(sqlite3_column_text(messi, col));
-            for (size_t i = 0U; i < text.length(); ++i)
+            const char* text = reinterpret_cast<const char*>(sqlite3_column_text(messi, i));
+            size_t begin = column.text.length();
+            column.text.append(text, sqlite3_column_bytes(messi, i));
+            for (size_t j = begin; j < column.text.length(); ++j)
              {
-               if ((text[i] < ' ') || (text[i] > '~')) text[i] = ' ';
+               if ((column.text[j] < ' ') || (column.text[j] > '~')) column.text[j] = ' ';
              }
-            cell = makeCellString(text, col, row);
           }
             break;
-         case SQLITE_BLOB:
-         case SQLITE_NULL:
+         default:
             break;
           }
+         column.types.push_back(static_cast<unsigned char>(type));
+         column.numbers.push_back(number);
+         column.ends.push_back(static_cast<uint32_t>(column.text.length()));
        }
-      else
+      ++result->rows;
+    }
+   mgr->release(messi);
+
+   Page* ret = result.get();
+   pageAge.push_front(page);
+   pageBytes += ret->bytes();
+   pages.emplace(page, std::make_pair(std::move(result), pageAge.begin()));
+
+      // Always keep the page we just read.
+   while ((pageBytes > pageBudget) && (pages.size() > 1U))
+    {
+      auto oldest = pages.find(pageAge.back());
+      pageBytes -= oldest->second.first->bytes();
+      pages.erase(oldest);
+      pageAge.pop_back();
+    }
+
+   return ret;
+ }
+
+void TableView::setPageBudget(size_t bytes)
+ {
+   pageBudget = bytes;
+   while ((pageBytes > pageBudget) && (false == pages.empty()))
+    {
+      auto oldest = pages.find(pageAge.back());
+      pageBytes -= oldest->second.first->bytes();
+      pages.erase(oldest);
+      pageAge.pop_back();
+    }
+ }
+
+void TableView::findKeys()
+ {
+   if (UNKNOWN != mode)
+    {
+      return;
+    }
+   mode = OFFSET;
+
+   static const std::string query = "SELECT name, pk FROM pragma_table_info(:sheet);";
+   sqlite3_stmt *messi = reinterpret_cast<sqlite3_stmt*>(mgr->prepare(db, query));
+   if (nullptr == messi)
+    {
+      return;
+    }
+
+   std::vector<std::pair<int, std::string> > primary;
+   sqlite3_bind_text(messi, 1, sheetName.c_str(), -1, nullptr);
+   while (SQLITE_ROW == mgr->step(messi))
+    {
+      std::string name = reinterpret_cast<const char*>(sqlite3_column_text(messi, 0));
+      int pk = sqlite3_column_int(messi, 1);
+      columns.push_back(name);
+      if (0 != pk)
        {
-         std::string text = reinterpret_cast<const char*>(sqlite3_column_text(messi, 0));
-         cell = makeCellString(text, col, row);
+         primary.emplace_back(pk, name);
        }
     }
+   mgr->release(messi);
 
-   sqlite3_finalize(messi);
+   std::sort(primary.begin(), primary.end());
+   for (const auto& key : primary)
+    {
+      keys.push_back(key.second);
+    }
 
-   if (nullptr != cell)
+      // If this doesn't prepare, then this is a WITHOUT ROWID table (or something stranger).
+   messi = reinterpret_cast<sqlite3_stmt*>(mgr->prepare(db, "SELECT rowid FROM " + quote(sheetName) + " LIMIT 0;"));
+   if (nullptr != messi)
+    {
+      mgr->release(messi);
+      mode = ROWID;
+    }
+   else if (false == keys.empty())
     {
-      cellCache[id] = std::unique_ptr<Forwards::Engine::Cell>(cell);
-      lru[cell] = ++last;
+      mode = PRIMARY_KEY;
+    }
+ }
 
-      if (cellCache.size() > maxCacheSize)
+bool TableView::findRowid(size_t page, int64_t& rowid)
+ {
+   while ((page >= rowids.size()) && (false == rowidsComplete))
+    {
+      sqlite3_stmt *messi = reinterpret_cast<sqlite3_stmt*>(mgr->prepare(db, "SELECT rowid FROM " + quote(sheetName) + " WHERE rowid > :last ORDER BY rowid LIMIT :count;"));
+      if (nullptr == messi)
+       {
+         rowidsComplete = true;
+         break;
+       }
+
+      sqlite3_bind_int64(messi, 1, (0U == rowidsSeen) ? std::numeric_limits<int64_t>::min() : rowidsLast);
+      sqlite3_bind_int64(messi, 2, ROWID_CHUNK);
+      size_t found = 0U;
+      while (SQLITE_ROW == mgr->step(messi))
+       {
+         rowidsLast = sqlite3_column_int64(messi, 0);
+         if (0U == (rowidsSeen % PAGE_ROWS))
+          {
+            rowids.push_back(rowidsLast);
+          }
+         ++rowidsSeen;
+         ++found;
+       }
+      mgr->release(messi);
+
+      if (found < ROWID_CHUNK)
        {
-         size_t min = std::accumulate(lru.begin(), lru.end(), std::numeric_limits<size_t>::max(), [](size_t x, auto y){ return std::min(x, y.second);});
-         auto iter = std::find_if(lru.begin(), lru.end(), [=](auto x){ return min == x.second; });
-         cellCache.erase(makeCellId(iter->first->col, iter->first->row));
-         lru.erase(iter->first);
+         rowidsComplete = true;
        }
     }
 
-   return cell;
+   if (page < rowids.size())
+    {
+      rowid = rowids[page];
+      return true;
+    }
+   return false;
+ }
+
+bool TableView::findCheckpoint(size_t checkpoint)
+ {
+   while ((checkpoint >= checkpoints.size() / keys.size()) && (false == checkpointsComplete))
+    {
+      sqlite3_stmt *messi;
+      const std::string select = "SELECT " + joinKeys(keys, false) + " FROM " + quote(sheetName);
+      if (true == checkpoints.empty())
+       {
+         messi = reinterpret_cast<sqlite3_stmt*>(mgr->prepare(db, select + " ORDER BY " + joinKeys(keys, false) + " LIMIT 1;"));
+       }
+      else
+       {
+         messi = reinterpret_cast<sqlite3_stmt*>(mgr->prepare(db, select + " WHERE (" + joinKeys(keys, false) + ") >= (" + joinKeys(keys, true) +
+            ") ORDER BY " + joinKeys(keys, false) + " LIMIT 1 OFFSET " + std::to_string(PAGE_ROWS) + ";"));
+         if (nullptr != messi)
+          {
+            for (size_t i = 0U; i < keys.size(); ++i)
+             {
+               sqlite3_bind_value(messi, i + 1, reinterpret_cast<sqlite3_value*>(checkpoints[checkpoints.size() - keys.size() + i]));
+             }
+          }
+       }
+
+      if (nullptr == messi)
+       {
+         checkpointsComplete = true;
+         break;
+       }
+
+      if (SQLITE_ROW == mgr->step(messi))
+       {
+         for (size_t i = 0U; i < keys.size(); ++i)
+          {
+            checkpoints.push_back(sqlite3_value_dup(sqlite3_column_value(messi, i)));
+          }
+       }
+      else
+       {
+         checkpointsComplete = true;
+       }
+      mgr->release(messi);
+    }
+
+   return checkpoint < checkpoints.size() / keys.size();
  }
 
 void TableView::returnCell(Forwards::Engine::Cell*)
@@ -245,6 +572,52 @@ bool TableView::isCellPresent(size_t col, size_t row)
    return (col < getMaxColumn()) && (row < getMaxRow());
  }
 
+   // Every cell in a table is present, so just walk the rectangle.
+class TableCursor final : public Forwards::Engine::CellCursor
+ {
+public:
+   size_t cols, rows;
+   bool c_major, colsAscending, rowsAscending;
+   size_t index;
+
+   TableCursor(size_t cols, size_t rows, bool c_major, bool colsAscending, bool rowsAscending) :
+      cols(cols), rows(rows), c_major(c_major), colsAscending(colsAscending), rowsAscending(rowsAscending), index(0U) { }
+
+   virtual bool next(size_t& col, size_t& row) override
+    {
+      if (index >= cols * rows)
+       {
+         return false;
+       }
+      col = c_major ? (index / rows) : (index % cols);
+      row = c_major ? (index % rows) : (index / cols);
+      ++index;
+      if (false == colsAscending) col = cols - 1U - col;
+      if (false == rowsAscending) row = rows - 1U - row;
+      return true;
+    }
+ };
+
+std::unique_ptr<Forwards::Engine::CellCursor> TableView::getPresentCells(bool c_major, bool colsAscending, bool rowsAscending)
+ {
+   return std::make_unique<TableCursor>(getMaxColumn(), getMaxRow(), c_major, colsAscending, rowsAscending);
+ }
+
+std::unique_ptr<Forwards::Engine::CellCursor> TableView::getPresentCellsIn(size_t col1, size_t row1, size_t col2, size_t row2)
+ {
+   std::unique_ptr<Forwards::Engine::VectorCursor> result = std::make_unique<Forwards::Engine::VectorCursor>();
+   size_t cols = getMaxColumn();
+   size_t rows = getMaxRow();
+   for (size_t col = col1; (col <= col2) && (col < cols); ++col)
+    {
+      for (size_t row = row1; (row <= row2) && (row < rows); ++row)
+       {
+         result->cells.emplace_back(col, row);
+       }
+    }
+   return result;
+ }
+
 void TableView::clearCellAt(size_t, size_t)
  {
  }
@@ -272,3 +645,11 @@ void TableView::dispose(Forwards::Engine::Cell*)
 void TableView::stashResult(Forwards::Engine::Cell*, size_t)
  {
  }
+
+void TableView::beginBatch()
+ {
+ }
+
+void TableView::endBatch()
+ {
+ }
@@ -33,8 +33,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define TABLEVIEW_H
 
 #include <string>
-#include <map>
+#include <vector>
+#include <list>
+#include <unordered_map>
 #include <memory>
+#include <cstdint>
 
 #include "Forwards/Engine/SpreadSheet.h"
 
@@ -46,15 +49,19 @@ namespace Engine
  }
  }
 
+class DBManager;
+
 class TableView final : public Forwards::Engine::SpreadSheetHolder
  {
 public:
-   TableView(const std::string& sheetName, void*);
+   TableView(const std::string& sheetName, void*, DBManager*);
    TableView(const TableView&) = delete;
    TableView& operator=(const TableView&) = delete;
+   ~TableView();
 
    std::string sheetName;
    void *db; // Type-pun the db handle.
+   DBManager *mgr;
 
    virtual size_t getMaxColumn() override;
    virtual size_t getMaxRow() override;
@@ -65,6 +72,8 @@ public:
 
    virtual void returnCell(Forwards::Engine::Cell* cell) override; // NOP
    virtual bool isCellPresent(size_t col, size_t row) override;
+   virtual std::unique_ptr<Forwards::Engine::CellCursor> getPresentCells(bool c_major, bool colsAscending, bool rowsAscending) override;
+   virtual std::unique_ptr<Forwards::Engine::CellCursor> getPresentCellsIn(size_t col1, size_t row1, size_t col2, size_t row2) override;
 
    virtual void clearCellAt(size_t col, size_t row) override; // NOPe
    virtual void clearColumn(size_t col) override; // NOPe
@@ -76,11 +85,51 @@ public:
 
    virtual void stashResult(Forwards::Engine::Cell* cell, size_t generation) override; // NOP
 
+   virtual void beginBatch() override; // NOP
+   virtual void endBatch() override; // NOP
+
+      // The most memory that cached pages of rows may use.
+   void setPageBudget(size_t bytes);
+
 private:
    size_t rows, cols;
-   size_t last;
-   std::map<size_t, std::unique_ptr<Forwards::Engine::Cell> > cellCache;
-   std::map<Forwards::Engine::Cell*, size_t> lru;
+
+      // How we find a row: by rowid, by primary key (WITHOUT ROWID tables), or by OFFSET if all else fails.
+   enum KeyMode
+    {
+      UNKNOWN,
+      ROWID,
+      PRIMARY_KEY,
+      OFFSET
+    };
+   KeyMode mode;
+   std::vector<std::string> columns;
+   std::vector<std::string> keys;
+
+      // Where each page starts: the rowid (ROWID) or primary key (PRIMARY_KEY, keys.size() sqlite3_values) of its first row.
+      // Built lazily, in order.
+   std::vector<int64_t> rowids;
+   size_t rowidsSeen;
+   int64_t rowidsLast;
+   bool rowidsComplete;
+   std::vector<void*> checkpoints;
+   bool checkpointsComplete;
+
+   void findKeys();
+   bool findRowid(size_t page, int64_t& rowid);
+   bool findCheckpoint(size_t page);
+
+      // Pages of rows, stored by column. Cells are only made when asked for.
+   class Page;
+   std::unordered_map<size_t, std::pair<std::unique_ptr<Page>, std::list<size_t>::iterator> > pages;
+   std::list<size_t> pageAge; // Most recently used first.
+   size_t pageBytes;
+   size_t pageBudget;
+
+   Page* getPage(size_t page);
+
+   std::unordered_map<size_t, std::pair<std::unique_ptr<Forwards::Engine::Cell>, std::list<size_t>::iterator> > cellCache;
+   std::list<size_t> cellAge; // Most recently used first.
  };
 
 #endif /* TABLEVIEW_H */
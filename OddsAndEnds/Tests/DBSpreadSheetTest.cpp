@@ -0,0 +1,190 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2023, Thomas DiModica
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "gtest/gtest.h"
+
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Backwards/Engine/Scope.h"
+#include "Backwards/Engine/Statement.h"
+
+#include "Backwards/Input/Lexer.h"
+#include "Backwards/Input/StringInput.h"
+
+#include "Backwards/Parser/Parser.h"
+#include "Backwards/Parser/SymbolTable.h"
+
+#include "Backwards/Types/FloatValue.h"
+
+#include "Forwards/Engine/CallingContext.h"
+#include "Forwards/Engine/Cell.h"
+#include "Forwards/Engine/SpreadSheet.h"
+
+#include "Forwards/Parser/ContextBuilder.h"
+#include "Forwards/Parser/StringLogger.h"
+
+#include "NumberSystem.h"
+
+#include "DBManager.h"
+#include "DBSpreadSheet.h"
+#include "SaveFile.h"
+
+   // Opens a new sheet file, removing whatever a previous run left.
+class DBSheetFixture
+ {
+public:
+   std::string fileName;
+   Forwards::Engine::CallingContext context;
+   Backwards::Engine::Scope global;
+   Forwards::Parser::StringLogger logger;
+   Forwards::Engine::SpreadSheet sheet;
+   Forwards::Engine::GetterMap map;
+   Forwards::Engine::NameMap names;
+   DBManager manager;
+   DBSpreadSheet* working;
+
+   explicit DBSheetFixture(const std::string& name) : fileName(name), working(nullptr)
+    {
+      std::filesystem::remove(fileName);
+      std::filesystem::remove(fileName + ".tmp");
+
+      context.globalScope = &global;
+      context.logger = &logger;
+      context.theSheet = &sheet;
+      context.map = &map;
+      context.names = &names;
+      manager.context = &context;
+
+      std::vector<std::pair<std::string, std::string> > libs;
+      LoadFile(fileName, manager, libs, std::vector<std::pair<std::string, std::string> >());
+      working = dynamic_cast<DBSpreadSheet*>(manager.getWorkingSpreadSheet());
+      sheet.currentSheet = working;
+    }
+
+   ~DBSheetFixture()
+    {
+      std::filesystem::remove(fileName + ".tmp");
+      std::filesystem::remove(fileName);
+    }
+
+      // Write a cell as the editor does.
+   void write(size_t col, size_t row, Forwards::Engine::CellType type, const std::string& input)
+    {
+      working->initCellAt(col, row);
+      Forwards::Engine::Cell* cell = working->getCellAt(col, row, "");
+      working->makeEvergreen(cell);
+      cell->type = type;
+      cell->currentInput = input;
+      working->commitCell(cell);
+      working->returnCell(cell);
+    }
+
+      // Start an edit, then abandon it with ESC.
+   void abandon(size_t col, size_t row)
+    {
+      Forwards::Engine::Cell* cell = working->getCellAt(col, row, "");
+      working->makeEvergreen(cell);
+      cell->type = Forwards::Engine::VALUE;
+      cell->currentInput = "never committed";
+      working->dispose(cell);
+      cell->previousValue.reset();
+      working->returnCell(cell);
+    }
+ };
+
+TEST(DBSpreadSheetTests, testAbandonedEditIsReloaded)
+ {
+   DBSheetFixture fixture ("AbandonedEdit.wts");
+   ASSERT_NE(nullptr, fixture.working);
+
+   fixture.write(0U, 0U, Forwards::Engine::LABEL, "kept");
+   fixture.abandon(0U, 0U);
+
+   Forwards::Engine::Cell* cell = fixture.working->getCellAt(0U, 0U, "");
+   ASSERT_NE(nullptr, cell);
+   EXPECT_EQ(Forwards::Engine::LABEL, cell->type);
+   EXPECT_EQ("kept", cell->currentInput);
+   fixture.working->returnCell(cell);
+ }
+
+TEST(DBSpreadSheetTests, testAbandonedEditIsReloadedWhenResident)
+ {
+   DBSheetFixture fixture ("AbandonedResidentEdit.wts");
+   ASSERT_NE(nullptr, fixture.working);
+
+   fixture.write(0U, 0U, Forwards::Engine::LABEL, "kept");
+   fixture.working->preload();
+   fixture.abandon(0U, 0U);
+
+   Forwards::Engine::Cell* cell = fixture.working->getCellAt(0U, 0U, "");
+   ASSERT_NE(nullptr, cell);
+   EXPECT_EQ(Forwards::Engine::LABEL, cell->type);
+   EXPECT_EQ("kept", cell->currentInput);
+   fixture.working->returnCell(cell);
+ }
+
+TEST(DBSpreadSheetTests, testFailedCellIsComputedOnce)
+ {
+   DBSheetFixture fixture ("FailedOnce.wts");
+   ASSERT_NE(nullptr, fixture.working);
+
+      // TICK counts how often it is called.
+   Forwards::Parser::ContextBuilder::createGlobalScope(fixture.global);
+   Backwards::Parser::GetterSetter gs;
+   Backwards::Parser::SymbolTable table (gs, fixture.global);
+   Backwards::Input::StringInput tick ("set count to 0 set TICK to function (x) is set count to count + 1 return count end");
+   Backwards::Input::Lexer lexer (tick, "TICK");
+   std::shared_ptr<Backwards::Engine::Statement> lib = Backwards::Parser::Parser::ParseFunctions(lexer, table, fixture.logger);
+   ASSERT_NE(nullptr, lib.get());
+   lib->execute(fixture.context);
+   fixture.map.insert(std::make_pair("TICK", table.getVariableGetter("TICK")));
+
+      // A0 reads B0 before B0's turn, and B0 fails. With nothing cached, B0 is read back from the file for its turn.
+   fixture.write(0U, 0U, Forwards::Engine::VALUE, "B0 * 2");
+   fixture.write(1U, 0U, Forwards::Engine::VALUE, "@TICK(1) - A1");
+   fixture.write(0U, 1U, Forwards::Engine::LABEL, "x");
+   fixture.working->setCacheBudget(0U);
+
+   fixture.sheet.recalc(fixture.context);
+
+   std::shared_ptr<Backwards::Types::FloatValue> count =
+      std::dynamic_pointer_cast<Backwards::Types::FloatValue>(fixture.global.vars[fixture.global.var["count"]]);
+   ASSERT_NE(nullptr, count.get());
+   EXPECT_EQ(*NumberSystem::getCurrentNumberSystem().fromString("1"), *count->value);
+
+   Forwards::Engine::Cell* cell = fixture.working->getCellAt(0U, 0U, "");
+   ASSERT_NE(nullptr, cell);
+   EXPECT_EQ(nullptr, cell->previousValue.get());
+   fixture.working->returnCell(cell);
+ }
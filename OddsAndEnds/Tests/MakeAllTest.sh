@@ -0,0 +1,8 @@
+#!/bin/sh -x
+
+cd ../..
+make
+
+cd OddsAndEnds/Tests
+g++ -o AllTest -g -Wall -Wextra -Wpedantic -O0 -I../../../External/googletest/include -I.. -I../../Forwards/include -I../../Backwards/include -I../../Numbers DBSpreadSheetTest.cpp ../../obj/BatchMode.o ../../obj/DBManager.o ../../obj/DBSpreadSheet.o ../../obj/GetAndSet.o ../../obj/LibraryLoader.o ../../obj/SaveFile.o ../../obj/StdLib.o ../../obj/TableView.o ../../../External/googletest/lib/libgtest.a ../../../External/googletest/lib/libgtest_main.a ../../lib/Forwards.a ../../lib/backwards.a ../../lib/NumLib.a ../../lib/libbcnum.a ../../lib/libdecmath.a ../../lib/libmpdec.a -lmpfr -lgmp -lsqlite3 -pthread
+./AllTest